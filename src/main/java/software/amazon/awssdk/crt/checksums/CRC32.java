@@ -5,6 +5,10 @@
 package software.amazon.awssdk.crt.checksums;
 
 import software.amazon.awssdk.crt.CRT;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
 import java.util.zip.Checksum;
 
 /**
@@ -91,8 +95,50 @@ public class CRC32 implements Checksum, Cloneable {
         this.update(buf);
     }
 
+    /**
+     * Updates the current checksum with the bytes remaining in the buffer. Direct buffers, including memory-mapped
+     * files, are checksummed in place without copying. On return the buffer's position equals its limit.
+     *
+     * @param buffer the buffer to update the checksum with
+     */
+    public void update(ByteBuffer buffer) {
+        if (buffer == null) {
+            throw new NullPointerException();
+        }
+        int position = buffer.position();
+        int length = buffer.remaining();
+        if (length == 0) {
+            return;
+        }
+        if (buffer.isDirect()) {
+            value = crc32Direct(buffer, value, position, length);
+        } else if (buffer.hasArray()) {
+            update(buffer.array(), buffer.arrayOffset() + position, length);
+        } else {
+            /* read-only heap buffer: no access to the backing array, so copy it out */
+            byte[] copy = new byte[length];
+            buffer.duplicate().get(copy);
+            update(copy, 0, length);
+        }
+        buffer.position(position + length);
+    }
+
+    /**
+     * Computes the CRC32 checksum of a file by memory-mapping it and checksumming the mapped pages in place.
+     *
+     * @param path the file to checksum
+     * @return the checksum of the file's contents
+     * @throws IOException if the file cannot be opened or mapped
+     */
+    public static long checksumFile(Path path) throws IOException {
+        CRC32 checksum = new CRC32();
+        MappedFileChecksum.update(path, checksum::update);
+        return checksum.getValue();
+    }
+
     /*******************************************************************************
      * native methods
      ******************************************************************************/
-    private static native int crc32(byte[] input, int previous, int offset, int length);;
+    private static native int crc32(byte[] input, int previous, int offset, int length);
+    private static native int crc32Direct(ByteBuffer input, int previous, int offset, int length);
 }
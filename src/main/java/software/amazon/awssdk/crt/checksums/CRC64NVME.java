@@ -0,0 +1,145 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+import software.amazon.awssdk.crt.CRT;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
+import java.util.zip.Checksum;
+
+/**
+ * CRT implementation of the Java Checksum interface for making CRC64NVME checksum calculations. This is the
+ * CRC-64/NVME variant S3 uses for full object checksums.
+ */
+public class CRC64NVME implements Checksum, Cloneable {
+    static {
+        new CRT();
+    };
+
+    private long value = 0;
+
+    /**
+     * Default constructor
+     */
+    public CRC64NVME() {
+    }
+
+    private CRC64NVME(long value) {
+        this.value = value;
+    }
+
+    @Override
+    public Object clone() {
+        return new CRC64NVME(value);
+    }
+
+    /**
+     * Returns the current checksum value.
+     *
+     * @return the current checksum value.
+     */
+    @Override
+    public long getValue() {
+        return value;
+    }
+
+    /**
+     * Resets the checksum to its initial value.
+     */
+    @Override
+    public void reset() {
+        value = 0;
+    }
+
+    /**
+     * Updates the current checksum with the specified array of bytes.
+     *
+     * @param b the byte array to update the checksum with
+     * @param off the starting offset within b of the data to use
+     * @param len the number of bytes to use in the update
+     */
+    @Override
+    public void update(byte[] b, int off, int len) {
+        if (b == null) {
+            throw new NullPointerException();
+        }
+        if (off < 0 || len < 0 || off > b.length - len) {
+            throw new ArrayIndexOutOfBoundsException();
+        }
+        value = crc64nvme(b, value, off, len);
+    }
+
+    /**
+     * Updates the current checksum with the specified array of bytes.
+     *
+     * @param b the byte array to update the checksum with
+     */
+    public void update(byte[] b) {
+        update(b, 0, b.length);
+    }
+
+    /**
+     * Updates the current checksum with the specified byte.
+     *
+     * @param b the byte to update the checksum with
+     */
+    @Override
+    public void update(int b) {
+        if (b < 0 || b > 0xff) {
+            throw new IllegalArgumentException();
+        }
+        byte[] buf = { (byte) (b & 0x000000ff) };
+        this.update(buf);
+    }
+
+    /**
+     * Updates the current checksum with the bytes remaining in the buffer. Direct buffers, including memory-mapped
+     * files, are checksummed in place without copying. On return the buffer's position equals its limit.
+     *
+     * @param buffer the buffer to update the checksum with
+     */
+    public void update(ByteBuffer buffer) {
+        if (buffer == null) {
+            throw new NullPointerException();
+        }
+        int position = buffer.position();
+        int length = buffer.remaining();
+        if (length == 0) {
+            return;
+        }
+        if (buffer.isDirect()) {
+            value = crc64nvmeDirect(buffer, value, position, length);
+        } else if (buffer.hasArray()) {
+            update(buffer.array(), buffer.arrayOffset() + position, length);
+        } else {
+            /* read-only heap buffer: no access to the backing array, so copy it out */
+            byte[] copy = new byte[length];
+            buffer.duplicate().get(copy);
+            update(copy, 0, length);
+        }
+        buffer.position(position + length);
+    }
+
+    /**
+     * Computes the CRC64NVME checksum of a file by memory-mapping it and checksumming the mapped pages in place.
+     *
+     * @param path the file to checksum
+     * @return the checksum of the file's contents
+     * @throws IOException if the file cannot be opened or mapped
+     */
+    public static long checksumFile(Path path) throws IOException {
+        CRC64NVME checksum = new CRC64NVME();
+        MappedFileChecksum.update(path, checksum::update);
+        return checksum.getValue();
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long crc64nvme(byte[] input, long previous, int offset, int length);
+    private static native long crc64nvmeDirect(ByteBuffer input, long previous, int offset, int length);
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+import software.amazon.awssdk.crt.CrtResource;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
+
+/**
+ * Base class for streaming message digests computed natively by the CRT. Data is fed with the
+ * <code>update</code> functions, in the same way as a Java Checksum, and <code>digest</code> returns the result
+ * and resets the instance so it can be reused.
+ *
+ * Instances hold native resources and must be closed. They are not thread safe.
+ */
+public abstract class CrtDigest extends CrtResource {
+    /* Must match enum crt_digest_algorithm in checksums.c */
+    static final int ALGORITHM_SHA1 = 0;
+    static final int ALGORITHM_SHA256 = 1;
+
+    CrtDigest(int algorithm) {
+        acquireNativeHandle(digestNew(algorithm));
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() { return true; }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            digestDestroy(getNativeHandle());
+        }
+    }
+
+    /**
+     * Updates the digest with the specified array of bytes.
+     *
+     * @param b the byte array to update the digest with
+     * @param off the starting offset within b of the data to use
+     * @param len the number of bytes to use in the update
+     */
+    public void update(byte[] b, int off, int len) {
+        if (b == null) {
+            throw new NullPointerException();
+        }
+        if (off < 0 || len < 0 || off > b.length - len) {
+            throw new ArrayIndexOutOfBoundsException();
+        }
+        digestUpdate(getNativeHandle(), b, off, len);
+    }
+
+    /**
+     * Updates the digest with the specified array of bytes.
+     *
+     * @param b the byte array to update the digest with
+     */
+    public void update(byte[] b) {
+        update(b, 0, b.length);
+    }
+
+    /**
+     * Updates the digest with the bytes remaining in the buffer. Direct buffers, including memory-mapped files,
+     * are read in place without copying. On return the buffer's position equals its limit.
+     *
+     * @param buffer the buffer to update the digest with
+     */
+    public void update(ByteBuffer buffer) {
+        if (buffer == null) {
+            throw new NullPointerException();
+        }
+        int position = buffer.position();
+        int length = buffer.remaining();
+        if (length == 0) {
+            return;
+        }
+        if (buffer.isDirect()) {
+            digestUpdateDirect(getNativeHandle(), buffer, position, length);
+        } else if (buffer.hasArray()) {
+            update(buffer.array(), buffer.arrayOffset() + position, length);
+        } else {
+            /* read-only heap buffer: no access to the backing array, so copy it out */
+            byte[] copy = new byte[length];
+            buffer.duplicate().get(copy);
+            update(copy, 0, length);
+        }
+        buffer.position(position + length);
+    }
+
+    /**
+     * Updates the digest with the contents of a file by memory-mapping it and reading the mapped pages in place.
+     *
+     * @param path the file to digest
+     * @throws IOException if the file cannot be opened or mapped
+     */
+    public void updateFromFile(Path path) throws IOException {
+        MappedFileChecksum.update(path, this::update);
+    }
+
+    /**
+     * Completes the digest of everything passed to <code>update</code> since construction or the last reset, and
+     * resets the digest.
+     *
+     * @return the digest value
+     */
+    public byte[] digest() {
+        return digestFinish(getNativeHandle());
+    }
+
+    /**
+     * Discards everything passed to <code>update</code> since construction or the last reset.
+     */
+    public void reset() {
+        digestReset(getNativeHandle());
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long digestNew(int algorithm);
+    private static native void digestDestroy(long digest);
+    private static native void digestUpdate(long digest, byte[] input, int offset, int length);
+    private static native void digestUpdateDirect(long digest, ByteBuffer input, int offset, int length);
+    private static native byte[] digestFinish(long digest);
+    private static native void digestReset(long digest);
+}
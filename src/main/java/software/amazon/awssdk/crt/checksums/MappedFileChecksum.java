@@ -0,0 +1,33 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+import java.io.IOException;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.function.Consumer;
+
+/**
+ * Feeds a file to a checksum through read-only memory mappings, so the native checksum reads the page cache
+ * directly instead of a heap copy of the file.
+ */
+class MappedFileChecksum {
+    /* Files larger than this are mapped one window at a time; a MappedByteBuffer is limited to 2GB */
+    static final long MAP_WINDOW_SIZE = 1L << 30;
+
+    private MappedFileChecksum() {}
+
+    static void update(Path path, Consumer<MappedByteBuffer> update) throws IOException {
+        try (FileChannel channel = FileChannel.open(path, StandardOpenOption.READ)) {
+            long size = channel.size();
+            for (long position = 0; position < size; position += MAP_WINDOW_SIZE) {
+                long length = Math.min(MAP_WINDOW_SIZE, size - position);
+                update.accept(channel.map(FileChannel.MapMode.READ_ONLY, position, length));
+            }
+        }
+    }
+}
@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+/**
+ * Streaming SHA1 digest computed by the CRT's native crypto library. <code>digest</code> returns the 20 byte
+ * SHA1 value.
+ */
+public class SHA1 extends CrtDigest {
+    /**
+     * Default constructor
+     */
+    public SHA1() {
+        super(ALGORITHM_SHA1);
+    }
+}
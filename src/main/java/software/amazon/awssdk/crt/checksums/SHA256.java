@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+/**
+ * Streaming SHA256 digest computed by the CRT's native crypto library. <code>digest</code> returns the 32 byte
+ * SHA256 value.
+ */
+public class SHA256 extends CrtDigest {
+    /**
+     * Default constructor
+     */
+    public SHA256() {
+        super(ALGORITHM_SHA256);
+    }
+}
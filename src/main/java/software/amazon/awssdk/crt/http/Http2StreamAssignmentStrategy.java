@@ -0,0 +1,53 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+/**
+ * How an Http2StreamManager assigns new streams to its connections.
+ *
+ * Every strategy other than DEFAULT runs one independent native stream manager per connection, up to the maximum
+ * number of connections, and picks one for each new stream. Each of those managers has its own queue of pending
+ * acquisitions: a stream assigned to a connection that fails is failed with it rather than moved to another
+ * connection, and a slow connection doesn't borrow capacity from the others.
+ */
+public enum Http2StreamAssignmentStrategy {
+
+    /**
+     * Leaves the choice to the native stream manager, which reuses a connection until it reaches the ideal
+     * concurrent streams per connection before opening another one.
+     */
+    DEFAULT(0),
+
+    /**
+     * Fills the first connection up to the ideal concurrent streams per connection before using the next one. Once
+     * every connection is at the ideal, picks the connection with the fewest active streams. Keeps the number of busy
+     * connections low.
+     */
+    FILL_FIRST(1),
+
+    /**
+     * Cycles through the connections in order, one stream each, regardless of their load.
+     */
+    ROUND_ROBIN(2),
+
+    /**
+     * Picks the connection whose streams hold the fewest bytes of unacknowledged flow-control window, then the one
+     * with the fewest active or queued streams, then the one whose active streams have received the fewest response
+     * body bytes. Unacknowledged window bytes are only tracked with manual window management; otherwise connections
+     * are ranked by stream count first. Keeps small requests off connections whose flow-control window is taken up by
+     * a large download.
+     */
+    LEAST_LOADED_BY_BYTES(3);
+
+    private int value;
+
+    Http2StreamAssignmentStrategy(int value) {
+        this.value = value;
+    }
+
+    public int getValue() {
+        return value;
+    }
+}
@@ -29,6 +29,7 @@ public class Http2StreamManager extends CrtResource {
     private final int maxConnections;
     private final int idealConcurrentStreamsPerConnection;
     private final int maxConcurrentStreamsPerConnection;
+    private final Http2StreamAssignmentStrategy streamAssignmentStrategy;
     private final CompletableFuture<Void> shutdownComplete = new CompletableFuture<>();
 
     /**
@@ -70,6 +71,7 @@ public class Http2StreamManager extends CrtResource {
         this.maxConnections = maxConnections;
         this.idealConcurrentStreamsPerConnection = idealConcurrentStreamsPerConnection;
         this.maxConcurrentStreamsPerConnection = maxConcurrentStreamsPerConnection;
+        this.streamAssignmentStrategy = options.getStreamAssignmentStrategy();
 
         int proxyConnectionType = 0;
         String proxyHost = null;
@@ -122,7 +124,9 @@ public class Http2StreamManager extends CrtResource {
                 options.hasPriorKnowledge(),
                 options.shouldCloseConnectionOnServerError(),
                 options.getConnectionPingPeriodMs(),
-                options.getConnectionPingTimeoutMs()));
+                options.getConnectionPingTimeoutMs(),
+                connectionManagerOptions.getResponseBodyMinimumDeliverySize(),
+                options.getStreamAssignmentStrategy().getValue()));
 
         /*
          * we don't need to add a reference to socketOptions since it's copied during
@@ -146,18 +150,52 @@ public class Http2StreamManager extends CrtResource {
     public CompletableFuture<Http2Stream> acquireStream(Http2Request request,
             HttpStreamBaseResponseHandler streamHandler) {
 
-        return this.acquireStream((HttpRequestBase) request, streamHandler);
+        return this.acquireStream((HttpRequestBase) request, streamHandler, false);
     }
 
     public CompletableFuture<Http2Stream> acquireStream(HttpRequest request,
             HttpStreamBaseResponseHandler streamHandler) {
 
-        return this.acquireStream((HttpRequestBase) request, streamHandler);
+        return this.acquireStream((HttpRequestBase) request, streamHandler, false);
     }
 
-    private CompletableFuture<Http2Stream> acquireStream(HttpRequestBase request,
+    /**
+     * Request a Http2Stream from StreamManager, completing the acquisition on the calling thread when possible.
+     *
+     * If the manager has a free stream slot on an already established connection, this waits briefly for the
+     * stream and the returned future is already complete when this call returns, so dependent stages run on the
+     * calling thread instead of the native event loop. Otherwise, or when called from one of the manager's event
+     * loop threads, this behaves exactly like {@link #acquireStream(Http2Request, HttpStreamBaseResponseHandler)}.
+     * When the stream is acquired inline, the stream handler may receive its first callbacks before the returned
+     * future completes.
+     *
+     * @param request       The Request to make to the Server.
+     * @param streamHandler The Stream Handler to be called from the Native
+     *                      EventLoop
+     * @return A future for a Http2Stream, already completed if the stream was acquired inline.
+     */
+    public CompletableFuture<Http2Stream> tryAcquireStream(Http2Request request,
+            HttpStreamBaseResponseHandler streamHandler) {
+
+        return this.acquireStream((HttpRequestBase) request, streamHandler, true);
+    }
+
+    /**
+     * @param request       The Request to make to the Server.
+     * @param streamHandler The Stream Handler to be called from the Native
+     *                      EventLoop
+     * @return A future for a Http2Stream, already completed if the stream was acquired inline.
+     * @see #tryAcquireStream(Http2Request, HttpStreamBaseResponseHandler)
+     */
+    public CompletableFuture<Http2Stream> tryAcquireStream(HttpRequest request,
             HttpStreamBaseResponseHandler streamHandler) {
 
+        return this.acquireStream((HttpRequestBase) request, streamHandler, true);
+    }
+
+    private CompletableFuture<Http2Stream> acquireStream(HttpRequestBase request,
+            HttpStreamBaseResponseHandler streamHandler, boolean tryInline) {
+
         CompletableFuture<Http2Stream> completionFuture = new CompletableFuture<>();
         AsyncCallback acquireStreamCompleted = AsyncCallback.wrapFuture(completionFuture, null);
         if (isNull()) {
@@ -166,11 +204,19 @@ public class Http2StreamManager extends CrtResource {
             return completionFuture;
         }
         try {
-            http2StreamManagerAcquireStream(this.getNativeHandle(),
-                    request.marshalForJni(),
-                    request.getBodyStream(),
-                    new HttpStreamResponseHandlerNativeAdapter(streamHandler),
-                    acquireStreamCompleted);
+            if (tryInline) {
+                http2StreamManagerTryAcquireStream(this.getNativeHandle(),
+                        request.marshalForJni(),
+                        request.getBodyStream(),
+                        new HttpStreamResponseHandlerNativeAdapter(streamHandler),
+                        acquireStreamCompleted);
+            } else {
+                http2StreamManagerAcquireStream(this.getNativeHandle(),
+                        request.marshalForJni(),
+                        request.getBodyStream(),
+                        new HttpStreamResponseHandlerNativeAdapter(streamHandler),
+                        acquireStreamCompleted);
+            }
         } catch (CrtRuntimeException ex) {
             completionFuture.completeExceptionally(ex);
         }
@@ -191,7 +237,25 @@ public class Http2StreamManager extends CrtResource {
         if (isNull()) {
             throw new IllegalStateException("HttpClientConnectionManager has been closed, can't fetch metrics");
         }
-        return http2StreamManagerFetchMetrics(getNativeHandle());
+        HttpManagerMetrics metrics = http2StreamManagerFetchMetrics(getNativeHandle());
+        /* DEFAULT leaves connection choice to native and tracks a single load covering every connection */
+        int connectionSlots = streamAssignmentStrategy == Http2StreamAssignmentStrategy.DEFAULT ? 1 : maxConnections;
+        long[] loads = new long[connectionSlots * HttpConnectionLoad.FIELD_COUNT];
+        int count = http2StreamManagerFetchConnectionLoads(getNativeHandle(), loads);
+        metrics.setConnectionLoads(HttpConnectionLoad.fromMarshalled(loads, count));
+        return metrics;
+    }
+
+    /**
+     * @return latency histograms aggregated over every stream acquired through this manager
+     */
+    public HttpManagerLatencyMetrics getLatencyMetrics() {
+        if (isNull()) {
+            throw new IllegalStateException("Http2StreamManager has been closed, can't fetch metrics");
+        }
+        long[] buckets = HttpManagerLatencyMetrics.newBucketArray();
+        http2StreamManagerFetchLatencyHistograms(getNativeHandle(), buckets);
+        return new HttpManagerLatencyMetrics(buckets);
     }
 
     /**
@@ -263,7 +327,9 @@ public class Http2StreamManager extends CrtResource {
             boolean priorKnowledge,
             boolean closeConnectionOnServerError,
             int connectionPingPeriodMs,
-            int connectionPingTimeoutMs) throws CrtRuntimeException;
+            int connectionPingTimeoutMs,
+            int responseBodyMinimumDeliverySize,
+            int streamAssignmentStrategy) throws CrtRuntimeException;
 
     private static native void http2StreamManagerRelease(long stream_manager) throws CrtRuntimeException;
 
@@ -273,5 +339,15 @@ public class Http2StreamManager extends CrtResource {
             HttpStreamResponseHandlerNativeAdapter responseHandler,
             AsyncCallback completedCallback) throws CrtRuntimeException;
 
+    private static native void http2StreamManagerTryAcquireStream(long stream_manager,
+            byte[] marshalledRequest,
+            HttpRequestBodyStream bodyStream,
+            HttpStreamResponseHandlerNativeAdapter responseHandler,
+            AsyncCallback completedCallback) throws CrtRuntimeException;
+
     private static native HttpManagerMetrics http2StreamManagerFetchMetrics(long stream_manager) throws CrtRuntimeException;
+
+    private static native void http2StreamManagerFetchLatencyHistograms(long stream_manager, long[] buckets) throws CrtRuntimeException;
+
+    private static native int http2StreamManagerFetchConnectionLoads(long stream_manager, long[] loads) throws CrtRuntimeException;
 }
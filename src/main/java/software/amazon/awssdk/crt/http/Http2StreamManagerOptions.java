@@ -23,6 +23,7 @@ public class Http2StreamManagerOptions {
     private boolean closeConnectionOnServerError = false;
     private int connectionPingPeriodMs = 0;
     private int connectionPingTimeoutMs = 0;
+    private Http2StreamAssignmentStrategy streamAssignmentStrategy = Http2StreamAssignmentStrategy.DEFAULT;
 
     private List<Http2ConnectionSetting> initialSettingsList = new ArrayList<Http2ConnectionSetting>();
 
@@ -240,6 +241,33 @@ public class Http2StreamManagerOptions {
         return connectionPingTimeoutMs;
     }
 
+    /**
+     * For HTTP/2 stream manager only.
+     *
+     * How new streams are assigned to connections. With any strategy other than
+     * DEFAULT, the manager keeps up to max connections separate connections and
+     * picks one for each stream itself; the per-connection load it bases the choice
+     * on is available from {@link HttpManagerMetrics#getConnectionLoads()}. Each of
+     * those connections is run by its own native stream manager with its own queue
+     * of pending acquisitions, so streams assigned to a failing connection fail
+     * with it instead of moving to another one.
+     *
+     * @param streamAssignmentStrategy The stream assignment strategy
+     * @return this
+     */
+    public Http2StreamManagerOptions withStreamAssignmentStrategy(
+            Http2StreamAssignmentStrategy streamAssignmentStrategy) {
+        this.streamAssignmentStrategy = streamAssignmentStrategy;
+        return this;
+    }
+
+    /**
+     * @return The stream assignment strategy
+     */
+    public Http2StreamAssignmentStrategy getStreamAssignmentStrategy() {
+        return streamAssignmentStrategy;
+    }
+
     /**
      * Validate the stream manager options are valid to use. Throw exceptions if
      * not.
@@ -266,5 +294,8 @@ public class Http2StreamManagerOptions {
             throw new IllegalArgumentException(
                     "Ideal Concurrent Streams Per Connection must be greater than zero and smaller than max.");
         }
+        if (streamAssignmentStrategy == null) {
+            throw new IllegalArgumentException("Stream Assignment Strategy can't be null.");
+        }
     }
 }
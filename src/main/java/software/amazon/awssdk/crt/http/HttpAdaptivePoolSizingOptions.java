@@ -0,0 +1,117 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+/**
+ * Controls adaptive sizing of an HttpClientConnectionManager's pool.
+ *
+ * The manager starts out allowing the minimum number of connections and re-evaluates the limit once per adjustment
+ * interval. It grows the limit, never past the maximum number of connections, while acquisitions queue up and wait
+ * longer than the target acquire latency. It shrinks the limit by one at a time, never below the minimum, when
+ * fewer connections were needed. When a minimum throughput is set, the limit stops growing, and shrinks once nothing
+ * is waiting, while the leased connections each move fewer bytes than that, since opening more connections won't
+ * help when the bottleneck is elsewhere.
+ *
+ * Lowering the limit does not close connections. Idle connections above the limit are closed once they reach the
+ * manager's max connection idle time, so set one for the pool to actually shrink.
+ */
+public class HttpAdaptivePoolSizingOptions {
+
+    private static final long DEFAULT_ADJUSTMENT_INTERVAL_MS = 1000;
+    private static final long MIN_ADJUSTMENT_INTERVAL_MS = 100;
+
+    /**
+     * Lower bound for the connection limit.
+     */
+    private int minConnections = 1;
+
+    /**
+     * Average acquire wait, in milliseconds, above which queued acquisitions make the limit grow.
+     */
+    private long targetAcquireLatencyMs = 0;
+
+    /**
+     * Response body throughput per connection, in bytes per second, below which the limit stops growing.
+     */
+    private long minThroughputBytesPerSecond = 0;
+
+    /**
+     * How often, in milliseconds, the limit is re-evaluated.
+     */
+    private long adjustmentIntervalMs = DEFAULT_ADJUSTMENT_INTERVAL_MS;
+
+    /**
+     * Creates a new set of adaptive pool sizing options
+     */
+    public HttpAdaptivePoolSizingOptions() {
+    }
+
+    /**
+     * Sets the lower bound for the connection limit, which is also where the limit starts. Must be at least one and
+     * no more than the connection manager's maximum number of connections.
+     * @param minConnections lower bound for the connection limit
+     */
+    public void setMinConnections(int minConnections) {
+        if (minConnections < 1) {
+            throw new IllegalArgumentException("Adaptive pool sizing min connections must be at least one");
+        }
+        this.minConnections = minConnections;
+    }
+
+    /**
+     * @return lower bound for the connection limit
+     */
+    public int getMinConnections() { return minConnections; }
+
+    /**
+     * Sets the average acquire wait above which queued acquisitions make the limit grow. With the default of 0 the
+     * limit grows whenever acquisitions queue up.
+     * @param targetAcquireLatencyMs average acquire wait, in milliseconds, the pool tries to stay under
+     */
+    public void setTargetAcquireLatencyMs(long targetAcquireLatencyMs) {
+        if (targetAcquireLatencyMs < 0) {
+            throw new IllegalArgumentException("Adaptive pool sizing target acquire latency must be non-negative");
+        }
+        this.targetAcquireLatencyMs = targetAcquireLatencyMs;
+    }
+
+    /**
+     * @return average acquire wait, in milliseconds, the pool tries to stay under
+     */
+    public long getTargetAcquireLatencyMs() { return targetAcquireLatencyMs; }
+
+    /**
+     * Sets the response body throughput per leased connection below which the limit stops growing. 0, the default,
+     * disables the check.
+     * @param minThroughputBytesPerSecond throughput per connection, in bytes per second
+     */
+    public void setMinThroughputBytesPerSecond(long minThroughputBytesPerSecond) {
+        if (minThroughputBytesPerSecond < 0) {
+            throw new IllegalArgumentException("Adaptive pool sizing minimum throughput must be non-negative");
+        }
+        this.minThroughputBytesPerSecond = minThroughputBytesPerSecond;
+    }
+
+    /**
+     * @return throughput per connection, in bytes per second, below which the limit stops growing
+     */
+    public long getMinThroughputBytesPerSecond() { return minThroughputBytesPerSecond; }
+
+    /**
+     * Sets how often the limit is re-evaluated. Must be at least 100 milliseconds. Defaults to one second.
+     * @param adjustmentIntervalMs how often, in milliseconds, the limit is re-evaluated
+     */
+    public void setAdjustmentIntervalMs(long adjustmentIntervalMs) {
+        if (adjustmentIntervalMs < MIN_ADJUSTMENT_INTERVAL_MS) {
+            throw new IllegalArgumentException("Adaptive pool sizing adjustment interval must be at least 100ms");
+        }
+        this.adjustmentIntervalMs = adjustmentIntervalMs;
+    }
+
+    /**
+     * @return how often, in milliseconds, the limit is re-evaluated
+     */
+    public long getAdjustmentIntervalMs() { return adjustmentIntervalMs; }
+}
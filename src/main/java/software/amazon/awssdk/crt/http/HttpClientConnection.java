@@ -76,6 +76,54 @@ public class HttpClientConnection extends CrtResource {
         return stream;
     }
 
+    /**
+     * Makes a batch of HttpRequests on this HTTP/1.1 connection in a single native call. Every stream is created and
+     * activated before this returns, so the requests are pipelined on the connection in array order and responses
+     * arrive in the same order. All streams share the same response handler; use the stream passed to each callback
+     * to tell them apart.
+     *
+     * @param requests The Requests to make to the Server.
+     * @param streamHandler The Stream Handler to be called from the Native EventLoop for every stream
+     * @throws CrtRuntimeException if creating or activating any stream fails. Streams that were already activated
+     *          are closed, which does not stop requests that were already sent.
+     * @return The activated HttpStreams, one per request in the same order. Each must be closed by the user when it's
+     *          done, just like the stream returned by {@link #makeRequest(HttpRequest, HttpStreamResponseHandler)}.
+     */
+    public HttpStream[] makeRequests(HttpRequest[] requests, HttpStreamResponseHandler streamHandler)
+            throws CrtRuntimeException {
+        if (isNull()) {
+            throw new IllegalStateException("HttpClientConnection has been closed, can't make requests on it.");
+        }
+        if (getVersion() == HttpVersion.HTTP_2) {
+            throw new IllegalArgumentException("HTTP/1 only method called on an HTTP/2 connection.");
+        }
+
+        byte[][] marshalledRequests = new byte[requests.length][];
+        HttpRequestBodyStream[] bodyStreams = new HttpRequestBodyStream[requests.length];
+        for (int i = 0; i < requests.length; i++) {
+            marshalledRequests[i] = requests[i].marshalForJni();
+            bodyStreams[i] = requests[i].getBodyStream();
+        }
+
+        HttpStream[] streams = new HttpStream[requests.length];
+        try {
+            httpClientConnectionMakeRequests(getNativeHandle(),
+                    marshalledRequests,
+                    bodyStreams,
+                    new HttpStreamResponseHandlerNativeAdapter(streamHandler),
+                    streams);
+        } catch (RuntimeException ex) {
+            for (HttpStream stream : streams) {
+                if (stream != null) {
+                    stream.close();
+                }
+            }
+            throw ex;
+        }
+
+        return streams;
+    }
+
     /**
      * Determines whether a resource releases its dependencies at the same time the native handle is released or if it waits.
      * Resources that wait are responsible for calling releaseReferences() manually.
@@ -156,6 +204,12 @@ public class HttpClientConnection extends CrtResource {
                                                                      HttpRequestBodyStream bodyStream,
                                                                      HttpStreamResponseHandlerNativeAdapter responseHandler) throws CrtRuntimeException;
 
+    private static native void httpClientConnectionMakeRequests(long connectionBinding,
+                                                                byte[][] marshalledRequests,
+                                                                HttpRequestBodyStream[] bodyStreams,
+                                                                HttpStreamResponseHandlerNativeAdapter responseHandler,
+                                                                HttpStreamBase[] streams) throws CrtRuntimeException;
+
     private static native void httpClientConnectionShutdown(long connectionBinding) throws CrtRuntimeException;
 
     private static native void httpClientConnectionReleaseManaged(long connectionBinding) throws CrtRuntimeException;
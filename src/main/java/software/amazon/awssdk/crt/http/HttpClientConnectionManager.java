@@ -67,6 +67,12 @@ public class HttpClientConnectionManager extends CrtResource {
             }
         }
 
+        String host = uri.getHost();
+        /* URI keeps the brackets around IPv6 literals, the native client wants the bare address */
+        if (host.startsWith("[") && host.endsWith("]")) {
+            host = host.substring(1, host.length() - 1);
+        }
+
         HttpProxyOptions proxyOptions = options.getProxyOptions();
 
         this.windowSize = windowSize;
@@ -101,13 +107,25 @@ public class HttpClientConnectionManager extends CrtResource {
             monitoringFailureIntervalInSeconds = monitoringOptions.getAllowableThroughputFailureIntervalSeconds();
         }
 
+        HttpAdaptivePoolSizingOptions adaptivePoolSizingOptions = options.getAdaptivePoolSizingOptions();
+        int adaptiveMinConnections = 0;
+        long adaptiveTargetAcquireLatencyMs = 0;
+        long adaptiveMinThroughputBytesPerSecond = 0;
+        long adaptiveAdjustmentIntervalMs = 0;
+        if (adaptivePoolSizingOptions != null) {
+            adaptiveMinConnections = adaptivePoolSizingOptions.getMinConnections();
+            adaptiveTargetAcquireLatencyMs = adaptivePoolSizingOptions.getTargetAcquireLatencyMs();
+            adaptiveMinThroughputBytesPerSecond = adaptivePoolSizingOptions.getMinThroughputBytesPerSecond();
+            adaptiveAdjustmentIntervalMs = adaptivePoolSizingOptions.getAdjustmentIntervalMs();
+        }
+
         acquireNativeHandle(httpClientConnectionManagerNew(this,
                                             clientBootstrap.getNativeHandle(),
                                             socketOptions.getNativeHandle(),
                                             useTls && tlsContext!=null ? tlsContext.getNativeHandle() : 0,
                                             useTls && tlsConnectionOptions!=null ? tlsConnectionOptions.getNativeHandle() : 0,
                                             windowSize,
-                                            uri.getHost().getBytes(UTF8),
+                                            host.getBytes(UTF8),
                                             port,
                                             maxConnections,
                                             proxyConnectionType,
@@ -121,7 +139,13 @@ public class HttpClientConnectionManager extends CrtResource {
                                             options.getMaxConnectionIdleInMilliseconds(),
                                             monitoringThroughputThresholdInBytesPerSecond,
                                             monitoringFailureIntervalInSeconds,
-                                            expectedHttpVersion.getValue()));
+                                            expectedHttpVersion.getValue(),
+                                            options.getResponseBodyMinimumDeliverySize(),
+                                            options.getMinIdleConnections(),
+                                            adaptiveMinConnections,
+                                            adaptiveTargetAcquireLatencyMs,
+                                            adaptiveMinThroughputBytesPerSecond,
+                                            adaptiveAdjustmentIntervalMs));
 
         /* we don't need to add a reference to socketOptions since it's copied during connection manager construction */
          addReferenceTo(clientBootstrap);
@@ -149,6 +173,41 @@ public class HttpClientConnectionManager extends CrtResource {
         return returnedFuture;
     }
 
+    /**
+     * Establishes connections ahead of demand so that later acquisitions don't pay for DNS, TCP and TLS on the
+     * critical path. Idle connections count towards the number wanted, and so do connections an earlier warm-up is
+     * still establishing; only the rest are opened, never more than the pool's maximum number of connections, or the
+     * current limit when adaptive pool sizing is enabled. If nothing needs to be opened, the future completes right
+     * away.
+     *
+     * Connections that were idle when the warm-up started and the ones it opens are kept warm: they serve the next
+     * acquisitions ahead of any other connection, and are never reaped by the max idle time. They stay open until
+     * used, closed by the server or this manager is closed.
+     *
+     * @param connections number of idle connections wanted
+     * @return A Future for the number of connections idle or warm once the warm-up is done, at most the number
+     * wanted.
+     */
+    public CompletableFuture<Integer> warmUp(int connections) {
+        if (isNull()) {
+            throw new IllegalStateException("HttpClientConnectionManager has been closed, can't warm up connections");
+        }
+        if (connections <= 0) {
+            throw new IllegalArgumentException("Number of connections to warm up must be greater than zero.");
+        }
+
+        CompletableFuture<Integer> warmUpFuture = new CompletableFuture<>();
+        httpClientConnectionManagerWarmUp(this.getNativeHandle(), connections, warmUpFuture);
+        return warmUpFuture;
+    }
+
+    /**
+     * Called from Native when a warm-up started by {@link #warmUp} has finished.
+     */
+    private static void onWarmUpComplete(CompletableFuture<Integer> warmUpFuture, int connectionsWarmed) {
+        warmUpFuture.complete(connectionsWarmed);
+    }
+
     /**
      * Releases this HttpClientConnection back into the Connection Pool, and allows another Request to acquire this connection.
      * @param conn Connection to release
@@ -211,6 +270,18 @@ public class HttpClientConnectionManager extends CrtResource {
         return httpConnectionManagerFetchMetrics(getNativeHandle());
     }
 
+    /**
+     * @return latency histograms aggregated over every connection acquisition and request made through this manager
+     */
+    public HttpManagerLatencyMetrics getLatencyMetrics() {
+        if (isNull()) {
+            throw new IllegalStateException("HttpClientConnectionManager has been closed, can't fetch metrics");
+        }
+        long[] buckets = HttpManagerLatencyMetrics.newBucketArray();
+        httpConnectionManagerFetchLatencyHistograms(getNativeHandle(), buckets);
+        return new HttpManagerLatencyMetrics(buckets);
+    }
+
     /**
      * @return size of the per-connection streaming read window for response handling
      */
@@ -249,12 +320,22 @@ public class HttpClientConnectionManager extends CrtResource {
                                                         long maxConnectionIdleInMilliseconds,
                                                         long monitoringThroughputThresholdInBytesPerSecond,
                                                         int monitoringFailureIntervalInSeconds,
-                                                        int expectedProtocol) throws CrtRuntimeException;
+                                                        int expectedProtocol,
+                                                        int responseBodyMinimumDeliverySize,
+                                                        int minIdleConnections,
+                                                        int adaptiveMinConnections,
+                                                        long adaptiveTargetAcquireLatencyMs,
+                                                        long adaptiveMinThroughputBytesPerSecond,
+                                                        long adaptiveAdjustmentIntervalMs) throws CrtRuntimeException;
 
     private static native void httpClientConnectionManagerRelease(long conn_manager) throws CrtRuntimeException;
 
     private static native void httpClientConnectionManagerAcquireConnection(long conn_manager, CompletableFuture<HttpClientConnection> acquireFuture) throws CrtRuntimeException;
 
+    private static native void httpClientConnectionManagerWarmUp(long conn_manager, int connections, CompletableFuture<Integer> warmUpFuture) throws CrtRuntimeException;
+
     private static native HttpManagerMetrics httpConnectionManagerFetchMetrics(long conn_manager) throws CrtRuntimeException;
 
+    private static native void httpConnectionManagerFetchLatencyHistograms(long conn_manager, long[] buckets) throws CrtRuntimeException;
+
 }
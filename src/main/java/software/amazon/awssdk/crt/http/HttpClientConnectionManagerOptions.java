@@ -32,6 +32,9 @@ public class HttpClientConnectionManagerOptions {
     private HttpMonitoringOptions monitoringOptions;
     private long maxConnectionIdleInMilliseconds = 0;
     private HttpVersion expectedHttpVersion = HttpVersion.HTTP_1_1;
+    private int responseBodyMinimumDeliverySize = 0;
+    private int minIdleConnections = 0;
+    private HttpAdaptivePoolSizingOptions adaptivePoolSizingOptions;
 
     private static final String HTTP = "http";
     private static final String HTTPS = "https";
@@ -228,6 +231,29 @@ public class HttpClientConnectionManagerOptions {
         return this;
     }
 
+    /**
+     * Aggregates response body data natively so that {@link HttpStreamResponseHandler#onResponseBody} is called once
+     * at least this many bytes have arrived, or once the stream completes, instead of once per network read or
+     * HTTP/2 DATA frame. This cuts the number of JNI upcalls for responses that arrive in many small pieces, at the
+     * cost of copying those pieces into a per-stream buffer that is reused for the life of the stream.
+     * <p>
+     * Zero, the default, delivers every piece as it arrives. Cannot be combined with manual window management,
+     * since held back data could never be acknowledged.
+     *
+     * @param responseBodyMinimumDeliverySize minimum number of body bytes per onResponseBody call, or 0 to disable
+     * @return this
+     */
+    public HttpClientConnectionManagerOptions withResponseBodyMinimumDeliverySize(int responseBodyMinimumDeliverySize) {
+        this.responseBodyMinimumDeliverySize = responseBodyMinimumDeliverySize;
+        return this;
+    }
+
+    /**
+     * @return minimum number of body bytes per onResponseBody call, 0 if aggregation is disabled
+     * @see #withResponseBodyMinimumDeliverySize
+     */
+    public int getResponseBodyMinimumDeliverySize() { return responseBodyMinimumDeliverySize; }
+
     /**
      * Set the expected protocol version of the connection to be made, default is HTTP/1.1
      *
@@ -262,6 +288,47 @@ public class HttpClientConnectionManagerOptions {
      */
     public long getMaxConnectionIdleInMilliseconds() { return maxConnectionIdleInMilliseconds; }
 
+    /**
+     * Sets the number of idle connections the pool keeps open ahead of demand. The manager establishes them right
+     * after creation and, whenever fewer are idle, opens the difference in the background as described in
+     * {@link HttpClientConnectionManager#warmUp}, as long as no acquisitions are already waiting for a connection.
+     * Never opens more than the maximum number of connections. Only used by HttpClientConnectionManager.
+     *
+     * @param minIdleConnections number of idle connections to keep ready, or 0 (the default) to create connections
+     *                           only on demand
+     * @return this
+     */
+    public HttpClientConnectionManagerOptions withMinIdleConnections(int minIdleConnections) {
+        this.minIdleConnections = minIdleConnections;
+        return this;
+    }
+
+    /**
+     * @return number of idle connections the pool keeps open ahead of demand
+     * @see #withMinIdleConnections
+     */
+    public int getMinIdleConnections() { return minIdleConnections; }
+
+    /**
+     * Lets the connection manager adjust how many connections it opens, between the minimum in the options and the
+     * maximum number of connections, based on how long acquisitions wait and the throughput of each connection.
+     * Only used by HttpClientConnectionManager.
+     *
+     * @param adaptivePoolSizingOptions Adaptive pool sizing options, or null (the default) to always allow the maximum
+     *                                  number of connections
+     * @return this
+     */
+    public HttpClientConnectionManagerOptions withAdaptivePoolSizingOptions(
+            HttpAdaptivePoolSizingOptions adaptivePoolSizingOptions) {
+        this.adaptivePoolSizingOptions = adaptivePoolSizingOptions;
+        return this;
+    }
+
+    /**
+     * @return the adaptive pool sizing options, or null if the pool size is fixed
+     */
+    public HttpAdaptivePoolSizingOptions getAdaptivePoolSizingOptions() { return adaptivePoolSizingOptions; }
+
     /**
      * Sets the monitoring options for connections in the connection pool
      * @param monitoringOptions Monitoring options for this connection manager, or null to disable monitoring
@@ -277,6 +344,34 @@ public class HttpClientConnectionManagerOptions {
      */
     public HttpMonitoringOptions getMonitoringOptions() { return monitoringOptions; }
 
+    /**
+     * Copies these options for a pool that connects to one resolved address of the host. Used by
+     * HttpLoadBalancedConnectionManager.
+     *
+     * @param addressUri URI with the address in place of the host name
+     * @param addressTlsConnectionOptions TLS options whose server name is the original host, or null for plain HTTP
+     * @return a copy of these options targeting the address
+     */
+    HttpClientConnectionManagerOptions forAddress(URI addressUri, TlsConnectionOptions addressTlsConnectionOptions) {
+        HttpClientConnectionManagerOptions copy = new HttpClientConnectionManagerOptions();
+        copy.clientBootstrap = clientBootstrap;
+        copy.socketOptions = socketOptions;
+        copy.tlsConnectionOptions = addressTlsConnectionOptions;
+        copy.windowSize = windowSize;
+        copy.bufferSize = bufferSize;
+        copy.uri = addressUri;
+        copy.port = port;
+        copy.maxConnections = maxConnections;
+        copy.manualWindowManagement = manualWindowManagement;
+        copy.monitoringOptions = monitoringOptions;
+        copy.maxConnectionIdleInMilliseconds = maxConnectionIdleInMilliseconds;
+        copy.expectedHttpVersion = expectedHttpVersion;
+        copy.responseBodyMinimumDeliverySize = responseBodyMinimumDeliverySize;
+        copy.minIdleConnections = minIdleConnections;
+        copy.adaptivePoolSizingOptions = adaptivePoolSizingOptions;
+        return copy;
+    }
+
     /**
      * Validate the connection manager options are valid to use. Throw exceptions if not.
      */
@@ -301,5 +396,24 @@ public class HttpClientConnectionManagerOptions {
         if (windowSize <= 0) { throw new  IllegalArgumentException("Window Size must be greater than zero."); }
 
         if (maxConnections <= 0) { throw new  IllegalArgumentException("Max Connections must be greater than zero."); }
+
+        if (minIdleConnections < 0) {
+            throw new IllegalArgumentException("Min idle connections must not be negative.");
+        }
+        if (minIdleConnections > maxConnections) {
+            throw new IllegalArgumentException("Min idle connections must not exceed max connections.");
+        }
+
+        if (adaptivePoolSizingOptions != null && adaptivePoolSizingOptions.getMinConnections() > maxConnections) {
+            throw new IllegalArgumentException("Adaptive pool sizing min connections must not exceed max connections.");
+        }
+
+        if (responseBodyMinimumDeliverySize < 0) {
+            throw new IllegalArgumentException("Response body minimum delivery size must not be negative.");
+        }
+        if (responseBodyMinimumDeliverySize > 0 && manualWindowManagement) {
+            throw new IllegalArgumentException(
+                "Response body minimum delivery size cannot be combined with manual window management.");
+        }
     }
 }
@@ -0,0 +1,60 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * Load on one connection of an Http2StreamManager, as seen by its stream assignment strategy.
+ */
+public class HttpConnectionLoad {
+    /* Must stay in sync with AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT in http2_stream_manager.c */
+    static final int FIELD_COUNT = 3;
+
+    private final long activeStreams;
+    private final long inFlightBytes;
+    private final long unacknowledgedWindowBytes;
+
+    HttpConnectionLoad(long activeStreams, long inFlightBytes, long unacknowledgedWindowBytes) {
+        this.activeStreams = activeStreams;
+        this.inFlightBytes = inFlightBytes;
+        this.unacknowledgedWindowBytes = unacknowledgedWindowBytes;
+    }
+
+    static List<HttpConnectionLoad> fromMarshalled(long[] loads, int count) {
+        List<HttpConnectionLoad> result = new ArrayList<HttpConnectionLoad>(count);
+        for (int i = 0; i < count; i++) {
+            int offset = i * FIELD_COUNT;
+            result.add(new HttpConnectionLoad(loads[offset], loads[offset + 1], loads[offset + 2]));
+        }
+        return Collections.unmodifiableList(result);
+    }
+
+    /**
+     * @return the number of streams assigned to the connection that have not completed yet
+     */
+    public long getActiveStreams() {
+        return activeStreams;
+    }
+
+    /**
+     * @return the response body bytes received so far by the connection's active streams
+     */
+    public long getInFlightBytes() {
+        return inFlightBytes;
+    }
+
+    /**
+     * @return the response body bytes the connection's streams received but have not yet handed back through
+     * {@link HttpStreamBase#incrementWindow} or the return value of
+     * {@link HttpStreamResponseHandler#onResponseBody}. Only tracked with manual window management, otherwise the
+     * window is reopened as data arrives and this is always 0.
+     */
+    public long getUnacknowledgedWindowBytes() {
+        return unacknowledgedWindowBytes;
+    }
+}
@@ -9,7 +9,11 @@ import java.nio.ByteBuffer;
 import java.nio.charset.Charset;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
+import java.util.HashMap;
 import java.util.List;
+import java.util.Map;
+
+import software.amazon.awssdk.crt.CrtRuntimeException;
 
 /**
  * A wrapper class for http header key-value pairs
@@ -17,8 +21,51 @@ import java.util.List;
 public class HttpHeader {
     private final static int BUFFER_INT_SIZE = 4;
     private final static Charset UTF8 = StandardCharsets.UTF_8;
+
+    /* A marshalled name length with this bit set is the index of an interned name and no name bytes follow */
+    private final static int STATIC_NAME_FLAG = 0x80000000;
+
+    /*
+     * Header names common enough to be interned: they cross the JNI boundary as a table index and share a single
+     * byte[] and String across every header. Order must stay in sync with s_static_header_names in
+     * http_request_utils.c, the index is part of the wire format between them.
+     */
+    private final static String[] STATIC_NAMES = {
+        /* HTTP/2 pseudo-headers */
+        ":authority", ":method", ":path", ":scheme", ":status",
+        /* HPACK static table names (RFC 7541, Appendix A) */
+        "accept-charset", "accept-encoding", "accept-language", "accept-ranges", "accept",
+        "access-control-allow-origin", "age", "allow", "authorization", "cache-control", "content-disposition",
+        "content-encoding", "content-language", "content-length", "content-location", "content-range",
+        "content-type", "cookie", "date", "etag", "expect", "expires", "from", "host", "if-match",
+        "if-modified-since", "if-none-match", "if-range", "if-unmodified-since", "last-modified", "link",
+        "location", "max-forwards", "proxy-authenticate", "proxy-authorization", "range", "referer", "refresh",
+        "retry-after", "server", "set-cookie", "strict-transport-security", "transfer-encoding", "user-agent",
+        "vary", "via", "www-authenticate",
+        /* Other common lowercase names */
+        "connection", "content-md5", "x-amz-date", "x-amz-content-sha256", "x-amz-security-token", "x-amz-target",
+        "x-amz-user-agent", "x-amz-request-id", "x-amz-id-2", "x-amzn-requestid", "x-amz-server-side-encryption",
+        "x-amz-decoded-content-length", "x-amz-trailer", "x-amz-checksum-crc32", "x-amz-checksum-crc32c",
+        "amz-sdk-invocation-id", "amz-sdk-request",
+        /* HTTP/1.1 Title-Case spellings */
+        "Accept", "Accept-Encoding", "Authorization", "Cache-Control", "Connection", "Content-Encoding",
+        "Content-Length", "Content-MD5", "Content-Type", "Date", "ETag", "Expect", "Host", "Last-Modified",
+        "Location", "Server", "Transfer-Encoding", "User-Agent", "X-Amz-Date", "X-Amz-Content-Sha256",
+        "X-Amz-Security-Token", "X-Amz-Target",
+    };
+    private final static byte[][] STATIC_NAME_BYTES = new byte[STATIC_NAMES.length][];
+    private final static Map<String, Integer> STATIC_NAME_INDICES = new HashMap<>(STATIC_NAMES.length * 2);
+
+    static {
+        for (int i = 0; i < STATIC_NAMES.length; ++i) {
+            STATIC_NAME_BYTES[i] = STATIC_NAMES[i].getBytes(UTF8);
+            STATIC_NAME_INDICES.put(STATIC_NAMES[i], i);
+        }
+    }
+
     private byte[] name;  /* Not final, Native will manually set name after calling empty Constructor. */
     private byte[] value; /* Not final, Native will manually set value after calling empty Constructor. */
+    private int staticNameIndex = -1;
 
     /** Called by Native to create a new HttpHeader. This is so that Native doesn't have to worry about UTF8
      * encoding/decoding issues. The user thread will deal with them when they call getName() or getValue() **/
@@ -30,7 +77,13 @@ public class HttpHeader {
      * @param value header value
      */
     public HttpHeader(String name, String value){
-        this.name = name.getBytes(UTF8);
+        Integer index = STATIC_NAME_INDICES.get(name);
+        if (index != null) {
+            this.staticNameIndex = index;
+            this.name = STATIC_NAME_BYTES[index];
+        } else {
+            this.name = name.getBytes(UTF8);
+        }
         this.value = value.getBytes(UTF8);
     }
 
@@ -44,6 +97,12 @@ public class HttpHeader {
         this.value = value;
     }
 
+    private HttpHeader(int staticNameIndex, byte[] value) {
+        this.staticNameIndex = staticNameIndex;
+        this.name = STATIC_NAME_BYTES[staticNameIndex];
+        this.value = value;
+    }
+
     /**
      *
      * @return the name of the header, converted to a UTF-8 string
@@ -52,12 +111,16 @@ public class HttpHeader {
         if (name == null) {
             return "";
         }
+        if (staticNameIndex >= 0) {
+            return STATIC_NAMES[staticNameIndex];
+        }
         return new String(name, UTF8);
     }
 
     /**
      *
-     * @return the name of the header, in raw bytes
+     * @return the name of the header, in raw bytes. Common header names share one array across headers, so the
+     * returned array must not be modified.
      */
     public byte[] getNameBytes() {
         return name;
@@ -87,8 +150,42 @@ public class HttpHeader {
         return getName() + ":" + getValue();
     }
 
+    /**
+     * @return the number of bytes this header takes up in a marshalled blob, or 0 if it is skipped
+     */
+    int getMarshalledSize() {
+        if (name.length == 0) {
+            return 0;
+        }
+        int nameSize = staticNameIndex >= 0 ? 0 : name.length;
+        return nameSize + value.length + (BUFFER_INT_SIZE * 2);
+    }
+
+    /**
+     * Writes this header as
+     * [4-bytes BE name length] [variable length name value] [4-bytes BE value length] [variable length value value]
+     * or, for an interned name,
+     * [4-bytes BE STATIC_NAME_FLAG | index] [4-bytes BE value length] [variable length value value]
+     * Headers with an empty name are skipped.
+     * @param buffer buffer with at least getMarshalledSize() bytes remaining
+     */
+    void marshalTo(ByteBuffer buffer) {
+        if (name.length == 0) {
+            return;
+        }
+        if (staticNameIndex >= 0) {
+            buffer.putInt(STATIC_NAME_FLAG | staticNameIndex);
+        } else {
+            buffer.putInt(name.length);
+            buffer.put(name);
+        }
+        buffer.putInt(value.length);
+        buffer.put(value);
+    }
+
     /** Each header is marshalled as
      * [4-bytes BE name length] [variable length name value] [4-bytes BE value length] [variable length value value]
+     * A name length with the high bit set is instead the index of an interned name, and no name bytes follow.
      * @param headersBlob Blob of encoded headers
      * @return array of decoded headers
      */
@@ -98,15 +195,26 @@ public class HttpHeader {
         while(headersBlob.hasRemaining()) {
             int nameLen = headersBlob.getInt();
 
+            if (nameLen < 0) {
+                int index = nameLen & ~STATIC_NAME_FLAG;
+                if (index >= STATIC_NAMES.length) {
+                    throw new CrtRuntimeException("Invalid marshalled header name index.");
+                }
+                byte[] valueBuf = new byte[headersBlob.getInt()];
+                headersBlob.get(valueBuf);
+                headers.add(new HttpHeader(index, valueBuf));
+                continue;
+            }
+
             // we want to protect against 0 length header names, 0 length values are fine.
             // the marshalling layer will make sure that even if a length is 0, the 0 will
             // still be stored in the byte array.
+            byte[] nameBuf = new byte[nameLen];
+            headersBlob.get(nameBuf);
+            int valLen = headersBlob.getInt();
+            byte[] valueBuf = new byte[valLen];
+            headersBlob.get(valueBuf);
             if (nameLen > 0) {
-                byte[] nameBuf = new byte[nameLen];
-                headersBlob.get(nameBuf);
-                int valLen = headersBlob.getInt();
-                byte[] valueBuf = new byte[valLen];
-                headersBlob.get(valueBuf);
                 headers.add(new HttpHeader(nameBuf, valueBuf));
             }
         }
@@ -126,21 +234,13 @@ public class HttpHeader {
      */
     public static byte[] marshalHeadersForJni(List<HttpHeader> headers) {
         int size = 0;
-
         for (HttpHeader header : headers) {
-            if (header.getNameBytes().length > 0) {
-                size += header.getNameBytes().length + header.getValueBytes().length + (BUFFER_INT_SIZE * 2);
-            }
+            size += header.getMarshalledSize();
         }
 
         ByteBuffer buffer = ByteBuffer.allocate(size);
         for (HttpHeader header : headers) {
-            if (header.getNameBytes().length > 0) {
-                buffer.putInt(header.getNameBytes().length);
-                buffer.put(header.getNameBytes());
-                buffer.putInt(header.getValueBytes().length);
-                buffer.put(header.getValueBytes());
-            }
+            header.marshalTo(buffer);
         }
 
         return buffer.array();
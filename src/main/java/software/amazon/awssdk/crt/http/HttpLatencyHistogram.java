@@ -0,0 +1,73 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.http;
+
+import java.util.Arrays;
+
+import software.amazon.awssdk.crt.utils.LatencyHistogramUtils;
+
+/**
+ * Snapshot of a latency histogram, with the bucket layout described by {@link LatencyHistogramUtils}.
+ */
+public class HttpLatencyHistogram {
+    static final int BUCKET_COUNT = LatencyHistogramUtils.BUCKET_COUNT;
+
+    private final long[] bucketCounts;
+    private final long count;
+
+    HttpLatencyHistogram(long[] bucketCounts) {
+        this.bucketCounts = bucketCounts;
+        this.count = LatencyHistogramUtils.getSampleCount(bucketCounts, 0);
+    }
+
+    /**
+     * @return The number of buckets in the histogram.
+     */
+    public int getBucketCount() {
+        return bucketCounts.length;
+    }
+
+    /**
+     * @param bucket index of the bucket
+     * @return The number of samples recorded in the bucket.
+     */
+    public long getBucketSampleCount(int bucket) {
+        return bucketCounts[bucket];
+    }
+
+    /**
+     * @param bucket index of the bucket
+     * @return The exclusive upper bound of the bucket in microseconds, or Long.MAX_VALUE for the last bucket.
+     */
+    public long getBucketUpperBoundMicros(int bucket) {
+        return LatencyHistogramUtils.getBucketUpperBoundMicros(bucket);
+    }
+
+    /**
+     * @return A copy of every bucket's sample count.
+     */
+    public long[] getBucketSampleCounts() {
+        return Arrays.copyOf(bucketCounts, bucketCounts.length);
+    }
+
+    /**
+     * @return The total number of samples recorded.
+     */
+    public long getSampleCount() {
+        return count;
+    }
+
+    /**
+     * Estimates a percentile as the upper bound of the bucket that contains it, so the result overestimates by at
+     * most a factor of two.
+     *
+     * @param percentile percentile between 0 and 100
+     * @return The upper bound in microseconds of the bucket containing the percentile, or 0 if nothing was recorded.
+     */
+    public long getPercentileUpperBoundMicros(double percentile) {
+        return LatencyHistogramUtils.getPercentileUpperBoundMicros(bucketCounts, 0, percentile);
+    }
+}
@@ -0,0 +1,578 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.locks.ReadWriteLock;
+import java.util.concurrent.locks.ReentrantReadWriteLock;
+import software.amazon.awssdk.crt.CrtResource;
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.io.TlsConnectionOptions;
+import software.amazon.awssdk.crt.io.TlsContext;
+
+/**
+ * Spreads connections for one host across all of its resolved addresses instead of the single address a plain
+ * HttpClientConnectionManager connects to. Each address gets its own HttpClientConnectionManager, and each
+ * acquisition picks an address according to the {@link HttpLoadBalancingStrategy}, weighted by how healthy the
+ * address has been.
+ *
+ * Connections must be released through {@link #releaseConnection} so the manager can track how many are
+ * outstanding per address. The host is resolved again every address refresh interval, and soon after an address
+ * becomes unhealthy: new addresses get a connection manager, and those no longer resolved stop receiving
+ * acquisitions while their outstanding connections are still released normally.
+ */
+public class HttpLoadBalancedConnectionManager extends CrtResource {
+
+    /* Weight of each new result in an address's health score */
+    private static final double HEALTH_SMOOTHING = 0.2;
+    /* Keeps an address with a health score of 0 selectable once nothing healthier is left */
+    private static final double MIN_HEALTH_WEIGHT = 0.01;
+    /* How often an avoided address is given an acquisition to find out whether it recovered */
+    private static final long UNHEALTHY_PROBE_INTERVAL_NANOS = 1_000_000_000L;
+    /* Minimum time between two address refreshes, however many addresses become unhealthy */
+    private static final long MIN_REFRESH_INTERVAL_NANOS = 1_000_000_000L;
+
+    private static final String HTTPS = "https";
+
+    private static class AddressEndpoint {
+        final String address;
+        final HttpClientConnectionManager manager;
+        final AtomicInteger outstanding = new AtomicInteger(0);
+        private double health = 1.0;
+        /* System.nanoTime() can be negative, so the first probe is only allowed relative to a real reading */
+        private long nextProbeNanos = System.nanoTime();
+
+        AddressEndpoint(String address, HttpClientConnectionManager manager) {
+            this.address = address;
+            this.manager = manager;
+        }
+
+        synchronized double getHealth() {
+            return health;
+        }
+
+        /* Returns the health score after the result */
+        synchronized double recordResult(boolean success) {
+            health = health * (1 - HEALTH_SMOOTHING) + (success ? HEALTH_SMOOTHING : 0);
+            return health;
+        }
+
+        /* Claims the next probe of an avoided address, at most one per probe interval */
+        synchronized boolean tryClaimProbe(long nowNanos) {
+            if (nowNanos - nextProbeNanos < 0) {
+                return false;
+            }
+            nextProbeNanos = nowNanos + UNHEALTHY_PROBE_INTERVAL_NANOS;
+            return true;
+        }
+
+        double cost() {
+            return (outstanding.get() + 1) / Math.max(getHealth(), MIN_HEALTH_WEIGHT);
+        }
+    }
+
+    /* Replaced as a whole when the addresses are refreshed */
+    private volatile List<AddressEndpoint> endpoints;
+    private final Map<HttpClientConnection, AddressEndpoint> leasedConnections = new ConcurrentHashMap<>();
+    private final HttpLoadBalancingStrategy strategy;
+    private final double minHealthScore;
+    private final int maxAddresses;
+    private final CompletableFuture<Void> shutdownComplete = new CompletableFuture<>();
+    private final AtomicBoolean closed = new AtomicBoolean(false);
+
+    /* Everything needed to create the connection manager of an address found by a later refresh */
+    private final HttpClientConnectionManagerOptions addressOptions;
+    private final TlsContext tlsContext;
+    /* Null when the addresses were given rather than resolved, in which case they are never refreshed */
+    private final String host;
+    private final long refreshIntervalNanos;
+    private final AtomicLong nextRefreshNanos;
+    private final AtomicBoolean refreshInFlight = new AtomicBoolean(false);
+
+    /*
+     * Held for reading while a connection is acquired from an address manager, and for writing while replacing
+     * endpoints and managerShutdownFutures or closing managers, so a manager is never used once it is closed.
+     */
+    private final ReadWriteLock endpointsLock = new ReentrantReadWriteLock();
+    /* Shutdown futures of every address manager that may not have finished shutting down */
+    private final List<CompletableFuture<Void>> managerShutdownFutures = new ArrayList<>();
+
+    /**
+     * Resolves the host in the options' URI with the client bootstrap's HostResolver and creates a connection
+     * manager for every address.
+     *
+     * For https, when the options carry a TlsContext, each address connects with the original host name as the TLS
+     * server name. When the options carry TlsConnectionOptions instead, they are shared by every address and must
+     * already have their server name set. Cannot be combined with proxy options, since the proxy resolves the host.
+     *
+     * @param options configuration options for the connection manager of every address; maxConnections applies to
+     *                each address
+     * @param loadBalancingOptions address selection options
+     * @return A Future for the manager, completed exceptionally if resolution fails or finds no addresses
+     */
+    public static CompletableFuture<HttpLoadBalancedConnectionManager> create(HttpClientConnectionManagerOptions options,
+            HttpLoadBalancingOptions loadBalancingOptions) {
+        validateOptions(options, loadBalancingOptions);
+
+        String host = options.getUri().getHost();
+        return options.getClientBootstrap().resolveHost(host).thenApply(addresses -> {
+            if (addresses.isEmpty()) {
+                throw new CrtRuntimeException("No addresses resolved for " + host);
+            }
+            return new HttpLoadBalancedConnectionManager(options, loadBalancingOptions, host, addresses);
+        });
+    }
+
+    /**
+     * Creates a connection manager for every given address of the host in the options' URI, without resolving it.
+     * The addresses are never refreshed. Otherwise behaves like
+     * {@link #create(HttpClientConnectionManagerOptions, HttpLoadBalancingOptions)}.
+     *
+     * @param options configuration options for the connection manager of every address; maxConnections applies to
+     *                each address
+     * @param loadBalancingOptions address selection options
+     * @param addresses addresses of the host to spread connections across
+     * @return the manager
+     */
+    public static HttpLoadBalancedConnectionManager createWithAddresses(HttpClientConnectionManagerOptions options,
+            HttpLoadBalancingOptions loadBalancingOptions, List<String> addresses) {
+        validateOptions(options, loadBalancingOptions);
+        if (addresses == null || addresses.isEmpty()) {
+            throw new IllegalArgumentException("Addresses must not be null or empty");
+        }
+
+        return new HttpLoadBalancedConnectionManager(options, loadBalancingOptions, null, new ArrayList<>(addresses));
+    }
+
+    private static void validateOptions(HttpClientConnectionManagerOptions options,
+            HttpLoadBalancingOptions loadBalancingOptions) {
+        options.validateOptions();
+        if (loadBalancingOptions == null) {
+            throw new IllegalArgumentException("Load balancing options must not be null");
+        }
+        if (options.getProxyOptions() != null) {
+            throw new IllegalArgumentException("Load balancing across addresses cannot be combined with a proxy.");
+        }
+    }
+
+    private HttpLoadBalancedConnectionManager(HttpClientConnectionManagerOptions options,
+            HttpLoadBalancingOptions loadBalancingOptions, String host, List<String> addresses) {
+        this.strategy = loadBalancingOptions.getStrategy();
+        this.minHealthScore = loadBalancingOptions.getMinHealthScore();
+        this.maxAddresses = loadBalancingOptions.getMaxAddresses();
+        this.host = host;
+        this.refreshIntervalNanos = loadBalancingOptions.getAddressRefreshIntervalMs() * 1_000_000L;
+        this.nextRefreshNanos = new AtomicLong(System.nanoTime() + periodicRefreshDelayNanos());
+
+        URI uri = options.getUri();
+        this.addressOptions = options.forAddress(uri, options.getTlsConnectionOptions());
+        this.tlsContext = HTTPS.equals(uri.getScheme()) ? options.getTlsContext() : null;
+
+        List<AddressEndpoint> endpoints = new ArrayList<>();
+        try {
+            for (String address : limitAddresses(addresses)) {
+                endpoints.add(createEndpoint(address));
+            }
+        } catch (RuntimeException ex) {
+            for (AddressEndpoint endpoint : endpoints) {
+                endpoint.manager.close();
+            }
+            throw ex;
+        }
+
+        this.endpoints = Collections.unmodifiableList(endpoints);
+        for (AddressEndpoint endpoint : endpoints) {
+            managerShutdownFutures.add(endpoint.manager.getShutdownCompleteFuture());
+        }
+
+        /* Later refreshes create connection managers from the same options */
+        addReferenceTo(addressOptions.getClientBootstrap());
+        addReferenceTo(addressOptions.getSocketOptions());
+        if (tlsContext != null) {
+            addReferenceTo(tlsContext);
+        }
+        if (addressOptions.getTlsConnectionOptions() != null) {
+            addReferenceTo(addressOptions.getTlsConnectionOptions());
+        }
+    }
+
+    private List<String> limitAddresses(List<String> addresses) {
+        if (maxAddresses > 0 && addresses.size() > maxAddresses) {
+            return addresses.subList(0, maxAddresses);
+        }
+        return addresses;
+    }
+
+    private AddressEndpoint createEndpoint(String address) {
+        URI uri = addressOptions.getUri();
+        URI addressUri;
+        try {
+            addressUri = new URI(uri.getScheme(), null, address, uri.getPort(), null, null, null);
+        } catch (URISyntaxException ex) {
+            throw new IllegalArgumentException("Invalid address URI", ex);
+        }
+
+        TlsConnectionOptions addressTlsOptions = addressOptions.getTlsConnectionOptions();
+        if (tlsContext != null) {
+            addressTlsOptions = new TlsConnectionOptions(tlsContext).withServerName(uri.getHost());
+        }
+
+        try {
+            return new AddressEndpoint(address,
+                HttpClientConnectionManager.create(addressOptions.forAddress(addressUri, addressTlsOptions)));
+        } finally {
+            /* The address's connection manager holds its own reference */
+            if (tlsContext != null) {
+                addressTlsOptions.close();
+            }
+        }
+    }
+
+    /**
+     * Resolves the host again and updates the addresses connections are spread across. Addresses that are still
+     * resolved keep their connection manager and health score. Does nothing for a manager created with
+     * {@link #createWithAddresses}.
+     *
+     * @return A Future for the addresses in use once the refresh has been applied
+     */
+    public CompletableFuture<List<String>> refreshAddresses() {
+        if (closed.get()) {
+            throw new IllegalStateException("HttpLoadBalancedConnectionManager has been closed, can't refresh addresses");
+        }
+        if (host == null) {
+            return CompletableFuture.completedFuture(getAddresses());
+        }
+
+        return addressOptions.getClientBootstrap().resolveHost(host).thenApply(addresses -> {
+            applyAddresses(addresses);
+            return getAddresses();
+        });
+    }
+
+    /**
+     * Updates the addresses connections are spread across to the given ones, for callers that discover addresses
+     * themselves. Addresses that are kept keep their connection manager and health score, the connection managers
+     * of the others shut down once their leased connections have been released.
+     *
+     * @param addresses addresses of the host to spread connections across
+     * @return the addresses in use once the update has been applied
+     */
+    public List<String> refreshAddresses(List<String> addresses) {
+        if (closed.get()) {
+            throw new IllegalStateException("HttpLoadBalancedConnectionManager has been closed, can't refresh addresses");
+        }
+        if (addresses == null || addresses.isEmpty()) {
+            throw new IllegalArgumentException("Addresses must not be null or empty");
+        }
+
+        applyAddresses(new ArrayList<>(addresses));
+        return getAddresses();
+    }
+
+    /* Starts a background refresh if one is due, or was requested by an address becoming unhealthy */
+    private void maybeRefreshAddresses(long nowNanos) {
+        if (host == null || nowNanos - nextRefreshNanos.get() < 0 || !refreshInFlight.compareAndSet(false, true)) {
+            return;
+        }
+
+        CompletableFuture<List<String>> refresh;
+        try {
+            refresh = refreshAddresses();
+        } catch (RuntimeException ex) {
+            refreshInFlight.set(false);
+            return;
+        }
+        refresh.whenComplete((addresses, error) -> {
+            nextRefreshNanos.set(System.nanoTime() + Math.max(periodicRefreshDelayNanos(), MIN_REFRESH_INTERVAL_NANOS));
+            refreshInFlight.set(false);
+        });
+    }
+
+    /* With periodic refreshes disabled, only an unhealthy address brings the next refresh forward */
+    private long periodicRefreshDelayNanos() {
+        return refreshIntervalNanos > 0 ? refreshIntervalNanos : Long.MAX_VALUE / 2;
+    }
+
+    /* Brings the next refresh forward once an address has dropped below the minimum health score */
+    private void requestRefresh() {
+        long earliest = System.nanoTime() + MIN_REFRESH_INTERVAL_NANOS;
+        long next = nextRefreshNanos.get();
+        while (next - earliest > 0 && !nextRefreshNanos.compareAndSet(next, earliest)) {
+            next = nextRefreshNanos.get();
+        }
+    }
+
+    private void applyAddresses(List<String> addresses) {
+        if (addresses.isEmpty()) {
+            /* Keep what we have rather than leave nothing to connect to */
+            return;
+        }
+
+        endpointsLock.writeLock().lock();
+        try {
+            if (closed.get()) {
+                return;
+            }
+
+            List<AddressEndpoint> current = endpoints;
+            List<AddressEndpoint> updated = new ArrayList<>();
+            for (String address : limitAddresses(addresses)) {
+                AddressEndpoint endpoint = findEndpoint(current, address);
+                if (endpoint == null) {
+                    try {
+                        endpoint = createEndpoint(address);
+                    } catch (RuntimeException ex) {
+                        /* Try again on the next refresh */
+                        continue;
+                    }
+                    managerShutdownFutures.add(endpoint.manager.getShutdownCompleteFuture());
+                }
+                updated.add(endpoint);
+            }
+            if (updated.isEmpty()) {
+                return;
+            }
+
+            endpoints = Collections.unmodifiableList(updated);
+            for (AddressEndpoint endpoint : current) {
+                if (!updated.contains(endpoint)) {
+                    /* Leased connections stay valid, the manager shuts down once they have all been released */
+                    endpoint.manager.close();
+                }
+            }
+            managerShutdownFutures.removeIf(CompletableFuture::isDone);
+        } finally {
+            endpointsLock.writeLock().unlock();
+        }
+    }
+
+    /**
+     * Request a HttpClientConnection from the Connection Pool of the address chosen by the load balancing strategy.
+     * @return A Future for a HttpClientConnection that will be completed when a connection is acquired.
+     */
+    public CompletableFuture<HttpClientConnection> acquireConnection() {
+        if (closed.get()) {
+            throw new IllegalStateException("HttpLoadBalancedConnectionManager has been closed, can't acquire new connections");
+        }
+
+        long nowNanos = System.nanoTime();
+        maybeRefreshAddresses(nowNanos);
+
+        AddressEndpoint endpoint;
+        CompletableFuture<HttpClientConnection> managerFuture;
+        endpointsLock.readLock().lock();
+        try {
+            if (closed.get()) {
+                throw new IllegalStateException("HttpLoadBalancedConnectionManager has been closed, can't acquire new connections");
+            }
+            endpoint = selectEndpoint(endpoints, nowNanos);
+            managerFuture = endpoint.manager.acquireConnection();
+            endpoint.outstanding.incrementAndGet();
+        } finally {
+            endpointsLock.readLock().unlock();
+        }
+
+        CompletableFuture<HttpClientConnection> acquireFuture = new CompletableFuture<>();
+        managerFuture.whenComplete((connection, error) -> {
+            if (error != null) {
+                endpoint.outstanding.decrementAndGet();
+                recordFailure(endpoint);
+                acquireFuture.completeExceptionally(error);
+                return;
+            }
+
+            endpoint.recordResult(true);
+            leasedConnections.put(connection, endpoint);
+            acquireFuture.complete(connection);
+        });
+        return acquireFuture;
+    }
+
+    /**
+     * Releases this HttpClientConnection back into the Connection Pool it was acquired from.
+     * @param conn The HttpClientConnection to release
+     */
+    public void releaseConnection(HttpClientConnection conn) {
+        releaseConnection(conn, true);
+    }
+
+    /**
+     * Releases this HttpClientConnection back into the Connection Pool it was acquired from, reporting whether the
+     * address served it well. Report false for failures that point at the address rather than the request, such as
+     * 5xx responses, throttling or timeouts, so load shifts away from it.
+     * @param conn The HttpClientConnection to release
+     * @param healthy false to lower the health score of the connection's address
+     */
+    public void releaseConnection(HttpClientConnection conn, boolean healthy) {
+        AddressEndpoint endpoint = leasedConnections.remove(conn);
+        if (endpoint == null) {
+            throw new IllegalArgumentException("Connection was not acquired from this HttpLoadBalancedConnectionManager");
+        }
+
+        if (!healthy) {
+            recordFailure(endpoint);
+        }
+        endpoint.outstanding.decrementAndGet();
+        endpoint.manager.releaseConnection(conn);
+    }
+
+    private void recordFailure(AddressEndpoint endpoint) {
+        if (endpoint.recordResult(false) < minHealthScore) {
+            /* The address may have been taken out of service, check whether the host moved */
+            requestRefresh();
+        }
+    }
+
+    private AddressEndpoint selectEndpoint(List<AddressEndpoint> endpoints, long nowNanos) {
+        int healthyCount = 0;
+        for (AddressEndpoint endpoint : endpoints) {
+            if (endpoint.getHealth() >= minHealthScore) {
+                ++healthyCount;
+            } else if (endpoint.tryClaimProbe(nowNanos)) {
+                return endpoint;
+            }
+        }
+
+        /* With nothing healthy left every address is a candidate, still weighted by health */
+        boolean allCandidates = healthyCount == 0;
+        int candidateCount = allCandidates ? endpoints.size() : healthyCount;
+
+        if (strategy == HttpLoadBalancingStrategy.POWER_OF_TWO_CHOICES && candidateCount > 2) {
+            ThreadLocalRandom random = ThreadLocalRandom.current();
+            int first = random.nextInt(candidateCount);
+            int second = random.nextInt(candidateCount - 1);
+            if (second >= first) {
+                ++second;
+            }
+            AddressEndpoint firstEndpoint = getCandidate(endpoints, first, allCandidates);
+            AddressEndpoint secondEndpoint = getCandidate(endpoints, second, allCandidates);
+            return firstEndpoint.cost() <= secondEndpoint.cost() ? firstEndpoint : secondEndpoint;
+        }
+
+        AddressEndpoint best = null;
+        double bestCost = Double.MAX_VALUE;
+        for (AddressEndpoint endpoint : endpoints) {
+            if (!allCandidates && endpoint.getHealth() < minHealthScore) {
+                continue;
+            }
+            double cost = endpoint.cost();
+            if (best == null || cost < bestCost) {
+                best = endpoint;
+                bestCost = cost;
+            }
+        }
+        return best != null ? best : endpoints.get(0);
+    }
+
+    /* Returns the index-th candidate, skipping avoided addresses unless every address is a candidate */
+    private AddressEndpoint getCandidate(List<AddressEndpoint> endpoints, int index, boolean allCandidates) {
+        if (allCandidates) {
+            return endpoints.get(index);
+        }
+
+        for (AddressEndpoint endpoint : endpoints) {
+            if (endpoint.getHealth() >= minHealthScore && index-- == 0) {
+                return endpoint;
+            }
+        }
+        /* Health changed since the candidates were counted */
+        return endpoints.get(0);
+    }
+
+    private static AddressEndpoint findEndpoint(List<AddressEndpoint> endpoints, String address) {
+        for (AddressEndpoint endpoint : endpoints) {
+            if (endpoint.address.equals(address)) {
+                return endpoint;
+            }
+        }
+        return null;
+    }
+
+    private AddressEndpoint getEndpoint(String address) {
+        AddressEndpoint endpoint = findEndpoint(endpoints, address);
+        if (endpoint == null) {
+            throw new IllegalArgumentException("Unknown address: " + address);
+        }
+        return endpoint;
+    }
+
+    /**
+     * @return the resolved addresses connections are spread across
+     */
+    public List<String> getAddresses() {
+        List<AddressEndpoint> endpoints = this.endpoints;
+        List<String> addresses = new ArrayList<>(endpoints.size());
+        for (AddressEndpoint endpoint : endpoints) {
+            addresses.add(endpoint.address);
+        }
+        return addresses;
+    }
+
+    /**
+     * @param address one of {@link #getAddresses}
+     * @return the metrics of the address's connection pool
+     */
+    public HttpManagerMetrics getManagerMetrics(String address) {
+        endpointsLock.readLock().lock();
+        try {
+            return getEndpoint(address).manager.getManagerMetrics();
+        } finally {
+            endpointsLock.readLock().unlock();
+        }
+    }
+
+    /**
+     * @param address one of {@link #getAddresses}
+     * @return the address's health score, between 0 and 1
+     */
+    public double getHealthScore(String address) {
+        return getEndpoint(address).getHealth();
+    }
+
+    /**
+     * @return a future that completes, once the manager is closed, when the connection manager of every address it
+     * used has shut down
+     */
+    public CompletableFuture<Void> getShutdownCompleteFuture() { return shutdownComplete; }
+
+    /**
+     * Closes the connection manager of every address
+     */
+    @Override
+    protected void releaseNativeHandle() {
+        CompletableFuture<?>[] shutdownFutures;
+        endpointsLock.writeLock().lock();
+        try {
+            if (!closed.compareAndSet(false, true)) {
+                return;
+            }
+            for (AddressEndpoint endpoint : endpoints) {
+                endpoint.manager.close();
+            }
+            shutdownFutures = managerShutdownFutures.toArray(new CompletableFuture<?>[0]);
+        } finally {
+            endpointsLock.writeLock().unlock();
+        }
+        CompletableFuture.allOf(shutdownFutures).whenComplete((result, error) -> shutdownComplete.complete(null));
+    }
+
+    /**
+     * Determines whether a resource releases its dependencies at the same time the native handle is released or if it waits.
+     * Resources that wait are responsible for calling releaseReferences() manually.
+     */
+    @Override
+    protected boolean canReleaseReferencesImmediately() { return true; }
+}
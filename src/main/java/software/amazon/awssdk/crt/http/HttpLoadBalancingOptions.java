@@ -0,0 +1,108 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+/**
+ * Controls how an HttpLoadBalancedConnectionManager spreads connections across the addresses of its host.
+ *
+ * Every address starts with a health score of 1. Failed connection acquisitions, and connections released as
+ * unhealthy, pull the score towards 0 and successes pull it back towards 1. Addresses scoring below the minimum
+ * health score only get an occasional probe while healthier addresses exist, and make the manager resolve the host
+ * again.
+ */
+public class HttpLoadBalancingOptions {
+
+    private HttpLoadBalancingStrategy strategy = HttpLoadBalancingStrategy.POWER_OF_TWO_CHOICES;
+
+    /**
+     * Maximum number of addresses to use, 0 for all of them.
+     */
+    private int maxAddresses = 0;
+
+    /**
+     * Health score below which an address is avoided.
+     */
+    private double minHealthScore = 0.5;
+
+    /**
+     * How often the host is resolved again, in milliseconds, 0 to only do so when an address becomes unhealthy.
+     */
+    private long addressRefreshIntervalMs = 30000;
+
+    /**
+     * Creates a new set of load balancing options
+     */
+    public HttpLoadBalancingOptions() {
+    }
+
+    /**
+     * Sets how each acquisition picks an address. Defaults to power of two choices.
+     * @param strategy address selection strategy
+     */
+    public void setStrategy(HttpLoadBalancingStrategy strategy) {
+        if (strategy == null) {
+            throw new IllegalArgumentException("Load balancing strategy must not be null");
+        }
+        this.strategy = strategy;
+    }
+
+    /**
+     * @return address selection strategy
+     */
+    public HttpLoadBalancingStrategy getStrategy() { return strategy; }
+
+    /**
+     * Sets the maximum number of resolved addresses to open connections to. Each address gets its own pool of up to
+     * the connection manager's maximum number of connections.
+     * @param maxAddresses maximum number of addresses to use, or 0 (the default) to use all of them
+     */
+    public void setMaxAddresses(int maxAddresses) {
+        if (maxAddresses < 0) {
+            throw new IllegalArgumentException("Load balancing max addresses must be non-negative");
+        }
+        this.maxAddresses = maxAddresses;
+    }
+
+    /**
+     * @return maximum number of addresses to use, 0 for all of them
+     */
+    public int getMaxAddresses() { return maxAddresses; }
+
+    /**
+     * Sets the health score, between 0 and 1, below which an address is avoided while healthier ones exist.
+     * Defaults to 0.5.
+     * @param minHealthScore health score below which an address is avoided
+     */
+    public void setMinHealthScore(double minHealthScore) {
+        if (minHealthScore < 0 || minHealthScore > 1) {
+            throw new IllegalArgumentException("Load balancing min health score must be between 0 and 1");
+        }
+        this.minHealthScore = minHealthScore;
+    }
+
+    /**
+     * @return health score below which an address is avoided
+     */
+    public double getMinHealthScore() { return minHealthScore; }
+
+    /**
+     * Sets how often the host is resolved again to pick up addresses that were added or removed. Defaults to 30
+     * seconds. The host is also resolved again, at most once a second, whenever an address becomes unhealthy.
+     * @param addressRefreshIntervalMs refresh interval in milliseconds, or 0 to only refresh when an address becomes
+     *                                 unhealthy
+     */
+    public void setAddressRefreshIntervalMs(long addressRefreshIntervalMs) {
+        if (addressRefreshIntervalMs < 0 || addressRefreshIntervalMs > Long.MAX_VALUE / 4_000_000L) {
+            throw new IllegalArgumentException("Load balancing address refresh interval is out of range");
+        }
+        this.addressRefreshIntervalMs = addressRefreshIntervalMs;
+    }
+
+    /**
+     * @return how often the host is resolved again, in milliseconds, 0 to only do so when an address becomes
+     * unhealthy
+     */
+    public long getAddressRefreshIntervalMs() { return addressRefreshIntervalMs; }
+}
@@ -0,0 +1,24 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+/**
+ * How an HttpLoadBalancedConnectionManager picks the address that serves each connection acquisition.
+ */
+public enum HttpLoadBalancingStrategy {
+
+    /**
+     * Picks the healthy address with the fewest acquired connections, weighted by health. Spreads load most evenly,
+     * at the cost of looking at every address on each acquisition.
+     */
+    LEAST_OUTSTANDING_REQUESTS,
+
+    /**
+     * Picks two healthy addresses at random and uses the one with fewer acquired connections, weighted by health.
+     * Nearly as even as least outstanding requests, and avoids every caller piling onto the same address between
+     * updates.
+     */
+    POWER_OF_TWO_CHOICES,
+}
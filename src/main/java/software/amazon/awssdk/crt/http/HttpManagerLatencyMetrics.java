@@ -0,0 +1,75 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.http;
+
+import java.util.Arrays;
+
+/**
+ * Latency histograms aggregated over every acquisition and stream of an HTTP manager since it was created. Each
+ * histogram corresponds to one of the phases reported per stream by {@link HttpStreamMetrics}.
+ */
+public class HttpManagerLatencyMetrics {
+    /* Phase order must stay in sync with enum aws_http_jni_latency_phase in http_stream_metrics.h */
+    private static final int ACQUIRE_WAIT = 0;
+    private static final int TIME_TO_FIRST_BYTE = 1;
+    private static final int BODY_TRANSFER = 2;
+    private static final int TOTAL = 3;
+    private static final int JNI_CALLBACK = 4;
+    static final int PHASE_COUNT = 5;
+
+    private final HttpLatencyHistogram[] histograms = new HttpLatencyHistogram[PHASE_COUNT];
+
+    /**
+     * @param buckets phase-major bucket counts, PHASE_COUNT * HttpLatencyHistogram.BUCKET_COUNT entries
+     */
+    HttpManagerLatencyMetrics(long[] buckets) {
+        int bucketCount = HttpLatencyHistogram.BUCKET_COUNT;
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            histograms[phase] = new HttpLatencyHistogram(
+                Arrays.copyOfRange(buckets, phase * bucketCount, (phase + 1) * bucketCount));
+        }
+    }
+
+    static long[] newBucketArray() {
+        return new long[PHASE_COUNT * HttpLatencyHistogram.BUCKET_COUNT];
+    }
+
+    /**
+     * @return Time spent waiting for a connection (connection manager) or stream (stream manager), one sample per
+     * successful acquisition.
+     */
+    public HttpLatencyHistogram getAcquireWait() {
+        return histograms[ACQUIRE_WAIT];
+    }
+
+    /**
+     * @return Time from stream activation to the first response header.
+     */
+    public HttpLatencyHistogram getTimeToFirstByte() {
+        return histograms[TIME_TO_FIRST_BYTE];
+    }
+
+    /**
+     * @return Time from the first response body bytes to stream completion.
+     */
+    public HttpLatencyHistogram getBodyTransfer() {
+        return histograms[BODY_TRANSFER];
+    }
+
+    /**
+     * @return Time from stream activation to stream completion.
+     */
+    public HttpLatencyHistogram getTotal() {
+        return histograms[TOTAL];
+    }
+
+    /**
+     * @return Total time each stream spent in Java response handler callbacks.
+     */
+    public HttpLatencyHistogram getJniCallback() {
+        return histograms[JNI_CALLBACK];
+    }
+}
@@ -1,14 +1,23 @@
 package software.amazon.awssdk.crt.http;
 
+import java.util.Collections;
+import java.util.List;
+
 public class HttpManagerMetrics {
     private final long availableConcurrency;
     private final long pendingConcurrencyAcquires;
     private final long leasedConcurrency;
+    private final long warmConnections;
+    private final long connectionLimit;
+    private List<HttpConnectionLoad> connectionLoads = Collections.emptyList();
 
-    HttpManagerMetrics(long availableConcurrency, long pendingConcurrencyAcquires, long leasedConcurrency) {
+    HttpManagerMetrics(long availableConcurrency, long pendingConcurrencyAcquires, long leasedConcurrency,
+            long warmConnections, long connectionLimit) {
         this.availableConcurrency = availableConcurrency;
         this.pendingConcurrencyAcquires = pendingConcurrencyAcquires;
         this.leasedConcurrency = leasedConcurrency;
+        this.warmConnections = warmConnections;
+        this.connectionLimit = connectionLimit;
     }
 
     /**
@@ -37,4 +46,35 @@ public class HttpManagerMetrics {
     public long getLeasedConcurrency() {
         return this.leasedConcurrency;
     }
+
+    /**
+     * @return the number of idle connections kept warm by {@link HttpClientConnectionManager#warmUp} or to maintain
+     * the minimum idle connections, which serve the next acquisitions. They are included in the available
+     * concurrency. Always 0 for stream manager.
+     */
+    public long getWarmConnections() {
+        return warmConnections;
+    }
+
+    /**
+     * @return the number of connections the connection manager currently allows at once. This is the maximum number
+     * of connections unless {@link HttpAdaptivePoolSizingOptions adaptive pool sizing} is enabled, in which case it
+     * moves between the configured bounds. Always 0 for stream manager.
+     */
+    public long getConnectionLimit() {
+        return connectionLimit;
+    }
+
+    /**
+     * @return the load on each connection of a stream manager, in the order its stream assignment strategy considers
+     * them. Holds a single entry covering every connection with {@link Http2StreamAssignmentStrategy#DEFAULT}.
+     * Always empty for connection manager.
+     */
+    public List<HttpConnectionLoad> getConnectionLoads() {
+        return connectionLoads;
+    }
+
+    void setConnectionLoads(List<HttpConnectionLoad> connectionLoads) {
+        this.connectionLoads = connectionLoads;
+    }
 }
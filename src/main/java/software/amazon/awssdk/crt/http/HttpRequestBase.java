@@ -43,7 +43,8 @@ public class HttpRequestBase {
      *         by the previous field]
      *
      *         Each request is then: [version][method][path][header name-value
-     *         pairs]
+     *         pairs], with common header names interned as described in
+     *         HttpHeader.loadHeadersListFromMarshalledHeadersBlob
      * @return encoded blob of headers
      */
     public byte[] marshalForJni() {
@@ -54,9 +55,7 @@ public class HttpRequestBase {
         size += BUFFER_INT_SIZE + pathBytes.length;
 
         for (HttpHeader header : headers) {
-            if (header.getNameBytes().length > 0) {
-                size += header.getNameBytes().length + header.getValueBytes().length + (BUFFER_INT_SIZE * 2);
-            }
+            size += header.getMarshalledSize();
         }
 
         ByteBuffer buffer = ByteBuffer.allocate(size);
@@ -67,12 +66,7 @@ public class HttpRequestBase {
         buffer.put(pathBytes);
 
         for (HttpHeader header : headers) {
-            if (header.getNameBytes().length > 0) {
-                buffer.putInt(header.getNameBytes().length);
-                buffer.put(header.getNameBytes());
-                buffer.putInt(header.getValueBytes().length);
-                buffer.put(header.getValueBytes());
-            }
+            header.marshalTo(buffer);
         }
 
         return buffer.array();
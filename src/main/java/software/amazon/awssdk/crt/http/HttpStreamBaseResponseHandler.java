@@ -87,4 +87,15 @@ public interface HttpStreamBaseResponseHandler {
      */
     void onResponseComplete(HttpStreamBase stream, int errorCode);
 
+    /**
+     * Called from Native right after onResponseComplete with the timing breakdown of the stream.
+     * Only called for handlers that override this method.
+     *
+     * @param stream  completed HttpStreamBase
+     * @param metrics timing breakdown of the stream
+     */
+    default void onMetrics(HttpStreamBase stream, HttpStreamMetrics metrics) {
+        /* Optional Callback, do nothing by default */
+    }
+
 }
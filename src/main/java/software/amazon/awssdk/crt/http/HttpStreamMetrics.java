@@ -0,0 +1,78 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.http;
+
+/**
+ * Timing breakdown of a single HTTP stream, delivered once the stream completes. All durations are in nanoseconds
+ * and are -1 when the stream never reached the corresponding phase (for example a stream that failed before any
+ * response bytes arrived has no time to first byte).
+ * <p>
+ * The native HTTP client does not report DNS resolution, TCP connect and TLS negotiation separately. When the
+ * manager had to open a new connection to serve a request, all of that time is part of the acquire wait.
+ */
+public class HttpStreamMetrics {
+    private final long acquireWaitNanos;
+    private final long timeToFirstByteNanos;
+    private final long bodyTransferNanos;
+    private final long totalNanos;
+    private final long jniCallbackNanos;
+    private final long bodyBytesReceived;
+
+    HttpStreamMetrics(long acquireWaitNanos, long timeToFirstByteNanos, long bodyTransferNanos, long totalNanos,
+            long jniCallbackNanos, long bodyBytesReceived) {
+        this.acquireWaitNanos = acquireWaitNanos;
+        this.timeToFirstByteNanos = timeToFirstByteNanos;
+        this.bodyTransferNanos = bodyTransferNanos;
+        this.totalNanos = totalNanos;
+        this.jniCallbackNanos = jniCallbackNanos;
+        this.bodyBytesReceived = bodyBytesReceived;
+    }
+
+    /**
+     * @return Time between asking the manager for a connection or stream and getting it, including any connection
+     * establishment. For the connection manager this is reported on the first request made on the acquired
+     * connection and is -1 for later requests on the same connection.
+     */
+    public long getAcquireWaitNanos() {
+        return acquireWaitNanos;
+    }
+
+    /**
+     * @return Time between the stream being activated and the first response header arriving.
+     */
+    public long getTimeToFirstByteNanos() {
+        return timeToFirstByteNanos;
+    }
+
+    /**
+     * @return Time between the first response body bytes arriving and the stream completing.
+     */
+    public long getBodyTransferNanos() {
+        return bodyTransferNanos;
+    }
+
+    /**
+     * @return Time between the stream being activated and the stream completing.
+     */
+    public long getTotalNanos() {
+        return totalNanos;
+    }
+
+    /**
+     * @return Total time spent in the Java response handler callbacks for this stream, including
+     * onResponseComplete.
+     */
+    public long getJniCallbackNanos() {
+        return jniCallbackNanos;
+    }
+
+    /**
+     * @return Number of response body bytes received.
+     */
+    public long getBodyBytesReceived() {
+        return bodyBytesReceived;
+    }
+}
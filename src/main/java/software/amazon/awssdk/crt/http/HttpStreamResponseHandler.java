@@ -65,4 +65,14 @@ public interface HttpStreamResponseHandler {
      */
     void onResponseComplete(HttpStream stream, int errorCode);
 
+    /**
+     * Called from Native right after onResponseComplete with the timing breakdown of the stream.
+     * Only called for handlers that override this method.
+     * @param stream completed stream
+     * @param metrics timing breakdown of the stream
+     */
+    default void onMetrics(HttpStream stream, HttpStreamMetrics metrics) {
+        /* Optional Callback, do nothing by default */
+    }
+
 }
@@ -6,22 +6,56 @@
 package software.amazon.awssdk.crt.http;
 
 import java.nio.ByteBuffer;
+import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * Response handler implementation used by the native http layer
  */
 class HttpStreamResponseHandlerNativeAdapter {
+    /*
+     * Whether each handler class overrides onMetrics, so the reflection runs once per class rather than per stream.
+     * One map per handler interface, since a class may implement both. ClassValue would fit, but it isn't available
+     * on Android before API 34.
+     */
+    private static final ConcurrentHashMap<Class<?>, Boolean> handlerOverridesOnMetrics = new ConcurrentHashMap<>();
+    private static final ConcurrentHashMap<Class<?>, Boolean> baseHandlerOverridesOnMetrics =
+        new ConcurrentHashMap<>();
+
     private HttpStreamResponseHandler responseHandler;
     private HttpStreamBaseResponseHandler responseBaseHandler;
+    /* Read by native when the stream is created, onMetrics is only called when this is set */
+    private final boolean deliverMetrics;
 
     HttpStreamResponseHandlerNativeAdapter(HttpStreamResponseHandler responseHandler) {
         this.responseHandler = responseHandler;
         this.responseBaseHandler = null;
+        this.deliverMetrics = overridesOnMetrics(handlerOverridesOnMetrics, responseHandler,
+            HttpStreamResponseHandler.class, HttpStream.class);
     }
 
     HttpStreamResponseHandlerNativeAdapter(HttpStreamBaseResponseHandler responseBaseHandler) {
         this.responseBaseHandler = responseBaseHandler;
         this.responseHandler = null;
+        this.deliverMetrics = overridesOnMetrics(baseHandlerOverridesOnMetrics, responseBaseHandler,
+            HttpStreamBaseResponseHandler.class, HttpStreamBase.class);
+    }
+
+    /* The default onMetrics does nothing, so skip building HttpStreamMetrics for handlers that don't override it */
+    private static boolean overridesOnMetrics(ConcurrentHashMap<Class<?>, Boolean> cache, Object handler,
+            Class<?> handlerInterface, Class<?> streamClass) {
+        Class<?> handlerClass = handler.getClass();
+        /* A plain get first, since computeIfAbsent may lock even when the class is already cached */
+        Boolean overrides = cache.get(handlerClass);
+        if (overrides == null) {
+            try {
+                overrides = handlerClass.getMethod("onMetrics", streamClass, HttpStreamMetrics.class)
+                    .getDeclaringClass() != handlerInterface;
+            } catch (NoSuchMethodException e) {
+                overrides = false;
+            }
+            cache.putIfAbsent(handlerClass, overrides);
+        }
+        return overrides;
     }
 
     void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType, ByteBuffer headersBlob) {
@@ -58,4 +92,15 @@ class HttpStreamResponseHandlerNativeAdapter {
             responseHandler.onResponseComplete((HttpStream) stream, errorCode);
         }
     }
+
+    void onMetrics(HttpStreamBase stream, long acquireWaitNanos, long timeToFirstByteNanos, long bodyTransferNanos,
+            long totalNanos, long jniCallbackNanos, long bodyBytesReceived) {
+        HttpStreamMetrics metrics = new HttpStreamMetrics(acquireWaitNanos, timeToFirstByteNanos, bodyTransferNanos,
+            totalNanos, jniCallbackNanos, bodyBytesReceived);
+        if (this.responseBaseHandler != null) {
+            responseBaseHandler.onMetrics(stream, metrics);
+        } else {
+            responseHandler.onMetrics((HttpStream) stream, metrics);
+        }
+    }
 }
@@ -4,6 +4,9 @@
  */
 package software.amazon.awssdk.crt.io;
 
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import java.util.List;
 import java.util.concurrent.CompletableFuture;
 import software.amazon.awssdk.crt.CrtResource;
 import software.amazon.awssdk.crt.CrtRuntimeException;
@@ -83,6 +86,39 @@ public final class ClientBootstrap extends CrtResource {
 
     public CompletableFuture<Void> getShutdownCompleteFuture() { return shutdownComplete; }
 
+    /**
+     * Resolves a host name with this bootstrap's HostResolver and returns every address currently cached for it,
+     * IPv6 and IPv4, rather than the single address per family a connection attempt would use.
+     *
+     * @param hostName host name to resolve
+     * @return A Future for the resolved addresses, completed exceptionally with a CrtRuntimeException if resolution
+     * fails
+     */
+    public CompletableFuture<List<String>> resolveHost(String hostName) {
+        if (isNull()) {
+            throw new IllegalStateException("ClientBootstrap has been closed, can't resolve hosts");
+        }
+        if (hostName == null) {
+            throw new IllegalArgumentException("Host name must not be null");
+        }
+
+        CompletableFuture<List<String>> resolveFuture = new CompletableFuture<>();
+        clientBootstrapResolveHost(getNativeHandle(), hostName.getBytes(StandardCharsets.UTF_8), resolveFuture);
+        return resolveFuture;
+    }
+
+    /**
+     * Called from Native when a resolution started by {@link #resolveHost} has finished.
+     */
+    private static void onHostResolved(CompletableFuture<List<String>> resolveFuture, String[] addresses,
+            int errorCode) {
+        if (errorCode != 0) {
+            resolveFuture.completeExceptionally(new CrtRuntimeException(errorCode));
+        } else {
+            resolveFuture.complete(Arrays.asList(addresses));
+        }
+    }
+
     /**
      * Closes the static ClientBootstrap, if it exists.  Primarily intended for tests that use the static
      * default ClientBootstrap, before they call waitForNoResources().
@@ -125,4 +161,6 @@ public final class ClientBootstrap extends CrtResource {
      ******************************************************************************/
     private static native long clientBootstrapNew(ClientBootstrap bootstrap, long elg, long hr) throws CrtRuntimeException;
     private static native void clientBootstrapDestroy(long bootstrap);
+    private static native void clientBootstrapResolveHost(long bootstrap, byte[] hostName,
+            CompletableFuture<List<String>> resolveFuture) throws CrtRuntimeException;
 };
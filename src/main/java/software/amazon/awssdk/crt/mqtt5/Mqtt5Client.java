@@ -4,6 +4,7 @@
  */
 package software.amazon.awssdk.crt.mqtt5;
 
+import java.nio.ByteBuffer;
 import java.util.concurrent.CompletableFuture;
 import java.util.function.Consumer;
 
@@ -14,6 +15,7 @@ import software.amazon.awssdk.crt.http.HttpRequest;
 import software.amazon.awssdk.crt.io.ClientBootstrap;
 import software.amazon.awssdk.crt.io.SocketOptions;
 import software.amazon.awssdk.crt.io.TlsContext;
+import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.PublishEvents;
 import software.amazon.awssdk.crt.mqtt5.packets.ConnectPacket;
 import software.amazon.awssdk.crt.mqtt5.packets.DisconnectPacket;
 import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
@@ -46,6 +48,11 @@ public class Mqtt5Client extends CrtResource {
      */
     private boolean isConnected;
 
+    /**
+     * The spool QoS 1 publishes are kept in until acknowledged, null unless configured in the client options
+     */
+    private PublishSpool publishSpool;
+
     /**
      * Creates a Mqtt5Client instance using the provided Mqtt5ClientOptions. Once the Mqtt5Client is created,
      * changing the settings will not cause a change in already created Mqtt5Client's.
@@ -70,12 +77,23 @@ public class Mqtt5Client extends CrtResource {
             connectionOptions = connectBuilder.build();
         }
 
-        acquireNativeHandle(mqtt5ClientNew(
-            options,
-            connectionOptions,
-            bootstrap,
-            this
-        ));
+        if (options.getPublishSpoolOptions() != null) {
+            publishSpool = new PublishSpool(options.getPublishSpoolOptions());
+        }
+
+        try {
+            acquireNativeHandle(mqtt5ClientNew(
+                options,
+                connectionOptions,
+                bootstrap,
+                this
+            ));
+        } catch (RuntimeException ex) {
+            if (publishSpool != null) {
+                publishSpool.close();
+            }
+            throw ex;
+        }
 
         if (bootstrap != null) {
             addReferenceTo(bootstrap);
@@ -99,6 +117,9 @@ public class Mqtt5Client extends CrtResource {
      */
     @Override
     protected void releaseNativeHandle() {
+        if (publishSpool != null) {
+            publishSpool.close();
+        }
         if (!isNull()) {
             mqtt5ClientDestroy(getNativeHandle());
         }
@@ -145,15 +166,115 @@ public class Mqtt5Client extends CrtResource {
      * will not contain data. For QoS 1, the PublishPacket will contain a PubAckPacket.
      * See PublishPacket class documentation for more info.
      *
+     * If the client has a publish spool (see {@link PublishSpoolOptions}), a QoS 1 publish is written to the spool
+     * and the future only completes once the server acknowledges it, which may be after any number of reconnects.
+     * It fails if the spool is full or the publish is dropped to make room for newer ones.
+     *
      * @param publishPacket PUBLISH packet to send to the server
      * @return A future that will be rejected with an error or resolved with a PublishResult response
      */
     public CompletableFuture<PublishResult> publish(PublishPacket publishPacket) {
+        if (publishSpool != null && publishPacket != null && publishPacket.getQOS() == QOS.AT_LEAST_ONCE) {
+            return publishSpool.publish(this, publishPacket);
+        }
         CompletableFuture<PublishResult> publishFuture = new CompletableFuture<>();
         mqtt5ClientInternalPublish(getNativeHandle(), publishPacket, publishFuture);
         return publishFuture;
     }
 
+    /**
+     * Tells the Mqtt5Client to attempt to send a PUBLISH packet that was already serialized with
+     * {@link PublishPacketSerializer}. The native client reads the publish straight out of the buffer rather than
+     * from a PublishPacket, which avoids a JNI call per packet field on every publish.
+     *
+     * The publish is taken from the buffer's remaining bytes. The buffer's position is left unchanged, and the
+     * buffer can be reused or modified as soon as this returns.
+     *
+     * The publish bypasses the client's publish spool, if it has one, even at QoS 1.
+     *
+     * @param serializedPublish direct buffer holding a publish written by {@link PublishPacketSerializer}
+     * @return A future that will be rejected with an error or resolved with a PublishResult response
+     * @throws IllegalArgumentException if the buffer is null or not direct
+     */
+    public CompletableFuture<PublishResult> publishSerialized(ByteBuffer serializedPublish) {
+        if (serializedPublish == null || !serializedPublish.isDirect()) {
+            throw new IllegalArgumentException("Serialized publish must be in a direct ByteBuffer");
+        }
+        CompletableFuture<PublishResult> publishFuture = new CompletableFuture<>();
+        mqtt5ClientInternalPublishSerialized(getNativeHandle(), serializedPublish, serializedPublish.position(),
+                serializedPublish.remaining(), publishFuture);
+        return publishFuture;
+    }
+
+    /**
+     * Tells the Mqtt5Client to attempt to send a batch of PUBLISH packets, handing all of them to the native
+     * client in a single call.
+     *
+     * The returned future completes once every publish in the batch has completed, with one result per publish.
+     * A publish that fails, including one the client rejects up front, is reported in the result rather than
+     * failing the future.
+     *
+     * The publishes bypass the client's publish spool, if it has one, even at QoS 1.
+     *
+     * @param publishPackets PUBLISH packets to send to the server, in order
+     * @return A future that will be resolved with a PublishBatchResult once every publish has completed
+     * @throws IllegalArgumentException if the array or any packet in it is null
+     */
+    public CompletableFuture<PublishBatchResult> publishBatch(PublishPacket[] publishPackets) {
+        if (publishPackets == null) {
+            throw new IllegalArgumentException("Publish packets can't be null");
+        }
+        for (PublishPacket publishPacket : publishPackets) {
+            if (publishPacket == null) {
+                throw new IllegalArgumentException("Publish batch can't contain a null packet");
+            }
+        }
+        CompletableFuture<PublishBatchResult> batchFuture = new CompletableFuture<>();
+        mqtt5ClientInternalPublishBatch(getNativeHandle(), publishPackets, batchFuture);
+        return batchFuture;
+    }
+
+    /**
+     * Routes received publishes whose topic matches a topic filter to a handler. Matching is done natively against
+     * every registered filter, including the + and # wildcards, before anything is built for Java.
+     *
+     * A publish that matches at least one topic handler is delivered only to the matching handlers, immediately
+     * and one publish at a time even when publish batching is enabled. A publish that matches none goes to the
+     * client's PublishEvents, or is dropped without reaching Java if the client has none.
+     *
+     * This only routes publishes that the client receives; it does not subscribe to the topic filter.
+     *
+     * @param topicFilter MQTT topic filter to match received publish topics against
+     * @param handler handler to call with each matching publish. Adding the same handler for the same filter
+     * again has no effect.
+     * @throws IllegalArgumentException if the topic filter or handler is null
+     * @throws CrtRuntimeException if the topic filter is not a valid MQTT topic filter
+     */
+    public void addTopicHandler(String topicFilter, PublishEvents handler) {
+        if (topicFilter == null) {
+            throw new IllegalArgumentException("Topic filter can't be null");
+        }
+        if (handler == null) {
+            throw new IllegalArgumentException("Topic handler can't be null");
+        }
+        mqtt5ClientInternalAddTopicHandler(getNativeHandle(), topicFilter, handler);
+    }
+
+    /**
+     * Stops routing publishes matching a topic filter to a handler added with
+     * {@link #addTopicHandler(String, PublishEvents)}.
+     *
+     * @param topicFilter the topic filter the handler was added with
+     * @param handler the handler to remove
+     * @return true if the handler was registered for the topic filter and has been removed
+     */
+    public boolean removeTopicHandler(String topicFilter, PublishEvents handler) {
+        if (topicFilter == null || handler == null) {
+            return false;
+        }
+        return mqtt5ClientInternalRemoveTopicHandler(getNativeHandle(), topicFilter, handler);
+    }
+
     /**
      * Tells the Mqtt5Client to attempt to subscribe to one or more topic filters.
      *
@@ -186,6 +307,21 @@ public class Mqtt5Client extends CrtResource {
         return mqtt5ClientInternalGetOperationStatistics(getNativeHandle());
     }
 
+    /**
+     * Fills in the client's metrics without allocating: publish and byte counts, connection counts, the operation
+     * queue statistics and latency histograms for publish to PUBACK and for Java callbacks. See
+     * {@link Mqtt5ClientMetrics} for the layout of the array.
+     *
+     * @param metrics array of {@link Mqtt5ClientMetrics#LENGTH} entries to fill in
+     * @throws IllegalArgumentException if the array has the wrong length
+     */
+    public void getMetrics(long[] metrics) {
+        if (metrics == null || metrics.length != Mqtt5ClientMetrics.LENGTH) {
+            throw new IllegalArgumentException("Metrics array must have Mqtt5ClientMetrics.LENGTH entries");
+        }
+        mqtt5ClientInternalFetchMetrics(getNativeHandle(), metrics);
+    }
+
     /**
      * Returns the connectivity state for the Mqtt5Client.
      * @return True if the client is connected, false otherwise
@@ -194,12 +330,26 @@ public class Mqtt5Client extends CrtResource {
         return isConnected;
     }
 
+    /**
+     * Returns the number of QoS 1 publishes in the client's publish spool that the server has not acknowledged yet.
+     * @return Number of spooled publishes, 0 if the client has no publish spool
+     */
+    public int getPublishSpoolPendingCount() {
+        return publishSpool != null ? publishSpool.getPendingCount() : 0;
+    }
+
     /**
      * Sets the connectivity state of the Mqtt5Client. Is used by JNI.
      * @param connected The current connectivity state of the Mqtt5Client
      */
-    private synchronized void setIsConnected(boolean connected) {
-        isConnected = connected;
+    private void setIsConnected(boolean connected) {
+        synchronized (this) {
+            isConnected = connected;
+        }
+        /* Outside the client lock; the spool replays on its own thread, under its own lock */
+        if (connected && publishSpool != null) {
+            publishSpool.replay(this);
+        }
     }
 
     /*******************************************************************************
@@ -241,8 +391,13 @@ public class Mqtt5Client extends CrtResource {
     private static native void mqtt5ClientInternalStart(long client);
     private static native void mqtt5ClientInternalStop(long client, DisconnectPacket disconnect_options);
     private static native void mqtt5ClientInternalPublish(long client, PublishPacket publish_options, CompletableFuture<PublishResult> publish_result);
+    private static native void mqtt5ClientInternalPublishSerialized(long client, ByteBuffer serialized_publish, int offset, int length, CompletableFuture<PublishResult> publish_result);
+    private static native void mqtt5ClientInternalAddTopicHandler(long client, String topic_filter, PublishEvents handler);
+    private static native boolean mqtt5ClientInternalRemoveTopicHandler(long client, String topic_filter, PublishEvents handler);
+    private static native void mqtt5ClientInternalPublishBatch(long client, PublishPacket[] publish_packets, CompletableFuture<PublishBatchResult> batch_result);
     private static native void mqtt5ClientInternalSubscribe(long client, SubscribePacket subscribe_options, CompletableFuture<SubAckPacket> subscribe_suback);
     private static native void mqtt5ClientInternalUnsubscribe(long client, UnsubscribePacket unsubscribe_options, CompletableFuture<UnsubAckPacket> unsubscribe_suback);
     private static native void mqtt5ClientInternalWebsocketHandshakeComplete(long connection, byte[] marshalledRequest, Throwable throwable, long nativeUserData) throws CrtRuntimeException;
+    private static native void mqtt5ClientInternalFetchMetrics(long client, long[] metrics);
     private static native Mqtt5ClientOperationStatistics mqtt5ClientInternalGetOperationStatistics(long client);
 }
@@ -0,0 +1,100 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import software.amazon.awssdk.crt.utils.LatencyHistogramUtils;
+
+/**
+ * Layout of the array filled in by {@link Mqtt5Client#getMetrics(long[])}, with helpers to read it. Nothing here
+ * allocates, so a scraper can reuse one array and poll the client as often as it likes.
+ *
+ * The array holds cumulative counters, then the current operation queue statistics (the same values as
+ * {@link Mqtt5ClientOperationStatistics}), then latency histograms laid out as described by
+ * {@link LatencyHistogramUtils}.
+ *
+ * The counters are kept in native atomics, which are 32 bits wide on 32-bit platforms. There {@link #BYTES_OUT} and
+ * {@link #BYTES_IN} wrap around every 4 GiB, so compute rates from the difference between two polls modulo 2^32.
+ */
+public final class Mqtt5ClientMetrics {
+    /* Must stay in sync with enum aws_mqtt5_jni_metric in mqtt5_client_metrics.h */
+
+    /** Index of the number of publishes handed to the client */
+    public static final int PUBLISHES_OUT = 0;
+    /** Index of the number of publishes received by the client */
+    public static final int PUBLISHES_IN = 1;
+    /** Index of the topic and payload bytes of the publishes handed to the client */
+    public static final int BYTES_OUT = 2;
+    /** Index of the topic and payload bytes of the publishes received by the client */
+    public static final int BYTES_IN = 3;
+    /** Index of the number of successful connections */
+    public static final int CONNECTION_SUCCESSES = 4;
+    /** Index of the number of failed connection attempts */
+    public static final int CONNECTION_FAILURES = 5;
+    /** Index of the number of times an established connection was lost or closed */
+    public static final int DISCONNECTIONS = 6;
+    /** Index of the number of successful connections after the first one */
+    public static final int RECONNECTS = 7;
+
+    /** Index of {@link Mqtt5ClientOperationStatistics#getIncompleteOperationCount()} */
+    public static final int INCOMPLETE_OPERATION_COUNT = 8;
+    /** Index of {@link Mqtt5ClientOperationStatistics#getIncompleteOperationSize()} */
+    public static final int INCOMPLETE_OPERATION_SIZE = 9;
+    /** Index of {@link Mqtt5ClientOperationStatistics#getUnackedOperationCount()} */
+    public static final int UNACKED_OPERATION_COUNT = 10;
+    /** Index of {@link Mqtt5ClientOperationStatistics#getUnackedOperationSize()} */
+    public static final int UNACKED_OPERATION_SIZE = 11;
+
+    /** Number of buckets in each latency histogram */
+    public static final int LATENCY_BUCKET_COUNT = LatencyHistogramUtils.BUCKET_COUNT;
+
+    /** Index of the first bucket of the histogram of the time from handing a QoS 1 publish to the client to PUBACK */
+    public static final int PUBLISH_TO_PUBACK_LATENCY = 12;
+    /** Index of the first bucket of the histogram of time spent in Java callbacks and future completions */
+    public static final int JNI_CALLBACK_DURATION = PUBLISH_TO_PUBACK_LATENCY + LATENCY_BUCKET_COUNT;
+
+    /** Length of the array {@link Mqtt5Client#getMetrics(long[])} fills in */
+    public static final int LENGTH = JNI_CALLBACK_DURATION + LATENCY_BUCKET_COUNT;
+
+    private Mqtt5ClientMetrics() {}
+
+    /**
+     * @return A new array of the length {@link Mqtt5Client#getMetrics(long[])} takes
+     */
+    public static long[] newMetricsArray() {
+        return new long[LENGTH];
+    }
+
+    /**
+     * @param metrics array filled in by {@link Mqtt5Client#getMetrics(long[])}
+     * @param histogram index of the histogram's first bucket, {@link #PUBLISH_TO_PUBACK_LATENCY} or
+     * {@link #JNI_CALLBACK_DURATION}
+     * @return The total number of samples recorded in the histogram.
+     */
+    public static long getSampleCount(long[] metrics, int histogram) {
+        return LatencyHistogramUtils.getSampleCount(metrics, histogram);
+    }
+
+    /**
+     * @param bucket index of the bucket within a histogram
+     * @return The exclusive upper bound of the bucket in microseconds, or Long.MAX_VALUE for the last bucket.
+     */
+    public static long getBucketUpperBoundMicros(int bucket) {
+        return LatencyHistogramUtils.getBucketUpperBoundMicros(bucket);
+    }
+
+    /**
+     * Estimates a percentile of a histogram as the upper bound of the bucket that contains it, so the result
+     * overestimates by at most a factor of two.
+     *
+     * @param metrics array filled in by {@link Mqtt5Client#getMetrics(long[])}
+     * @param histogram index of the histogram's first bucket, {@link #PUBLISH_TO_PUBACK_LATENCY} or
+     * {@link #JNI_CALLBACK_DURATION}
+     * @param percentile percentile between 0 and 100
+     * @return The upper bound in microseconds of the bucket containing the percentile, or 0 if nothing was recorded.
+     */
+    public static long getPercentileUpperBoundMicros(long[] metrics, int histogram, double percentile) {
+        return LatencyHistogramUtils.getPercentileUpperBoundMicros(metrics, histogram, percentile);
+    }
+}
@@ -50,6 +50,10 @@ public class Mqtt5ClientOptions {
     private LifecycleEvents lifecycleEvents;
     private Consumer<Mqtt5WebsocketHandshakeTransformArgs> websocketHandshakeTransform;
     private PublishEvents publishEvents;
+    private boolean directPublishDeliveryEnabled = false;
+    private int publishBatchMaxMessages = 0;
+    private long publishBatchMaxDelayMicros = 0;
+    private PublishSpoolOptions publishSpoolOptions;
 
     /**
      * Returns the host name of the MQTT server to connect to.
@@ -259,6 +263,44 @@ public class Mqtt5ClientOptions {
         return this.publishEvents;
     }
 
+    /**
+     * Returns whether received publishes are delivered as direct buffer views of native memory.
+     *
+     * @return True if direct publish delivery is enabled
+     */
+    public boolean getDirectPublishDeliveryEnabled() {
+        return this.directPublishDeliveryEnabled;
+    }
+
+    /**
+     * Returns the maximum number of received publishes delivered together to
+     * {@link PublishEvents#onMessagesReceived}. Values below 2 mean publishes are not batched.
+     *
+     * @return Maximum number of received publishes per batch
+     */
+    public int getPublishBatchMaxMessages() {
+        return this.publishBatchMaxMessages;
+    }
+
+    /**
+     * Returns the maximum time, in microseconds, a received publish is held back waiting for a batch to fill up.
+     *
+     * @return Maximum time a received publish is held back in a batch
+     */
+    public long getPublishBatchMaxDelayMicros() {
+        return this.publishBatchMaxDelayMicros;
+    }
+
+    /**
+     * Returns the options of the on-disk spool QoS 1 publishes are kept in until acknowledged, or null if the
+     * client doesn't spool publishes.
+     *
+     * @return Publish spool options
+     */
+    public PublishSpoolOptions getPublishSpoolOptions() {
+        return this.publishSpoolOptions;
+    }
+
     /**
      * Creates a Mqtt5ClientOptionsBuilder instance
      * @param builder The builder to get the Mqtt5ClientOptions values from
@@ -284,6 +326,10 @@ public class Mqtt5ClientOptions {
         this.lifecycleEvents = builder.lifecycleEvents;
         this.websocketHandshakeTransform = builder.websocketHandshakeTransform;
         this.publishEvents = builder.publishEvents;
+        this.directPublishDeliveryEnabled = builder.directPublishDeliveryEnabled;
+        this.publishBatchMaxMessages = builder.publishBatchMaxMessages;
+        this.publishBatchMaxDelayMicros = builder.publishBatchMaxDelayMicros;
+        this.publishSpoolOptions = builder.publishSpoolOptions;
     }
 
     /*******************************************************************************
@@ -346,6 +392,21 @@ public class Mqtt5ClientOptions {
          * @param publishReturn All of the data that was received from the server
          */
         public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn);
+
+        /**
+         * Called with a batch of received MQTT PUBLISH packets, in the order they were received, when publish
+         * batching is enabled (see {@link Mqtt5ClientOptionsBuilder#withPublishBatchMaxMessages(int)}).
+         *
+         * The default implementation passes each publish to onMessageReceived.
+         *
+         * @param client The client that has received the messages
+         * @param publishReturns All of the data that was received from the server, one entry per message
+         */
+        public default void onMessagesReceived(Mqtt5Client client, PublishReturn[] publishReturns) {
+            for (PublishReturn publishReturn : publishReturns) {
+                onMessageReceived(client, publishReturn);
+            }
+        }
     }
 
     /*******************************************************************************
@@ -573,6 +634,10 @@ public class Mqtt5ClientOptions {
         private LifecycleEvents lifecycleEvents;
         private Consumer<Mqtt5WebsocketHandshakeTransformArgs> websocketHandshakeTransform;
         private PublishEvents publishEvents;
+        private boolean directPublishDeliveryEnabled = false;
+        private int publishBatchMaxMessages = 0;
+        private long publishBatchMaxDelayMicros = 0;
+        private PublishSpoolOptions publishSpoolOptions;
 
         /**
          * Sets the host name of the MQTT server to connect to.
@@ -829,6 +894,76 @@ public class Mqtt5ClientOptions {
             return this;
         }
 
+        /**
+         * Sets whether received publishes are delivered as direct buffer views of native memory. When enabled, the
+         * PublishReturn passed to {@link PublishEvents#onMessageReceived} exposes the topic and payload through
+         * <code>getTopicBuffer</code> and <code>getPayloadBuffer</code> without copying them, and the PublishPacket
+         * with its optional properties is only built if <code>getPublishPacket</code> is called. The PublishReturn
+         * is only valid during the callback.
+         *
+         * Disabled by default.
+         *
+         * @param directPublishDeliveryEnabled Whether to deliver received publishes as direct buffer views
+         * @return The Mqtt5ClientOptionsBuilder after setting the direct publish delivery mode
+         */
+        public Mqtt5ClientOptionsBuilder withDirectPublishDeliveryEnabled(boolean directPublishDeliveryEnabled) {
+            this.directPublishDeliveryEnabled = directPublishDeliveryEnabled;
+            return this;
+        }
+
+        /**
+         * Sets the maximum number of received publishes the client accumulates before handing them to
+         * {@link PublishEvents#onMessagesReceived} in one call. A partial batch is delivered once its oldest
+         * publish has waited for the batch delay (see {@link #withPublishBatchMaxDelayMicros(long)}), or when a
+         * lifecycle event or client termination occurs.
+         *
+         * Values below 2 disable batching, which is the default. Batching cannot be combined with direct publish
+         * delivery.
+         *
+         * @param publishBatchMaxMessages Maximum number of received publishes per batch
+         * @return The Mqtt5ClientOptionsBuilder after setting the maximum batch size
+         */
+        public Mqtt5ClientOptionsBuilder withPublishBatchMaxMessages(int publishBatchMaxMessages) {
+            if (publishBatchMaxMessages < 0) {
+                throw new IllegalArgumentException("publishBatchMaxMessages must not be negative");
+            }
+            this.publishBatchMaxMessages = publishBatchMaxMessages;
+            return this;
+        }
+
+        /**
+         * Sets the maximum time, in microseconds, a received publish is held back waiting for its batch to fill up.
+         * With a delay of 0 a batch is delivered as soon as the client has finished processing the data it has
+         * read from the socket, so only publishes that arrived together are batched.
+         *
+         * Only used when batching is enabled. Defaults to 0.
+         *
+         * @param publishBatchMaxDelayMicros Maximum time a received publish is held back in a batch
+         * @return The Mqtt5ClientOptionsBuilder after setting the maximum batch delay
+         */
+        public Mqtt5ClientOptionsBuilder withPublishBatchMaxDelayMicros(long publishBatchMaxDelayMicros) {
+            if (publishBatchMaxDelayMicros < 0) {
+                throw new IllegalArgumentException("publishBatchMaxDelayMicros must not be negative");
+            }
+            this.publishBatchMaxDelayMicros = publishBatchMaxDelayMicros;
+            return this;
+        }
+
+        /**
+         * Sets the on-disk spool QoS 1 publishes made with {@link Mqtt5Client#publish(PublishPacket)} are kept in
+         * until the server acknowledges them. While the client is disconnected such publishes are only written to
+         * the spool, which bounds the memory they take, and the spool is replayed whenever the client connects.
+         *
+         * Not set by default, in which case QoS 1 publishes are queued in native memory as usual.
+         *
+         * @param publishSpoolOptions Options of the publish spool, or null to not spool publishes
+         * @return The Mqtt5ClientOptionsBuilder after setting the publish spool options
+         */
+        public Mqtt5ClientOptionsBuilder withPublishSpoolOptions(PublishSpoolOptions publishSpoolOptions) {
+            this.publishSpoolOptions = publishSpoolOptions;
+            return this;
+        }
+
         /**
          * Creates a new Mqtt5ClientOptionsBuilder instance
          *
@@ -0,0 +1,77 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import software.amazon.awssdk.crt.mqtt5.packets.PubAckPacket.PubAckReasonCode;
+
+/**
+ * The result of {@link Mqtt5Client#publishBatch(software.amazon.awssdk.crt.mqtt5.packets.PublishPacket[])}, holding one outcome per publish in the order
+ * the publishes were passed in. A publish that failed does not fail the rest of the batch.
+ */
+public class PublishBatchResult {
+    private final int[] errorCodes;
+    private final int[] pubAckReasonCodes;
+
+    /**
+     * This is only called in JNI to make a new PublishBatchResult.
+     */
+    private PublishBatchResult(int[] errorCodes, int[] pubAckReasonCodes) {
+        this.errorCodes = errorCodes;
+        this.pubAckReasonCodes = pubAckReasonCodes;
+    }
+
+    /**
+     * @return the number of publishes in the batch
+     */
+    public int getCount() {
+        return errorCodes.length;
+    }
+
+    /**
+     * Returns the CRT error code of a publish, zero if it completed successfully.
+     *
+     * @param index index of the publish within the batch
+     * @return the error code of the publish
+     */
+    public int getErrorCode(int index) {
+        return errorCodes[index];
+    }
+
+    /**
+     * @param index index of the publish within the batch
+     * @return true if the publish completed without a CRT error. A QoS 1 publish may still have been rejected by
+     * the server, see {@link #getPubAckReasonCode(int)}
+     */
+    public boolean isSuccessful(int index) {
+        return errorCodes[index] == 0;
+    }
+
+    /**
+     * Returns the reason code of the PUBACK the server sent for a publish.
+     *
+     * @param index index of the publish within the batch
+     * @return the PUBACK reason code, or null if the publish was QoS 0 or did not receive a PUBACK
+     */
+    public PubAckReasonCode getPubAckReasonCode(int index) {
+        int reasonCode = pubAckReasonCodes[index];
+        if (reasonCode < 0) {
+            return null;
+        }
+        return PubAckReasonCode.getEnumValueFromInteger(reasonCode);
+    }
+
+    /**
+     * @return the number of publishes that completed with a CRT error
+     */
+    public int getFailureCount() {
+        int failures = 0;
+        for (int errorCode : errorCodes) {
+            if (errorCode != 0) {
+                failures++;
+            }
+        }
+        return failures;
+    }
+}
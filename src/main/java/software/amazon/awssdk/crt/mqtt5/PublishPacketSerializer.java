@@ -0,0 +1,183 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+import java.nio.charset.StandardCharsets;
+import java.util.List;
+
+import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
+import software.amazon.awssdk.crt.mqtt5.packets.UserProperty;
+
+/**
+ * Writes a PublishPacket into the compact form taken by {@link Mqtt5Client#publishSerialized(ByteBuffer)}, so the
+ * native client can read it straight out of a direct buffer instead of pulling each field off the PublishPacket
+ * through JNI.
+ *
+ * A serialized publish can be built once and published many times, and a buffer can be reused for the next publish
+ * as soon as {@link Mqtt5Client#publishSerialized(ByteBuffer)} returns.
+ */
+public final class PublishPacketSerializer {
+    /* Must stay in sync with AWS_MQTT5_SERIALIZED_PUBLISH_VERSION and the flags in mqtt5_packets.c */
+    private static final byte VERSION = 1;
+    private static final int RETAIN = 1 << 0;
+    private static final int HAS_PAYLOAD_FORMAT = 1 << 1;
+    private static final int HAS_MESSAGE_EXPIRY = 1 << 2;
+    private static final int HAS_RESPONSE_TOPIC = 1 << 3;
+    private static final int HAS_CORRELATION_DATA = 1 << 4;
+    private static final int HAS_CONTENT_TYPE = 1 << 5;
+
+    private static final int MAX_U16 = 0xFFFF;
+    private static final Charset UTF8 = StandardCharsets.UTF_8;
+
+    private PublishPacketSerializer() {}
+
+    /**
+     * Serializes a publish into a new direct buffer, ready to hand to
+     * {@link Mqtt5Client#publishSerialized(ByteBuffer)}.
+     *
+     * @param publishPacket the publish to serialize
+     * @return a direct buffer whose remaining bytes hold the serialized publish
+     * @throws IllegalArgumentException if the publish has no topic or QoS, or a field is too long to encode
+     */
+    public static ByteBuffer serialize(PublishPacket publishPacket) {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(serializedSize(publishPacket));
+        serialize(publishPacket, buffer);
+        buffer.flip();
+        return buffer;
+    }
+
+    /**
+     * Serializes a publish into a caller-owned buffer at its current position, advancing the position past it.
+     * The buffer must be direct to be published.
+     *
+     * @param publishPacket the publish to serialize
+     * @param destination buffer with at least {@link #serializedSize(PublishPacket)} bytes remaining
+     * @throws IllegalArgumentException if the publish has no topic or QoS, or a field is too long to encode
+     * @throws java.nio.BufferOverflowException if the destination is too small
+     */
+    public static void serialize(PublishPacket publishPacket, ByteBuffer destination) {
+        if (publishPacket.getTopic() == null) {
+            throw new IllegalArgumentException("PublishPacket topic can't be null");
+        }
+        if (publishPacket.getQOS() == null) {
+            throw new IllegalArgumentException("PublishPacket QoS can't be null");
+        }
+
+        ByteOrder order = destination.order();
+        destination.order(ByteOrder.BIG_ENDIAN);
+        try {
+            int flags = 0;
+            if (Boolean.TRUE.equals(publishPacket.getRetain())) {
+                flags |= RETAIN;
+            }
+            if (publishPacket.getPayloadFormat() != null) {
+                flags |= HAS_PAYLOAD_FORMAT;
+            }
+            if (publishPacket.getMessageExpiryIntervalSeconds() != null) {
+                flags |= HAS_MESSAGE_EXPIRY;
+            }
+            if (publishPacket.getResponseTopic() != null) {
+                flags |= HAS_RESPONSE_TOPIC;
+            }
+            if (publishPacket.getCorrelationData() != null) {
+                flags |= HAS_CORRELATION_DATA;
+            }
+            if (publishPacket.getContentType() != null) {
+                flags |= HAS_CONTENT_TYPE;
+            }
+
+            destination.put(VERSION);
+            destination.put((byte) publishPacket.getQOS().getValue());
+            destination.put((byte) flags);
+            if (publishPacket.getPayloadFormat() != null) {
+                destination.put((byte) publishPacket.getPayloadFormat().getValue());
+            }
+            if (publishPacket.getMessageExpiryIntervalSeconds() != null) {
+                destination.putInt((int) publishPacket.getMessageExpiryIntervalSeconds().longValue());
+            }
+            putU16Prefixed(destination, publishPacket.getTopic().getBytes(UTF8), "topic");
+            if (publishPacket.getResponseTopic() != null) {
+                putU16Prefixed(destination, publishPacket.getResponseTopic().getBytes(UTF8), "response topic");
+            }
+            if (publishPacket.getCorrelationData() != null) {
+                putU16Prefixed(destination, publishPacket.getCorrelationData(), "correlation data");
+            }
+            if (publishPacket.getContentType() != null) {
+                putU16Prefixed(destination, publishPacket.getContentType().getBytes(UTF8), "content type");
+            }
+
+            List<UserProperty> userProperties = publishPacket.getUserProperties();
+            int userPropertyCount = userProperties != null ? userProperties.size() : 0;
+            if (userPropertyCount > MAX_U16) {
+                throw new IllegalArgumentException("PublishPacket has too many user properties to serialize");
+            }
+            destination.putShort((short) userPropertyCount);
+            for (int i = 0; i < userPropertyCount; i++) {
+                UserProperty property = userProperties.get(i);
+                putU16Prefixed(destination, property.key.getBytes(UTF8), "user property name");
+                putU16Prefixed(destination, property.value.getBytes(UTF8), "user property value");
+            }
+
+            byte[] payload = publishPacket.getPayload();
+            int payloadLength = payload != null ? payload.length : 0;
+            destination.putInt(payloadLength);
+            if (payloadLength > 0) {
+                destination.put(payload);
+            }
+        } finally {
+            destination.order(order);
+        }
+    }
+
+    /**
+     * @param publishPacket the publish to measure
+     * @return the number of bytes {@link #serialize(PublishPacket, ByteBuffer)} writes for this publish
+     */
+    public static int serializedSize(PublishPacket publishPacket) {
+        int size = 3;
+        if (publishPacket.getPayloadFormat() != null) {
+            size += 1;
+        }
+        if (publishPacket.getMessageExpiryIntervalSeconds() != null) {
+            size += 4;
+        }
+        size += 2 + utf8Length(publishPacket.getTopic());
+        if (publishPacket.getResponseTopic() != null) {
+            size += 2 + utf8Length(publishPacket.getResponseTopic());
+        }
+        if (publishPacket.getCorrelationData() != null) {
+            size += 2 + publishPacket.getCorrelationData().length;
+        }
+        if (publishPacket.getContentType() != null) {
+            size += 2 + utf8Length(publishPacket.getContentType());
+        }
+        size += 2;
+        if (publishPacket.getUserProperties() != null) {
+            for (UserProperty property : publishPacket.getUserProperties()) {
+                size += 4 + utf8Length(property.key) + utf8Length(property.value);
+            }
+        }
+        size += 4;
+        if (publishPacket.getPayload() != null) {
+            size += publishPacket.getPayload().length;
+        }
+        return size;
+    }
+
+    private static int utf8Length(String value) {
+        return value != null ? value.getBytes(UTF8).length : 0;
+    }
+
+    private static void putU16Prefixed(ByteBuffer destination, byte[] value, String fieldName) {
+        if (value.length > MAX_U16) {
+            throw new IllegalArgumentException("PublishPacket " + fieldName + " is longer than 65535 bytes");
+        }
+        destination.putShort((short) value.length);
+        destination.put(value);
+    }
+}
@@ -4,24 +4,88 @@
  */
 package software.amazon.awssdk.crt.mqtt5;
 
+import java.nio.ByteBuffer;
+
 import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
 
 /**
  * The data returned when a publish is made to a topic the MQTT5 client is subscribed to.
  * The data contained within can be gotten using the <code>get</code> functions.
  * For example, <code>getPublishPacket</code> will return the PublishPacket received from the server.
+ *
+ * When the client was created with direct publish delivery enabled
+ * (see {@link Mqtt5ClientOptions.Mqtt5ClientOptionsBuilder#withDirectPublishDeliveryEnabled(boolean)}), the topic
+ * and payload are exposed through <code>getTopicBuffer</code> and <code>getPayloadBuffer</code> as read-only views
+ * of native memory, and the PublishPacket is only built if <code>getPublishPacket</code> is called. In that mode the
+ * PublishReturn is only valid on the calling thread for the duration of
+ * {@link Mqtt5ClientOptions.PublishEvents#onMessageReceived}; copy out anything that is needed afterwards.
  */
 public class PublishReturn {
     private PublishPacket publishPacket;
 
+    private ByteBuffer topicBuffer;
+    private ByteBuffer payloadBuffer;
+
+    /*
+     * Pointer to the native publish view while the direct delivery callback is running, cleared by native code
+     * once the callback returns. Only read and cleared on the delivering thread, so it needs no synchronization.
+     */
+    private long nativePublishView;
+
+    /* Thread that runs the direct delivery callbacks, null outside direct publish delivery */
+    private final Thread deliveringThread;
+
     /**
      * Returns the PublishPacket returned from the server or Null if none was returned.
+     *
+     * In direct publish delivery mode the packet, including its optional properties, is built from native data
+     * the first time this is called. This must happen within the publish callback.
+     *
      * @return The PublishPacket returned from the server.
+     * @throws IllegalStateException if called for the first time after a direct delivery callback has returned, or
+     * from a thread other than the one running the callback
      */
     public PublishPacket getPublishPacket() {
+        if (publishPacket == null && topicBuffer != null) {
+            if (Thread.currentThread() != deliveringThread) {
+                throw new IllegalStateException(
+                    "PublishPacket of a directly delivered publish must be read on the callback's thread");
+            }
+            if (nativePublishView == 0) {
+                throw new IllegalStateException(
+                    "PublishPacket of a directly delivered publish must be read within onMessageReceived");
+            }
+            publishPacket = publishReturnMaterializePacket(nativePublishView);
+        }
         return publishPacket;
     }
 
+    /**
+     * Returns a read-only view of the topic's UTF-8 bytes when direct publish delivery is enabled, or null otherwise.
+     * The buffer references native memory and must not be used after the publish callback returns.
+     *
+     * Every call returns a new view positioned at the start of the topic, so reading one doesn't affect what other
+     * handlers of the same publish see.
+     *
+     * @return The topic bytes of the received publish
+     */
+    public ByteBuffer getTopicBuffer() {
+        return topicBuffer != null ? topicBuffer.duplicate() : null;
+    }
+
+    /**
+     * Returns a read-only view of the payload when direct publish delivery is enabled, or null otherwise.
+     * The buffer references native memory and must not be used after the publish callback returns.
+     *
+     * Every call returns a new view positioned at the start of the payload, so reading one doesn't affect what other
+     * handlers of the same publish see.
+     *
+     * @return The payload of the received publish
+     */
+    public ByteBuffer getPayloadBuffer() {
+        return payloadBuffer != null ? payloadBuffer.duplicate() : null;
+    }
+
     /**
      * This is only called in JNI to make a new PublishReturn with a PUBLISH packet.
      * @param newPublishPacket The PubAckPacket data for QoS 1 packets. Can be null if result is non QoS 1.
@@ -29,5 +93,25 @@ public class PublishReturn {
      */
     private PublishReturn(PublishPacket newPublishPacket) {
         this.publishPacket = newPublishPacket;
+        this.deliveringThread = null;
     }
+
+    /**
+     * This is only called in JNI to make a new PublishReturn over native memory in direct publish delivery mode.
+     * @param topicBuffer Direct buffer over the topic bytes
+     * @param payloadBuffer Direct buffer over the payload bytes
+     * @param nativePublishView Pointer to the native publish view, valid for the duration of the callback
+     */
+    private PublishReturn(ByteBuffer topicBuffer, ByteBuffer payloadBuffer, long nativePublishView) {
+        this.topicBuffer = topicBuffer.asReadOnlyBuffer();
+        this.payloadBuffer = payloadBuffer.asReadOnlyBuffer();
+        this.nativePublishView = nativePublishView;
+        this.deliveringThread = Thread.currentThread();
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+
+    private static native PublishPacket publishReturnMaterializePacket(long nativePublishView);
 }
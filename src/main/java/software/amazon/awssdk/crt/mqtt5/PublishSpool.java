@@ -0,0 +1,431 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.OverlappingFileLockException;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
+
+/**
+ * The memory-mapped QoS 1 publish spool configured by {@link PublishSpoolOptions}.
+ *
+ * The file starts with a 16 byte header (magic, version) followed by an append-only log of records, each a 16 byte
+ * record header (payload length, state, sequence number) and a publish written by {@link PublishPacketSerializer}.
+ * A record's state is written last, so a record torn by a crash ends the log when the spool is reopened. Records
+ * are marked done once acknowledged; their space is reclaimed by compacting the log when an append doesn't fit.
+ * A record torn by a crash during compaction fails to decode when it is replayed and is dropped from the spool.
+ * The file is locked while the spool is open, so it can't be shared by two clients.
+ *
+ * Spooled publishes are replayed with {@link Mqtt5Client#publishSerialized(ByteBuffer)} straight from the mapped file.
+ *
+ * Publish completions and replays arrive on the client's event loop. They are handed to a thread owned by the spool,
+ * so the event loop never waits on the spool's lock or on the msync of a record's state change.
+ */
+final class PublishSpool implements AutoCloseable {
+    private static final int MAGIC = 0x4352544d; // "CRTM"
+    private static final int VERSION = 1;
+    private static final int FILE_HEADER_SIZE = 16;
+    private static final int RECORD_HEADER_SIZE = 16;
+
+    private static final int LENGTH_OFFSET = 0;
+    private static final int STATE_OFFSET = 4;
+    private static final int SEQUENCE_OFFSET = 8;
+
+    private static final byte STATE_PENDING = 1;
+    private static final byte STATE_DONE = 2;
+
+    private static final class Record {
+        final long sequence;
+        int offset;
+        final int length;
+        final CompletableFuture<PublishResult> future;
+        boolean inFlight;
+
+        Record(long sequence, int offset, int length, CompletableFuture<PublishResult> future) {
+            this.sequence = sequence;
+            this.offset = offset;
+            this.length = length;
+            this.future = future;
+        }
+    }
+
+    private final PublishSpoolOptions.OverflowPolicy overflowPolicy;
+    private final boolean forceOnWrite;
+    private final FileChannel channel;
+    private final MappedByteBuffer mapped;
+    private final int capacity;
+    private final ExecutorService completionExecutor;
+
+    /* Unacknowledged records, oldest first */
+    private final Map<Long, Record> pending = new LinkedHashMap<>();
+    private int pendingBytes;
+    private int writeOffset;
+    private long nextSequence = 1;
+    private boolean closed = false;
+
+    PublishSpool(PublishSpoolOptions options) throws CrtRuntimeException {
+        options.validateOptions();
+        this.overflowPolicy = options.getOverflowPolicy();
+        this.forceOnWrite = options.getForceOnWrite();
+
+        try {
+            this.channel = FileChannel.open(options.getFilePath(), StandardOpenOption.CREATE, StandardOpenOption.READ,
+                    StandardOpenOption.WRITE);
+        } catch (IOException ex) {
+            throw new CrtRuntimeException(
+                    "Unable to open publish spool " + options.getFilePath() + ": " + ex.getMessage());
+        }
+
+        try {
+            if (channel.tryLock() == null) {
+                throw new OverlappingFileLockException();
+            }
+        } catch (IOException | OverlappingFileLockException ex) {
+            try {
+                channel.close();
+            } catch (IOException closeEx) {
+                // already failing
+            }
+            throw new CrtRuntimeException(
+                    "Publish spool " + options.getFilePath() + " is already in use by another client");
+        }
+
+        try {
+            long existingSize = channel.size();
+            this.capacity = (int) Math.min(Integer.MAX_VALUE, Math.max(options.getMaxSizeBytes(), existingSize));
+            this.mapped = channel.map(FileChannel.MapMode.READ_WRITE, 0, capacity);
+            this.mapped.order(ByteOrder.BIG_ENDIAN);
+            recover();
+        } catch (IOException | RuntimeException ex) {
+            try {
+                channel.close();
+            } catch (IOException closeEx) {
+                // already failing
+            }
+            if (ex instanceof CrtRuntimeException) {
+                throw (CrtRuntimeException) ex;
+            }
+            throw new CrtRuntimeException(
+                    "Unable to map publish spool " + options.getFilePath() + ": " + ex.getMessage());
+        }
+
+        this.completionExecutor = Executors.newSingleThreadExecutor((runnable) -> {
+            Thread thread = new Thread(runnable, "AwsCrtPublishSpool");
+            thread.setDaemon(true);
+            return thread;
+        });
+    }
+
+    /**
+     * Spools a QoS 1 publish and submits it right away if the client is connected. The returned future completes
+     * once the server acknowledges the publish, which may be after any number of reconnects.
+     */
+    synchronized CompletableFuture<PublishResult> publish(Mqtt5Client client, PublishPacket publishPacket) {
+        CompletableFuture<PublishResult> future = new CompletableFuture<>();
+        if (closed) {
+            future.completeExceptionally(new CrtRuntimeException("Publish spool is closed"));
+            return future;
+        }
+
+        int length = PublishPacketSerializer.serializedSize(publishPacket);
+        Record record = append(publishPacket, length, future);
+        if (record == null) {
+            future.completeExceptionally(new CrtRuntimeException("Publish spool is full"));
+            return future;
+        }
+
+        if (client.getIsConnected()) {
+            submit(client, record);
+        }
+        return future;
+    }
+
+    /**
+     * Submits every spooled publish that isn't already with the client, oldest first. Called on the event loop when
+     * the client connects, and runs on the spool's thread.
+     */
+    void replay(Mqtt5Client client) {
+        runOffEventLoop(() -> replayPending(client));
+    }
+
+    private synchronized void replayPending(Mqtt5Client client) {
+        if (closed) {
+            return;
+        }
+        /* Copied since a submission that fails synchronously removes its record */
+        List<Record> toSubmit = new ArrayList<>();
+        for (Record record : pending.values()) {
+            if (!record.inFlight) {
+                toSubmit.add(record);
+            }
+        }
+        for (Record record : toSubmit) {
+            submit(client, record);
+        }
+    }
+
+    /**
+     * @return the number of publishes in the spool that have not been acknowledged
+     */
+    synchronized int getPendingCount() {
+        return pending.size();
+    }
+
+    @Override
+    public synchronized void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        /* Queued completions find the spool closed and do nothing */
+        completionExecutor.shutdown();
+        mapped.force();
+        try {
+            channel.close();
+        } catch (IOException ex) {
+            // the mapping stays valid and every write has been forced
+        }
+        for (Record record : pending.values()) {
+            if (record.future != null) {
+                record.future.completeExceptionally(
+                        new CrtRuntimeException("Mqtt5Client closed, the publish remains in the spool"));
+            }
+        }
+        pending.clear();
+        pendingBytes = 0;
+    }
+
+    private void submit(Mqtt5Client client, Record record) {
+        record.inFlight = true;
+        /* The client copies the publish before returning, and holding the lock keeps compaction from moving it */
+        ByteBuffer serializedPublish = mapped.duplicate();
+        serializedPublish.position(record.offset + RECORD_HEADER_SIZE);
+        serializedPublish.limit(record.offset + RECORD_HEADER_SIZE + record.length);
+        CompletableFuture<PublishResult> publishFuture;
+        try {
+            publishFuture = client.publishSerialized(serializedPublish);
+        } catch (RuntimeException ex) {
+            onPublishComplete(record, null, ex);
+            return;
+        }
+        publishFuture.whenCompleteAsync((result, error) -> onPublishComplete(record, result, error),
+                this::runOffEventLoop);
+    }
+
+    private void runOffEventLoop(Runnable task) {
+        try {
+            completionExecutor.execute(task);
+        } catch (RejectedExecutionException ex) {
+            // closed, every pending future has already been completed
+        }
+    }
+
+    private void onPublishComplete(Record record, PublishResult result, Throwable error) {
+        synchronized (this) {
+            if (closed || pending.get(record.sequence) != record) {
+                /* Dropped on overflow or closed, its future is already complete */
+                return;
+            }
+            record.inFlight = false;
+
+            if (error != null && isRetryable(error)) {
+                /* Stays in the spool and goes out again on the next connection */
+                return;
+            }
+
+            remove(record);
+        }
+
+        /* Outside the lock, so whatever the caller chained onto the future can use the spool */
+        if (record.future != null) {
+            if (error != null) {
+                record.future.completeExceptionally(error);
+            } else {
+                record.future.complete(result);
+            }
+        }
+    }
+
+    /*
+     * A publish the client rejects as invalid, or a record that no longer decodes, will never succeed. Anything else
+     * failed for want of a connection.
+     */
+    private static boolean isRetryable(Throwable error) {
+        if (error instanceof CrtRuntimeException) {
+            String errorName = ((CrtRuntimeException) error).errorName;
+            return errorName == null
+                    || (!errorName.contains("VALIDATION") && !errorName.equals("AWS_ERROR_INVALID_ARGUMENT"));
+        }
+        return false;
+    }
+
+    private Record append(PublishPacket publishPacket, int length, CompletableFuture<PublishResult> future) {
+        int recordSize = RECORD_HEADER_SIZE + length;
+        if (recordSize > capacity - FILE_HEADER_SIZE) {
+            return null;
+        }
+
+        if (!hasRoom(recordSize)) {
+            if (overflowPolicy == PublishSpoolOptions.OverflowPolicy.DROP_OLDEST && !dropOldest(recordSize)) {
+                return null;
+            }
+            compact();
+            if (!hasRoom(recordSize)) {
+                return null;
+            }
+        }
+
+        int offset = writeOffset;
+        ByteBuffer destination = mapped.duplicate();
+        destination.position(offset + RECORD_HEADER_SIZE);
+        PublishPacketSerializer.serialize(publishPacket, destination);
+
+        Record record = new Record(nextSequence++, offset, length, future);
+        mapped.putLong(offset + SEQUENCE_OFFSET, record.sequence);
+        mapped.putInt(offset + LENGTH_OFFSET, length);
+        writeOffset = offset + recordSize;
+        writeTerminator();
+        mapped.put(offset + STATE_OFFSET, STATE_PENDING);
+        force();
+
+        pending.put(record.sequence, record);
+        pendingBytes += recordSize;
+        return record;
+    }
+
+    /*
+     * Drops the oldest publishes that haven't been handed to the client until a record of the given size fits, or
+     * drops nothing if it can't fit. In-flight publishes may still be delivered, so they are never reported dropped.
+     */
+    private boolean dropOldest(int recordSize) {
+        int maxPendingBytes = capacity - FILE_HEADER_SIZE - recordSize;
+        List<Record> evicted = new ArrayList<>();
+        int remainingBytes = pendingBytes;
+        for (Record record : pending.values()) {
+            if (remainingBytes <= maxPendingBytes) {
+                break;
+            }
+            if (!record.inFlight) {
+                evicted.add(record);
+                remainingBytes -= RECORD_HEADER_SIZE + record.length;
+            }
+        }
+        if (remainingBytes > maxPendingBytes) {
+            return false;
+        }
+
+        for (Record record : evicted) {
+            remove(record);
+            if (record.future != null) {
+                record.future.completeExceptionally(
+                        new CrtRuntimeException("Publish dropped from the spool to make room for a newer one"));
+            }
+        }
+        return true;
+    }
+
+    private boolean hasRoom(int recordSize) {
+        return writeOffset + recordSize <= capacity;
+    }
+
+    private void remove(Record record) {
+        pending.remove(record.sequence);
+        pendingBytes -= RECORD_HEADER_SIZE + record.length;
+        mapped.put(record.offset + STATE_OFFSET, STATE_DONE);
+        if (pending.isEmpty()) {
+            /* Nothing left to keep, so the whole log can be reused */
+            writeOffset = FILE_HEADER_SIZE;
+            writeTerminator();
+        }
+        force();
+    }
+
+    /* Slides the pending records to the front of the log, dropping the space of acknowledged ones */
+    private void compact() {
+        int destination = FILE_HEADER_SIZE;
+        Iterator<Record> iterator = pending.values().iterator();
+        while (iterator.hasNext()) {
+            Record record = iterator.next();
+            int recordSize = RECORD_HEADER_SIZE + record.length;
+            if (record.offset != destination) {
+                byte[] bytes = new byte[recordSize];
+                ByteBuffer source = mapped.duplicate();
+                source.position(record.offset);
+                source.get(bytes);
+                ByteBuffer target = mapped.duplicate();
+                target.position(destination);
+                target.put(bytes);
+                record.offset = destination;
+            }
+            destination += recordSize;
+        }
+        writeOffset = destination;
+        writeTerminator();
+        force();
+    }
+
+    private void writeTerminator() {
+        if (writeOffset + RECORD_HEADER_SIZE <= capacity) {
+            mapped.putInt(writeOffset + LENGTH_OFFSET, 0);
+            mapped.put(writeOffset + STATE_OFFSET, (byte) 0);
+        }
+    }
+
+    private void force() {
+        if (forceOnWrite) {
+            mapped.force();
+        }
+    }
+
+    private void recover() {
+        int magic = mapped.getInt(0);
+        if (magic == 0) {
+            mapped.putInt(0, MAGIC);
+            mapped.putInt(4, VERSION);
+            writeOffset = FILE_HEADER_SIZE;
+            writeTerminator();
+            mapped.force();
+            return;
+        }
+        if (magic != MAGIC || mapped.getInt(4) != VERSION) {
+            throw new CrtRuntimeException("File is not a publish spool written by this version");
+        }
+
+        int offset = FILE_HEADER_SIZE;
+        while (offset + RECORD_HEADER_SIZE <= capacity) {
+            int length = mapped.getInt(offset + LENGTH_OFFSET);
+            byte state = mapped.get(offset + STATE_OFFSET);
+            if (length <= 0 || length > capacity - offset - RECORD_HEADER_SIZE
+                    || (state != STATE_PENDING && state != STATE_DONE)) {
+                break;
+            }
+            long sequence = mapped.getLong(offset + SEQUENCE_OFFSET);
+            if (state == STATE_PENDING) {
+                pending.put(sequence, new Record(sequence, offset, length, null));
+                pendingBytes += RECORD_HEADER_SIZE + length;
+            }
+            nextSequence = Math.max(nextSequence, sequence + 1);
+            offset += RECORD_HEADER_SIZE + length;
+        }
+        writeOffset = offset;
+        compact();
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import java.nio.file.Path;
+
+/**
+ * Configures the on-disk spool an Mqtt5Client keeps its QoS 1 publishes in until the server acknowledges them.
+ *
+ * The spool is a single memory-mapped file of fixed size. While the client is disconnected, QoS 1 publishes are only
+ * written to the spool instead of being queued in native memory, and everything still in the spool is replayed when
+ * the client connects, including publishes left over from a previous process that used the same file.
+ *
+ * Spooled publishes reach the file through the page cache; enable {@link #withForceOnWrite(boolean)} for them to
+ * also survive a power loss.
+ *
+ * Only {@link Mqtt5Client#publish(software.amazon.awssdk.crt.mqtt5.packets.PublishPacket)} goes through the spool.
+ * {@link Mqtt5Client#publishBatch} and {@link Mqtt5Client#publishSerialized} hand publishes straight to the native
+ * client, so they are lost like any other queued operation if the process exits before they are acknowledged.
+ */
+public class PublishSpoolOptions {
+
+    /**
+     * What to do with a new publish when the spool has no room left for it
+     */
+    public enum OverflowPolicy {
+        /**
+         * Fail the new publish and keep everything already in the spool
+         */
+        REJECT_NEW,
+
+        /**
+         * Drop the oldest publishes in the spool, failing their futures, until the new publish fits. Publishes already
+         * handed to the client are never dropped; if the new publish can't fit without them, it fails instead.
+         */
+        DROP_OLDEST
+    }
+
+    private static final long MIN_MAX_SIZE_BYTES = 4096;
+
+    private Path filePath;
+    private long maxSizeBytes = 16 * 1024 * 1024;
+    private OverflowPolicy overflowPolicy = OverflowPolicy.REJECT_NEW;
+    private boolean forceOnWrite = false;
+
+    /**
+     * Default constructor
+     */
+    public PublishSpoolOptions() {}
+
+    /**
+     * Sets the file the spool is kept in. The file is created if it does not exist, and publishes left in it by a
+     * previous client are replayed.
+     *
+     * @param filePath path of the spool file
+     * @return this
+     */
+    public PublishSpoolOptions withFilePath(Path filePath) {
+        this.filePath = filePath;
+        return this;
+    }
+
+    /**
+     * @return path of the spool file
+     */
+    public Path getFilePath() {
+        return filePath;
+    }
+
+    /**
+     * Sets the size of the spool file, which bounds how much unacknowledged publish data is held. An existing spool
+     * file that is larger keeps its size. Defaults to 16 MiB.
+     *
+     * @param maxSizeBytes size of the spool file, at least 4096 and at most Integer.MAX_VALUE bytes
+     * @return this
+     */
+    public PublishSpoolOptions withMaxSizeBytes(long maxSizeBytes) {
+        this.maxSizeBytes = maxSizeBytes;
+        return this;
+    }
+
+    /**
+     * @return size of the spool file
+     */
+    public long getMaxSizeBytes() {
+        return maxSizeBytes;
+    }
+
+    /**
+     * Sets what happens to a new publish when the spool is full. Defaults to {@link OverflowPolicy#REJECT_NEW}.
+     *
+     * @param overflowPolicy policy to apply when the spool is full
+     * @return this
+     */
+    public PublishSpoolOptions withOverflowPolicy(OverflowPolicy overflowPolicy) {
+        this.overflowPolicy = overflowPolicy;
+        return this;
+    }
+
+    /**
+     * @return policy applied when the spool is full
+     */
+    public OverflowPolicy getOverflowPolicy() {
+        return overflowPolicy;
+    }
+
+    /**
+     * Sets whether each change to the spool is forced to the storage device before the publish continues. Slower,
+     * but spooled publishes survive a power loss and not only a process exit. Disabled by default.
+     *
+     * @param forceOnWrite whether to force every spool write to storage
+     * @return this
+     */
+    public PublishSpoolOptions withForceOnWrite(boolean forceOnWrite) {
+        this.forceOnWrite = forceOnWrite;
+        return this;
+    }
+
+    /**
+     * @return whether every spool write is forced to storage
+     */
+    public boolean getForceOnWrite() {
+        return forceOnWrite;
+    }
+
+    /**
+     * Validate the spool options.
+     *
+     * @throws IllegalArgumentException if an option is not valid
+     */
+    public void validateOptions() {
+        if (filePath == null) {
+            throw new IllegalArgumentException("Publish spool file path can't be null");
+        }
+        if (maxSizeBytes < MIN_MAX_SIZE_BYTES || maxSizeBytes > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("Publish spool size must be between 4096 and Integer.MAX_VALUE bytes");
+        }
+        if (overflowPolicy == null) {
+            throw new IllegalArgumentException("Publish spool overflow policy can't be null");
+        }
+    }
+}
@@ -14,6 +14,7 @@ import software.amazon.awssdk.crt.io.TlsContext;
 import software.amazon.awssdk.crt.io.StandardRetryOptions;
 import software.amazon.awssdk.crt.Log;
 import java.net.URI;
+import java.nio.file.Path;
 
 public class S3Client extends CrtResource {
 
@@ -63,6 +64,12 @@ public class S3Client extends CrtResource {
             return null;
         }
 
+        if (options.getRequestFilePath() != null && options.getHttpRequest().getBodyStream() != null) {
+            Log.log(Log.LogLevel.Error, Log.LogSubject.S3Client,
+                    "S3Client.makeMetaRequest has invalid options; Request File Path and Http Request body stream cannot both be set.");
+            return null;
+        }
+
         S3MetaRequest metaRequest = new S3MetaRequest();
         S3MetaRequestResponseHandlerNativeAdapter responseHandlerNativeAdapter = new S3MetaRequestResponseHandlerNativeAdapter(
                 options.getResponseHandler());
@@ -73,6 +80,8 @@ public class S3Client extends CrtResource {
             credentialsProviderNativeHandle = options.getCredentialsProvider().getNativeHandle();
         }
         URI endpoint = options.getEndpoint();
+        Path responseFilePath = options.getResponseFilePath();
+        Path requestFilePath = options.getRequestFilePath();
 
         ChecksumConfig checksumConfig = options.getChecksumConfig() != null ? options.getChecksumConfig()
                 : new ChecksumConfig();
@@ -83,7 +92,10 @@ public class S3Client extends CrtResource {
                 ChecksumAlgorithm.marshallAlgorithmsForJNI(checksumConfig.getValidateChecksumAlgorithmList()),
                 httpRequestBytes, options.getHttpRequest().getBodyStream(), credentialsProviderNativeHandle,
                 responseHandlerNativeAdapter, endpoint == null ? null : endpoint.toString().getBytes(UTF8),
-                options.getResumeToken());
+                options.getResumeToken(), options.getDirectResponseBodyEnabled(),
+                responseFilePath == null ? null : responseFilePath.toString(),
+                requestFilePath == null ? null : requestFilePath.toString(),
+                options.getProgressIntervalBytes(), options.getProgressIntervalMillis());
 
         metaRequest.setMetaRequestNativeHandle(metaRequestNativeHandle);
         if (credentialsProviderNativeHandle != 0) {
@@ -136,5 +148,6 @@ public class S3Client extends CrtResource {
             int[] validateAlgorithms, byte[] httpRequestBytes,
             HttpRequestBodyStream httpRequestBodyStream,
             long signingConfig, S3MetaRequestResponseHandlerNativeAdapter responseHandlerNativeAdapter,
-            byte[] endpoint, ResumeToken resumeToken);
+            byte[] endpoint, ResumeToken resumeToken, boolean directResponseBody, String responseFilePath,
+            String requestFilePath, long progressIntervalBytes, long progressIntervalMillis);
 }
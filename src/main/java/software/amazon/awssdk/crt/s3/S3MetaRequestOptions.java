@@ -8,6 +8,7 @@ import software.amazon.awssdk.crt.http.HttpRequest;
 import software.amazon.awssdk.crt.auth.credentials.CredentialsProvider;
 
 import java.net.URI;
+import java.nio.file.Path;
 import java.util.HashMap;
 import java.util.Map;
 
@@ -84,6 +85,11 @@ public class S3MetaRequestOptions {
     private CredentialsProvider credentialsProvider;
     private URI endpoint;
     private ResumeToken resumeToken;
+    private boolean directResponseBodyEnabled = false;
+    private Path responseFilePath;
+    private Path requestFilePath;
+    private long progressIntervalBytes = 0;
+    private long progressIntervalMillis = 0;
 
     public S3MetaRequestOptions withMetaRequestType(MetaRequestType metaRequestType) {
         this.metaRequestType = metaRequestType;
@@ -198,4 +204,132 @@ public class S3MetaRequestOptions {
     public ResumeToken getResumeToken() {
         return resumeToken;
     }
+
+    /**
+     * If true, response body parts are delivered to
+     * {@link S3MetaRequestResponseHandler#onResponseBody} as read-only direct {@link java.nio.ByteBuffer}s
+     * that point straight at the native part buffer, instead of being copied into a new heap buffer.
+     * This avoids a copy and a heap allocation per part, which matters for large, high-throughput downloads.
+     * <p>
+     * The buffer is only valid for the duration of the {@code onResponseBody} call. Do not retain it;
+     * copy out any bytes you need before returning.
+     * <p>
+     * Defaults to false.
+     *
+     * @param directResponseBodyEnabled whether to deliver the response body as direct buffers over native memory
+     * @return this
+     */
+    public S3MetaRequestOptions withDirectResponseBodyEnabled(boolean directResponseBodyEnabled) {
+        this.directResponseBodyEnabled = directResponseBodyEnabled;
+        return this;
+    }
+
+    /**
+     * @return whether the response body is delivered as direct buffers over native memory
+     */
+    public boolean getDirectResponseBodyEnabled() {
+        return directResponseBodyEnabled;
+    }
+
+    /**
+     * If set, the response body is written by native code directly to this file, each part at its
+     * offset in the object. The file is created if it does not exist and truncated if it does, once the first
+     * part arrives, so a request that fails before any of the body arrives leaves an existing file untouched.
+     * With read backpressure enabled, the read window is opened natively as each part is written.
+     * <p>
+     * The body never crosses into Java in this mode:
+     * {@link S3MetaRequestResponseHandler#onResponseBody} is not invoked. Instead,
+     * {@link S3MetaRequestResponseHandler#onProgress} reports the bytes written for each part, and
+     * {@link S3MetaRequestResponseHandler#onFinished} is invoked once the file has been closed.
+     *
+     * @param responseFilePath path of the file to write the response body to
+     * @return this
+     */
+    public S3MetaRequestOptions withResponseFilePath(Path responseFilePath) {
+        this.responseFilePath = responseFilePath;
+        return this;
+    }
+
+    /**
+     * @return path of the file the response body is written to, or null if the body is delivered to the response handler
+     */
+    public Path getResponseFilePath() {
+        return responseFilePath;
+    }
+
+    /**
+     * If set, the request body is read by native code directly from this file, instead of from the
+     * {@link software.amazon.awssdk.crt.http.HttpRequestBodyStream} of the HTTP request. For a
+     * PUT_OBJECT meta request, the parts of a multipart upload are read in parallel at their offsets in the file,
+     * so large uploads are not limited by a single sequential Java stream.
+     * <p>
+     * The HTTP request must not have a body stream when this is set.
+     *
+     * @param requestFilePath path of the file to read the request body from
+     * @return this
+     */
+    public S3MetaRequestOptions withRequestFilePath(Path requestFilePath) {
+        this.requestFilePath = requestFilePath;
+        return this;
+    }
+
+    /**
+     * @return path of the file the request body is read from, or null if the body comes from the HTTP request
+     */
+    public Path getRequestFilePath() {
+        return requestFilePath;
+    }
+
+    /**
+     * Coalesce progress events natively, so that {@link S3MetaRequestResponseHandler#onProgress} is invoked at
+     * most once for every progressIntervalBytes bytes transferred. Any remaining progress is delivered before
+     * {@link S3MetaRequestResponseHandler#onFinished}.
+     * <p>
+     * When progress is coalesced (by bytes or by time), {@link S3MetaRequestProgress} instances are reused
+     * between onProgress calls; do not retain them. onProgress may be called from several threads at once.
+     * <p>
+     * Defaults to 0, which reports every progress event as it happens.
+     *
+     * @param progressIntervalBytes minimum number of bytes between progress reports, or 0 to disable
+     * @return this
+     */
+    public S3MetaRequestOptions withProgressIntervalBytes(long progressIntervalBytes) {
+        if (progressIntervalBytes < 0) {
+            throw new IllegalArgumentException("progressIntervalBytes cannot be negative");
+        }
+        this.progressIntervalBytes = progressIntervalBytes;
+        return this;
+    }
+
+    /**
+     * @return minimum number of bytes between progress reports, 0 if not coalescing by bytes
+     */
+    public long getProgressIntervalBytes() {
+        return progressIntervalBytes;
+    }
+
+    /**
+     * Coalesce progress events natively, so that {@link S3MetaRequestResponseHandler#onProgress} is invoked at
+     * most once per progressIntervalMillis milliseconds. Can be combined with
+     * {@link #withProgressIntervalBytes}, in which case progress is reported when either interval elapses.
+     * <p>
+     * Defaults to 0, which reports every progress event as it happens.
+     *
+     * @param progressIntervalMillis minimum number of milliseconds between progress reports, or 0 to disable
+     * @return this
+     */
+    public S3MetaRequestOptions withProgressIntervalMillis(long progressIntervalMillis) {
+        if (progressIntervalMillis < 0) {
+            throw new IllegalArgumentException("progressIntervalMillis cannot be negative");
+        }
+        this.progressIntervalMillis = progressIntervalMillis;
+        return this;
+    }
+
+    /**
+     * @return minimum number of milliseconds between progress reports, 0 if not coalescing by time
+     */
+    public long getProgressIntervalMillis() {
+        return progressIntervalMillis;
+    }
 }
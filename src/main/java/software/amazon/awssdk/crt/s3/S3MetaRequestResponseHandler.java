@@ -34,6 +34,9 @@ public interface S3MetaRequestResponseHandler {
      * <p>
      * If backpressure is disabled, you do not need to maintain the flow-control window,
      * data will arrive as fast as possible.
+     * <p>
+     * If the meta request was made with {@link S3MetaRequestOptions#withDirectResponseBodyEnabled} set true,
+     * bodyBytesIn is a read-only view of native memory that is only valid until this method returns.
      *
      * @param bodyBytesIn The body data for this chunk of the object
      * @param objectRangeStart The byte index of the object that this refers to. For example, for an HTTP message that
@@ -58,7 +61,8 @@ public interface S3MetaRequestResponseHandler {
 
     /**
      * Invoked to report progress of the meta request execution.
-     * Currently, the progress callback is invoked only for the CopyObject meta request type.
+     * Currently, the progress callback is invoked only for the CopyObject meta request type, and for
+     * meta requests whose response body is written to a file (see {@link S3MetaRequestOptions#withResponseFilePath}).
      * TODO: support this callback for all types of meta requests
      * @param progress information about the progress of the meta request execution
      */
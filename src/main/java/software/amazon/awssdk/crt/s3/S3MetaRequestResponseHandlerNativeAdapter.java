@@ -19,6 +19,10 @@ class S3MetaRequestResponseHandlerNativeAdapter {
         return this.responseHandler.onResponseBody(ByteBuffer.wrap(bodyBytesIn), objectRangeStart, objectRangeEnd);
     }
 
+    int onResponseBodyDirect(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+        return this.responseHandler.onResponseBody(bodyBytesIn.asReadOnlyBuffer(), objectRangeStart, objectRangeEnd);
+    }
+
     void onFinished(int errorCode, int responseStatus, byte[] errorPayload, int checksumAlgorithm, boolean didValidateChecksum) {
         S3FinishedResponseContext context = new S3FinishedResponseContext(errorCode, responseStatus, errorPayload, ChecksumAlgorithm.getEnumValueFromInteger(checksumAlgorithm), didValidateChecksum);
         this.responseHandler.onFinished(context);
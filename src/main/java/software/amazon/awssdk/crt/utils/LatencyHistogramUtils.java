@@ -0,0 +1,71 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.utils;
+
+/**
+ * Reads the latency histograms the native layer records. Every histogram has {@link #BUCKET_COUNT} power-of-two
+ * microsecond buckets: bucket 0 counts samples under 1 microsecond, bucket i counts samples in [2^(i-1), 2^i)
+ * microseconds and the last bucket counts everything longer. A histogram is a run of {@link #BUCKET_COUNT} entries
+ * starting at some offset of a long[], so callers can read one out of a larger array without copying it.
+ */
+public final class LatencyHistogramUtils {
+    /** Number of buckets in a histogram. Must stay in sync with AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT */
+    public static final int BUCKET_COUNT = 32;
+
+    private LatencyHistogramUtils() {}
+
+    /**
+     * @param buckets array holding the histogram
+     * @param offset index of the histogram's first bucket
+     * @return The total number of samples recorded in the histogram.
+     */
+    public static long getSampleCount(long[] buckets, int offset) {
+        long count = 0;
+        for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+            count += buckets[offset + bucket];
+        }
+        return count;
+    }
+
+    /**
+     * @param bucket index of the bucket within a histogram
+     * @return The exclusive upper bound of the bucket in microseconds, or Long.MAX_VALUE for the last bucket.
+     */
+    public static long getBucketUpperBoundMicros(int bucket) {
+        if (bucket >= BUCKET_COUNT - 1) {
+            return Long.MAX_VALUE;
+        }
+        return 1L << bucket;
+    }
+
+    /**
+     * Estimates a percentile of a histogram as the upper bound of the bucket that contains it, so the result
+     * overestimates by at most a factor of two.
+     *
+     * @param buckets array holding the histogram
+     * @param offset index of the histogram's first bucket
+     * @param percentile percentile between 0 and 100
+     * @return The upper bound in microseconds of the bucket containing the percentile, or 0 if nothing was recorded.
+     */
+    public static long getPercentileUpperBoundMicros(long[] buckets, int offset, double percentile) {
+        if (percentile < 0 || percentile > 100) {
+            throw new IllegalArgumentException("percentile must be between 0 and 100");
+        }
+        long count = getSampleCount(buckets, offset);
+        if (count == 0) {
+            return 0;
+        }
+
+        long target = Math.max(1, (long) Math.ceil(count * percentile / 100.0));
+        long seen = 0;
+        for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+            seen += buckets[offset + bucket];
+            if (seen >= target) {
+                return getBucketUpperBoundMicros(bucket);
+            }
+        }
+        return Long.MAX_VALUE;
+    }
+}
@@ -4,10 +4,24 @@
  */
 #include <jni.h>
 
+#include <aws/cal/hash.h>
 #include <aws/checksums/crc.h>
+#include <aws/common/thread.h>
 
 #include "crt.h"
 
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
 jint crc_common(
     JNIEnv *env,
     jbyteArray input,
@@ -29,6 +43,28 @@ jint crc_common(
     return res_signed;
 }
 
+/* Same as crc_common, over the memory of a direct ByteBuffer; the caller has checked the range is in bounds */
+jint crc_direct_common(
+    JNIEnv *env,
+    jobject input,
+    jint previous,
+    const size_t start,
+    size_t length,
+    uint32_t (*checksum_fn)(const uint8_t *, int, uint32_t)) {
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, input);
+    if (address == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "ByteBuffer is not a direct buffer");
+        return previous;
+    }
+    struct aws_byte_cursor cursor = aws_byte_cursor_from_array(address + start, length);
+    uint32_t res = (uint32_t)previous;
+    while (cursor.len > INT_MAX) {
+        res = checksum_fn(cursor.ptr, INT_MAX, res);
+        aws_byte_cursor_advance(&cursor, INT_MAX);
+    }
+    return (jint)checksum_fn(cursor.ptr, (int)cursor.len, res);
+}
+
 JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32_crc32(
     JNIEnv *env,
     jclass jni_class,
@@ -50,3 +86,256 @@ JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32C_crc32c(
     (void)jni_class;
     return crc_common(env, input, previous, offset, length, aws_checksums_crc32c);
 }
+
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32_crc32Direct(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject input,
+    jint previous,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+    return crc_direct_common(env, input, previous, offset, length, aws_checksums_crc32);
+}
+
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32C_crc32cDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject input,
+    jint previous,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+    return crc_direct_common(env, input, previous, offset, length, aws_checksums_crc32c);
+}
+
+/*
+ * CRC64/NVME (reflected polynomial 0x9a6c9329ac4bc9b5, init and xorout all ones), the full-object checksum S3 uses.
+ * The aws-checksums version this binding builds against has no CRC64 kernel, so this is a portable slice-by-8
+ * implementation that takes the previous value the same way the aws_checksums_crc32* functions do.
+ */
+#define CRC64NVME_POLYNOMIAL 0x9a6c9329ac4bc9b5ULL
+
+static uint64_t s_crc64nvme_table[8][256];
+static aws_thread_once s_crc64nvme_table_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_crc64nvme_init_table(void *user_data) {
+    (void)user_data;
+    for (uint64_t i = 0; i < 256; ++i) {
+        uint64_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC64NVME_POLYNOMIAL : crc >> 1;
+        }
+        s_crc64nvme_table[0][i] = crc;
+    }
+    for (size_t i = 0; i < 256; ++i) {
+        for (size_t slice = 1; slice < 8; ++slice) {
+            uint64_t previous = s_crc64nvme_table[slice - 1][i];
+            s_crc64nvme_table[slice][i] = (previous >> 8) ^ s_crc64nvme_table[0][previous & 0xff];
+        }
+    }
+}
+
+static uint64_t s_crc64nvme(const uint8_t *input, size_t length, uint64_t previous) {
+    aws_thread_call_once(&s_crc64nvme_table_once, s_crc64nvme_init_table, NULL);
+
+    uint64_t crc = ~previous;
+    while (length >= 8) {
+        crc ^= (uint64_t)input[0] | ((uint64_t)input[1] << 8) | ((uint64_t)input[2] << 16) |
+               ((uint64_t)input[3] << 24) | ((uint64_t)input[4] << 32) | ((uint64_t)input[5] << 40) |
+               ((uint64_t)input[6] << 48) | ((uint64_t)input[7] << 56);
+        crc = s_crc64nvme_table[7][crc & 0xff] ^ s_crc64nvme_table[6][(crc >> 8) & 0xff] ^
+              s_crc64nvme_table[5][(crc >> 16) & 0xff] ^ s_crc64nvme_table[4][(crc >> 24) & 0xff] ^
+              s_crc64nvme_table[3][(crc >> 32) & 0xff] ^ s_crc64nvme_table[2][(crc >> 40) & 0xff] ^
+              s_crc64nvme_table[1][(crc >> 48) & 0xff] ^ s_crc64nvme_table[0][crc >> 56];
+        input += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        crc = s_crc64nvme_table[0][(crc ^ *input++) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_checksums_CRC64NVME_crc64nvme(
+    JNIEnv *env,
+    jclass jni_class,
+    jbyteArray input,
+    jlong previous,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+    struct aws_byte_cursor c_byte_array = aws_jni_byte_cursor_from_jbyteArray_acquire(env, input);
+    struct aws_byte_cursor cursor = c_byte_array;
+    aws_byte_cursor_advance(&cursor, (size_t)offset);
+    cursor.len = aws_min_size((size_t)length, cursor.len);
+    jlong res = (jlong)s_crc64nvme(cursor.ptr, cursor.len, (uint64_t)previous);
+    aws_jni_byte_cursor_from_jbyteArray_release(env, input, c_byte_array);
+    return res;
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_checksums_CRC64NVME_crc64nvmeDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject input,
+    jlong previous,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, input);
+    if (address == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "ByteBuffer is not a direct buffer");
+        return previous;
+    }
+    return (jlong)s_crc64nvme(address + offset, (size_t)length, (uint64_t)previous);
+}
+
+/*
+ * SHA1/SHA256 digests through aws-c-cal, which uses the platform's crypto library (and with it SHA-NI/ARMv8 SHA
+ * instructions where available). An aws_hash can't be reused after finalize, so finishing a digest swaps in a
+ * fresh one.
+ */
+enum crt_digest_algorithm {
+    CRT_DIGEST_SHA1 = 0,
+    CRT_DIGEST_SHA256 = 1,
+};
+
+struct crt_digest {
+    struct aws_allocator *allocator;
+    enum crt_digest_algorithm algorithm;
+    struct aws_hash *hash;
+};
+
+static struct aws_hash *s_crt_digest_new_hash(struct aws_allocator *allocator, enum crt_digest_algorithm algorithm) {
+    switch (algorithm) {
+        case CRT_DIGEST_SHA1:
+            return aws_sha1_new(allocator);
+        case CRT_DIGEST_SHA256:
+            return aws_sha256_new(allocator);
+        default:
+            aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+            return NULL;
+    }
+}
+
+JNIEXPORT jlong JNICALL
+    Java_software_amazon_awssdk_crt_checksums_CrtDigest_digestNew(JNIEnv *env, jclass jni_class, jint algorithm) {
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_hash *hash = s_crt_digest_new_hash(allocator, (enum crt_digest_algorithm)algorithm);
+    if (hash == NULL) {
+        aws_jni_throw_runtime_exception(env, "CrtDigest: failed to create hash");
+        return (jlong)0;
+    }
+
+    struct crt_digest *digest = aws_mem_calloc(allocator, 1, sizeof(struct crt_digest));
+    digest->allocator = allocator;
+    digest->algorithm = (enum crt_digest_algorithm)algorithm;
+    digest->hash = hash;
+    return (jlong)digest;
+}
+
+JNIEXPORT void JNICALL
+    Java_software_amazon_awssdk_crt_checksums_CrtDigest_digestDestroy(JNIEnv *env, jclass jni_class, jlong handle) {
+    (void)env;
+    (void)jni_class;
+
+    struct crt_digest *digest = (struct crt_digest *)handle;
+    if (digest == NULL) {
+        return;
+    }
+    aws_hash_destroy(digest->hash);
+    aws_mem_release(digest->allocator, digest);
+}
+
+static void s_crt_digest_update(JNIEnv *env, struct crt_digest *digest, struct aws_byte_cursor cursor) {
+    if (aws_hash_update(digest->hash, &cursor)) {
+        aws_jni_throw_runtime_exception(env, "CrtDigest: update failed");
+    }
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_checksums_CrtDigest_digestUpdate(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong handle,
+    jbyteArray input,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+
+    struct crt_digest *digest = (struct crt_digest *)handle;
+    struct aws_byte_cursor c_byte_array = aws_jni_byte_cursor_from_jbyteArray_acquire(env, input);
+    struct aws_byte_cursor cursor = c_byte_array;
+    aws_byte_cursor_advance(&cursor, (size_t)offset);
+    cursor.len = aws_min_size((size_t)length, cursor.len);
+    s_crt_digest_update(env, digest, cursor);
+    aws_jni_byte_cursor_from_jbyteArray_release(env, input, c_byte_array);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_checksums_CrtDigest_digestUpdateDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong handle,
+    jobject input,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+
+    struct crt_digest *digest = (struct crt_digest *)handle;
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, input);
+    if (address == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "ByteBuffer is not a direct buffer");
+        return;
+    }
+    s_crt_digest_update(env, digest, aws_byte_cursor_from_array(address + offset, (size_t)length));
+}
+
+JNIEXPORT jbyteArray JNICALL
+    Java_software_amazon_awssdk_crt_checksums_CrtDigest_digestFinish(JNIEnv *env, jclass jni_class, jlong handle) {
+    (void)jni_class;
+
+    struct crt_digest *digest = (struct crt_digest *)handle;
+    struct aws_hash *next_hash = s_crt_digest_new_hash(digest->allocator, digest->algorithm);
+    if (next_hash == NULL) {
+        aws_jni_throw_runtime_exception(env, "CrtDigest: failed to create hash");
+        return NULL;
+    }
+
+    uint8_t output[AWS_SHA256_LEN];
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, sizeof(output));
+    int result = aws_hash_finalize(digest->hash, &output_buf, 0);
+
+    aws_hash_destroy(digest->hash);
+    digest->hash = next_hash;
+
+    if (result) {
+        aws_jni_throw_runtime_exception(env, "CrtDigest: finalize failed");
+        return NULL;
+    }
+
+    struct aws_byte_cursor output_cursor = aws_byte_cursor_from_buf(&output_buf);
+    return aws_jni_byte_array_from_cursor(env, &output_cursor);
+}
+
+JNIEXPORT void JNICALL
+    Java_software_amazon_awssdk_crt_checksums_CrtDigest_digestReset(JNIEnv *env, jclass jni_class, jlong handle) {
+    (void)jni_class;
+
+    struct crt_digest *digest = (struct crt_digest *)handle;
+    struct aws_hash *next_hash = s_crt_digest_new_hash(digest->allocator, digest->algorithm);
+    if (next_hash == NULL) {
+        aws_jni_throw_runtime_exception(env, "CrtDigest: failed to create hash");
+        return;
+    }
+    aws_hash_destroy(digest->hash);
+    digest->hash = next_hash;
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
@@ -5,7 +5,10 @@
 
 #include <jni.h>
 
+#include <aws/common/array_list.h>
+#include <aws/common/string.h>
 #include <aws/io/channel_bootstrap.h>
+#include <aws/io/host_resolver.h>
 
 #include "crt.h"
 #include "java_class_ids.h"
@@ -144,6 +147,168 @@ void JNICALL Java_software_amazon_awssdk_crt_io_ClientBootstrap_clientBootstrapD
     aws_client_bootstrap_release(bootstrap);
 }
 
+/*
+ * The default resolver hands out one address per record type on each resolve, rotating through its cache, so every
+ * address for a host is collected by resolving repeatedly until the cache has nothing new to give.
+ */
+struct host_resolution_binding {
+    JavaVM *jvm;
+    jobject java_resolve_future;
+    struct aws_client_bootstrap *bootstrap;
+    struct aws_string *host_name;
+    /* struct aws_string * */
+    struct aws_array_list addresses;
+    size_t attempts;
+};
+
+static void s_host_resolution_binding_destroy(JNIEnv *env, struct host_resolution_binding *binding) {
+    if (binding->java_resolve_future != NULL) {
+        (*env)->DeleteGlobalRef(env, binding->java_resolve_future);
+    }
+
+    for (size_t i = 0; i < aws_array_list_length(&binding->addresses); ++i) {
+        struct aws_string *address = NULL;
+        aws_array_list_get_at(&binding->addresses, &address, i);
+        aws_string_destroy(address);
+    }
+    aws_array_list_clean_up(&binding->addresses);
+    aws_string_destroy(binding->host_name);
+    aws_client_bootstrap_release(binding->bootstrap);
+
+    aws_mem_release(aws_jni_get_allocator(), binding);
+}
+
+static void s_complete_host_resolution(struct host_resolution_binding *binding, int error_code) {
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    size_t address_count = aws_array_list_length(&binding->addresses);
+    jobjectArray java_addresses =
+        (*env)->NewObjectArray(env, (jsize)address_count, client_bootstrap_properties.string_class, NULL);
+    AWS_FATAL_ASSERT(java_addresses);
+    for (size_t i = 0; i < address_count; ++i) {
+        struct aws_string *address = NULL;
+        aws_array_list_get_at(&binding->addresses, &address, i);
+        jstring java_address = aws_jni_string_from_string(env, address);
+        (*env)->SetObjectArrayElement(env, java_addresses, (jsize)i, java_address);
+        (*env)->DeleteLocalRef(env, java_address);
+    }
+
+    (*env)->CallStaticVoidMethod(
+        env,
+        client_bootstrap_properties.client_bootstrap_class,
+        client_bootstrap_properties.onHostResolved,
+        binding->java_resolve_future,
+        java_addresses,
+        (jint)error_code);
+    AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+    (*env)->DeleteLocalRef(env, java_addresses);
+
+    JavaVM *jvm = binding->jvm;
+    s_host_resolution_binding_destroy(env, binding);
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+static bool s_has_address(const struct aws_array_list *addresses, const struct aws_string *address) {
+    for (size_t i = 0; i < aws_array_list_length(addresses); ++i) {
+        struct aws_string *known = NULL;
+        aws_array_list_get_at(addresses, &known, i);
+        if (aws_string_eq(known, address)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void s_on_host_resolved(
+    struct aws_host_resolver *resolver,
+    const struct aws_string *host_name,
+    int err_code,
+    const struct aws_array_list *host_addresses,
+    void *user_data) {
+
+    struct host_resolution_binding *binding = user_data;
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+
+    if (!err_code) {
+        for (size_t i = 0; i < aws_array_list_length(host_addresses); ++i) {
+            struct aws_host_address *host_address = NULL;
+            aws_array_list_get_at_ptr(host_addresses, (void **)&host_address, i);
+            if (!s_has_address(&binding->addresses, host_address->address)) {
+                struct aws_string *address = aws_string_new_from_string(allocator, host_address->address);
+                aws_array_list_push_back(&binding->addresses, &address);
+            }
+        }
+
+        size_t known_addresses = aws_host_resolver_get_host_address_count(
+            resolver,
+            host_name,
+            AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A | AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA);
+
+        /* Each resolve yields at least one address, so twice the cache size is plenty even with rotation races */
+        if (aws_array_list_length(&binding->addresses) < known_addresses && ++binding->attempts < known_addresses * 2) {
+            if (aws_host_resolver_resolve_host(
+                    resolver, host_name, s_on_host_resolved, &binding->bootstrap->host_resolver_config, binding) ==
+                AWS_OP_SUCCESS) {
+                return;
+            }
+        }
+    } else if (aws_array_list_length(&binding->addresses) > 0) {
+        /* A later round failed, report what was already collected */
+        err_code = AWS_ERROR_SUCCESS;
+    }
+
+    s_complete_host_resolution(binding, err_code);
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_io_ClientBootstrap_clientBootstrapResolveHost(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_bootstrap,
+    jbyteArray jni_host_name,
+    jobject jni_resolve_future) {
+    (void)jni_class;
+    struct aws_client_bootstrap *bootstrap = (struct aws_client_bootstrap *)jni_bootstrap;
+    if (!bootstrap) {
+        aws_jni_throw_runtime_exception(env, "ClientBootstrap.resolveHost: Invalid ClientBootstrap");
+        return;
+    }
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct host_resolution_binding *binding = aws_mem_calloc(allocator, 1, sizeof(struct host_resolution_binding));
+    AWS_FATAL_ASSERT(binding);
+
+    jint jvmresult = (*env)->GetJavaVM(env, &binding->jvm);
+    (void)jvmresult;
+    AWS_FATAL_ASSERT(jvmresult == 0);
+
+    binding->java_resolve_future = (*env)->NewGlobalRef(env, jni_resolve_future);
+    AWS_FATAL_ASSERT(binding->java_resolve_future);
+    binding->bootstrap = aws_client_bootstrap_acquire(bootstrap);
+    AWS_FATAL_ASSERT(!aws_array_list_init_dynamic(&binding->addresses, allocator, 4, sizeof(struct aws_string *)));
+
+    struct aws_byte_cursor host_name = aws_jni_byte_cursor_from_jbyteArray_acquire(env, jni_host_name);
+    binding->host_name = aws_string_new_from_cursor(allocator, &host_name);
+    aws_jni_byte_cursor_from_jbyteArray_release(env, jni_host_name, host_name);
+
+    if (aws_host_resolver_resolve_host(
+            bootstrap->host_resolver,
+            binding->host_name,
+            s_on_host_resolved,
+            &bootstrap->host_resolver_config,
+            binding)) {
+        aws_jni_throw_runtime_exception(
+            env, "ClientBootstrap.resolveHost: Failed to start resolution: %s", aws_error_str(aws_last_error()));
+        s_host_resolution_binding_destroy(env, binding);
+    }
+}
+
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
 #        pragma warning(pop)
@@ -49,6 +49,14 @@ struct aws_allocator *aws_jni_get_allocator() {
     return s_allocator;
 }
 
+struct aws_jni_thread_env_cache {
+    JavaVM *jvm;
+    JNIEnv *env;
+    size_t generation;
+};
+
+static AWS_THREAD_LOCAL struct aws_jni_thread_env_cache tl_env_cache;
+
 static void s_detach_jvm_from_thread(void *user_data) {
     AWS_LOGF_DEBUG(AWS_LS_COMMON_GENERAL, "s_detach_jvm_from_thread invoked");
     JavaVM *jvm = user_data;
@@ -62,6 +70,9 @@ static void s_detach_jvm_from_thread(void *user_data) {
         aws_jni_release_thread_env(jvm, env);
         /********** JNI ENV RELEASE **********/
     }
+
+    /* the cached env died with the detach */
+    AWS_ZERO_STRUCT(tl_env_cache);
 }
 
 static JNIEnv *s_aws_jni_get_thread_env(JavaVM *jvm) {
@@ -117,10 +128,27 @@ instead, we just have to be careful with acquire/release.
 
 In this way, the vast majority of usage is relatively contentionless; it's just a bunch of native threads taking
 read locks on a shared rw lock.  Only when the JVM shutdown hook calls into native is there read-write contention.
+
+Since acquiring a JNIEnv happens on every single upcall (every body chunk, every publish, every progress event), even
+the uncontended read lock, hash lookup and GetEnv add up.  So on top of the locked path there's a thread-local fast
+path:
+
+Every change to the JVM table bumps a global generation counter.  The first (locked) acquire on a thread caches the
+JavaVM, its JNIEnv and the generation it was validated at in thread-local storage.  Later acquires on that thread for
+the same JVM only have to check that the generation hasn't moved.  Instead of holding the read lock for the duration
+of its use, every acquired JNIEnv (fast or locked path) is counted in a global in-flight counter, so release is
+always just a decrement.  The fast path increments the counter *before* re-checking the generation, and removal bumps
+the generation *before* waiting for the counter to drain, so a removal can never miss an env that is still in use.
+Only shutdown transitions (a generation change) send a thread back through the locked path.
  */
 static struct aws_rw_lock s_jvm_table_lock = AWS_RW_LOCK_INIT;
 static struct aws_hash_table *s_jvms = NULL;
 
+static struct aws_atomic_var s_jvm_table_generation = AWS_ATOMIC_INIT_INT(0);
+static struct aws_atomic_var s_acquired_env_count = AWS_ATOMIC_INIT_INT(0);
+
+#define JVM_TABLE_DRAIN_SLEEP_NS 1000000
+
 static void s_jvm_table_add_jvm_for_env(JNIEnv *env) {
     aws_rw_lock_wlock(&s_jvm_table_lock);
 
@@ -140,6 +168,8 @@ static void s_jvm_table_add_jvm_for_env(JNIEnv *env) {
     AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_hash_table_put(s_jvms, jvm, NULL, &was_created));
     AWS_FATAL_ASSERT(was_created == 1);
 
+    aws_atomic_fetch_add(&s_jvm_table_generation, 1);
+
     aws_rw_lock_wunlock(&s_jvm_table_lock);
 }
 
@@ -162,12 +192,33 @@ static void s_jvm_table_remove_jvm_for_env(JNIEnv *env) {
         s_jvms = NULL;
     }
 
+    /* invalidates every thread's cached env, no new acquires can succeed against the removed JVM after this */
+    aws_atomic_fetch_add(&s_jvm_table_generation, 1);
+
 done:
 
     aws_rw_lock_wunlock(&s_jvm_table_lock);
+
+    /* wait for any env acquired before the generation change to be released */
+    while (aws_atomic_load_int(&s_acquired_env_count) > 0) {
+        aws_thread_current_sleep(JVM_TABLE_DRAIN_SLEEP_NS);
+    }
 }
 
 JNIEnv *aws_jni_acquire_thread_env(JavaVM *jvm) {
+    struct aws_jni_thread_env_cache *cache = &tl_env_cache;
+    if (AWS_LIKELY(cache->jvm == jvm && cache->env != NULL)) {
+        if (cache->generation == aws_atomic_load_int(&s_jvm_table_generation)) {
+            aws_atomic_fetch_add(&s_acquired_env_count, 1);
+            /* re-check now that we're counted, a removal may have started in between */
+            if (AWS_LIKELY(cache->generation == aws_atomic_load_int(&s_jvm_table_generation))) {
+                return cache->env;
+            }
+            aws_atomic_fetch_sub(&s_acquired_env_count, 1);
+        }
+        AWS_ZERO_STRUCT(*cache);
+    }
+
     /*
      * We use try-lock here in order to avoid the re-entrant deadlock case that could happen if we have a read
      * lock already, the JVM shutdown hooks causes another thread to block on taking the write lock, and then
@@ -199,6 +250,14 @@ JNIEnv *aws_jni_acquire_thread_env(JavaVM *jvm) {
         goto error;
     }
 
+    /* the generation can't change while we hold the read lock */
+    aws_atomic_fetch_add(&s_acquired_env_count, 1);
+    cache->jvm = jvm;
+    cache->env = env;
+    cache->generation = aws_atomic_load_int(&s_jvm_table_generation);
+
+    aws_rw_lock_runlock(&s_jvm_table_lock);
+
     return env;
 
 error:
@@ -210,10 +269,9 @@ error:
 
 void aws_jni_release_thread_env(JavaVM *jvm, JNIEnv *env) {
     (void)jvm;
-    (void)env;
 
     if (env != NULL) {
-        aws_rw_lock_runlock(&s_jvm_table_lock);
+        aws_atomic_fetch_sub(&s_acquired_env_count, 1);
     }
 }
 
@@ -344,6 +402,15 @@ jobject aws_jni_direct_byte_buffer_from_raw_ptr(JNIEnv *env, const void *dst, si
     return jByteBuf;
 }
 
+void aws_jni_byte_buffer_reset(JNIEnv *env, jobject jByteBuf, jint limit) {
+    aws_jni_byte_buffer_set_position(env, jByteBuf, 0);
+    aws_jni_byte_buffer_set_limit(env, jByteBuf, limit);
+    jobject val =
+        (*env)->CallObjectMethod(env, jByteBuf, byte_buffer_properties.set_order, byte_buffer_properties.big_endian);
+    AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+    (*env)->DeleteLocalRef(env, val);
+}
+
 struct aws_byte_cursor aws_jni_byte_cursor_from_jstring_acquire(JNIEnv *env, jstring str) {
     if (str == NULL) {
         aws_jni_throw_null_pointer_exception(env, "string is null");
@@ -114,6 +114,12 @@ void aws_jni_native_byte_buf_from_java_direct_byte_buf(JNIEnv *env, jobject dire
  ******************************************************************************/
 jobject aws_jni_direct_byte_buffer_from_raw_ptr(JNIEnv *env, const void *dst, size_t capacity);
 
+/*******************************************************************************
+ * aws_jni_byte_buffer_reset - Returns a reused ByteBuffer to the state of a new one: position 0, the given
+ * limit and big-endian byte order
+ ******************************************************************************/
+void aws_jni_byte_buffer_reset(JNIEnv *env, jobject jByteBuf, jint limit);
+
 /*******************************************************************************
  * aws_jni_byte_buffer_get_position - Gets the Read/Write Position of a ByteBuffer
  ******************************************************************************/
@@ -178,14 +184,15 @@ struct aws_string *aws_jni_new_string_from_jstring(JNIEnv *env, jstring str);
 /*******************************************************************************
  * aws_jni_acquire_thread_env - Acquires the JNIEnv for the current thread from the VM,
  * attaching the env if necessary.  aws_jni_release_thread_env() must be called once
- * the caller is through with the environment.
+ * the caller is through with the environment.  The env is cached per thread, so after the
+ * first call on a thread this is lock-free until the set of valid JVMs changes.
  ******************************************************************************/
 JNIEnv *aws_jni_acquire_thread_env(JavaVM *jvm);
 
 /*******************************************************************************
  * aws_jni_release_thread_env - Releases an acquired JNIEnv for the current thread.  Every successfully
- * acquired JNIEnv must be released exactly once.  Internally, all this does is release the reader
- * lock on the set of valid JVMs.
+ * acquired JNIEnv must be released exactly once.  Internally, all this does is decrement the count of
+ * in-use JNIEnvs that JVM shutdown waits on.
  ******************************************************************************/
 void aws_jni_release_thread_env(JavaVM *jvm, JNIEnv *env);
 
@@ -7,12 +7,14 @@
 #include "http_connection_manager.h"
 #include "http_request_response.h"
 #include "http_request_utils.h"
+#include "http_stream_metrics.h"
 #include "java_class_ids.h"
 
 #include <jni.h>
 #include <string.h>
 
 #include <aws/common/condition_variable.h>
+#include <aws/common/mutex.h>
 #include <aws/common/string.h>
 
 #include <aws/io/channel_bootstrap.h>
@@ -39,13 +41,46 @@
 #    endif
 #endif
 
+/* Must stay in sync with Http2StreamAssignmentStrategy.java */
+enum aws_http2_stream_assignment_strategy {
+    AWS_HTTP2_STREAM_ASSIGNMENT_DEFAULT,
+    AWS_HTTP2_STREAM_ASSIGNMENT_FILL_FIRST,
+    AWS_HTTP2_STREAM_ASSIGNMENT_ROUND_ROBIN,
+    AWS_HTTP2_STREAM_ASSIGNMENT_LEAST_LOADED_BY_BYTES,
+
+    AWS_HTTP2_STREAM_ASSIGNMENT_STRATEGY_COUNT,
+};
+
+/*
+ * One connection slot. The native stream manager picks connections on its own, so to control placement every
+ * strategy other than DEFAULT gives each slot its own native manager capped at a single connection. DEFAULT keeps a
+ * single slot holding all the connections.
+ */
+struct aws_http2_stream_manager_slot {
+    struct aws_http2_stream_manager *stream_manager;
+    struct aws_http_connection_load *load;
+};
+
 /*
  * Stream manager binding, persists across the lifetime of the native object.
  */
 struct aws_http2_stream_manager_binding {
     JavaVM *jvm;
     jweak java_http2_stream_manager;
-    struct aws_http2_stream_manager *stream_manager;
+    struct aws_http2_stream_manager_slot *slots;
+    size_t slot_count;
+    enum aws_http2_stream_assignment_strategy strategy;
+    size_t ideal_concurrent_streams_per_connection;
+    /* Next slot for ROUND_ROBIN */
+    struct aws_atomic_var next_slot;
+    /* Slots whose native manager hasn't finished shutting down, the last one to finish frees the binding */
+    struct aws_atomic_var slots_shutting_down;
+    /* Set when creation failed part way, Java never saw the native handle so isn't notified of the shutdown */
+    bool creation_failed;
+    struct aws_http_latency_histograms *latency_histograms;
+    size_t body_min_delivery_size;
+    /* Used by tryAcquireStream to tell whether the caller is one of the manager's event loop threads */
+    struct aws_event_loop_group *event_loop_group;
 };
 
 static void s_destroy_manager_binding(struct aws_http2_stream_manager_binding *binding, JNIEnv *env) {
@@ -56,12 +91,25 @@ static void s_destroy_manager_binding(struct aws_http2_stream_manager_binding *b
         (*env)->DeleteWeakGlobalRef(env, binding->java_http2_stream_manager);
     }
 
+    if (binding->slots != NULL) {
+        for (size_t i = 0; i < binding->slot_count; ++i) {
+            aws_http_connection_load_release(binding->slots[i].load);
+        }
+        aws_mem_release(aws_jni_get_allocator(), binding->slots);
+    }
+    aws_http_latency_histograms_release(binding->latency_histograms);
+    aws_event_loop_group_release(binding->event_loop_group);
     aws_mem_release(aws_jni_get_allocator(), binding);
 }
 
 static void s_on_stream_manager_shutdown_complete_callback(void *user_data) {
 
     struct aws_http2_stream_manager_binding *binding = (struct aws_http2_stream_manager_binding *)user_data;
+    if (aws_atomic_fetch_sub(&binding->slots_shutting_down, 1) != 1) {
+        /* Other slots are still shutting down */
+        return;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
     if (env == NULL) {
@@ -72,10 +120,12 @@ static void s_on_stream_manager_shutdown_complete_callback(void *user_data) {
     AWS_LOGF_DEBUG(AWS_LS_HTTP_STREAM_MANAGER, "Java Stream Manager Shutdown Complete");
     jobject java_http2_stream_manager = (*env)->NewLocalRef(env, binding->java_http2_stream_manager);
     if (java_http2_stream_manager != NULL) {
-        (*env)->CallVoidMethod(env, java_http2_stream_manager, http2_stream_manager_properties.onShutdownComplete);
+        if (!binding->creation_failed) {
+            (*env)->CallVoidMethod(env, java_http2_stream_manager, http2_stream_manager_properties.onShutdownComplete);
 
-        /* If exception raised from Java callback, but we already closed the stream manager, just move on */
-        aws_jni_check_and_clear_exception(env);
+            /* If exception raised from Java callback, but we already closed the stream manager, just move on */
+            aws_jni_check_and_clear_exception(env);
+        }
 
         (*env)->DeleteLocalRef(env, java_http2_stream_manager);
     }
@@ -86,6 +136,76 @@ static void s_on_stream_manager_shutdown_complete_callback(void *user_data) {
     /********** JNI ENV RELEASE **********/
 }
 
+/* Releases the native manager of every slot created so far, the binding is freed once they've all shut down */
+static void s_release_manager_slots(struct aws_http2_stream_manager_binding *binding, size_t created_count) {
+    aws_atomic_store_int(&binding->slots_shutting_down, created_count);
+    for (size_t i = 0; i < created_count; ++i) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_HTTP_CONNECTION, "Releasing StreamManager: id: %p", (void *)binding->slots[i].stream_manager);
+        aws_http2_stream_manager_release(binding->slots[i].stream_manager);
+    }
+}
+
+/*
+ * Picks the slot for a new stream. FILL_FIRST packs streams into the lowest slot below the ideal concurrency, so idle
+ * connections can be reaped, and falls back to the least busy slot once every connection is at the ideal.
+ * LEAST_LOADED_BY_BYTES ranks slots by the bytes their streams hold in unacknowledged flow-control window (always 0
+ * without manual window management), then by active or queued streams, and only then by body bytes received, which
+ * keep growing for a stream until it completes rather than measuring what is still outstanding.
+ */
+static struct aws_http2_stream_manager_slot *s_choose_slot(struct aws_http2_stream_manager_binding *binding) {
+    if (binding->slot_count == 1) {
+        return &binding->slots[0];
+    }
+
+    size_t chosen = 0;
+    switch (binding->strategy) {
+        case AWS_HTTP2_STREAM_ASSIGNMENT_ROUND_ROBIN:
+            chosen = aws_atomic_fetch_add(&binding->next_slot, 1) % binding->slot_count;
+            break;
+
+        case AWS_HTTP2_STREAM_ASSIGNMENT_LEAST_LOADED_BY_BYTES: {
+            size_t best_window = SIZE_MAX;
+            size_t best_streams = SIZE_MAX;
+            size_t best_bytes = SIZE_MAX;
+            for (size_t i = 0; i < binding->slot_count; ++i) {
+                struct aws_http_connection_load *load = binding->slots[i].load;
+                size_t window = aws_atomic_load_int(&load->unacknowledged_window_bytes);
+                size_t streams = aws_atomic_load_int(&load->active_streams);
+                size_t bytes = aws_atomic_load_int(&load->in_flight_bytes);
+                bool better = window != best_window
+                                  ? window < best_window
+                                  : (streams != best_streams ? streams < best_streams : bytes < best_bytes);
+                if (better) {
+                    best_window = window;
+                    best_streams = streams;
+                    best_bytes = bytes;
+                    chosen = i;
+                }
+            }
+            break;
+        }
+
+        default: {
+            size_t best_streams = SIZE_MAX;
+            for (size_t i = 0; i < binding->slot_count; ++i) {
+                size_t streams = aws_atomic_load_int(&binding->slots[i].load->active_streams);
+                if (streams < binding->ideal_concurrent_streams_per_connection) {
+                    chosen = i;
+                    break;
+                }
+                if (streams < best_streams) {
+                    best_streams = streams;
+                    chosen = i;
+                }
+            }
+            break;
+        }
+    }
+
+    return &binding->slots[chosen];
+}
+
 JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerNew(
     JNIEnv *env,
     jclass jni_class,
@@ -113,7 +233,9 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
     jboolean jni_prior_knowledge,
     jboolean jni_close_connection_on_server_error,
     jint jni_connection_ping_period_ms,
-    jint jni_connection_ping_timeout_ms) {
+    jint jni_connection_ping_timeout_ms,
+    jint jni_body_min_delivery_size,
+    jint jni_stream_assignment_strategy) {
 
     (void)jni_class;
 
@@ -163,6 +285,17 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
         goto cleanup;
     }
 
+    if (jni_body_min_delivery_size < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Response body minimum delivery size must be >= 0");
+        goto cleanup;
+    }
+
+    if (jni_stream_assignment_strategy < 0 ||
+        jni_stream_assignment_strategy >= AWS_HTTP2_STREAM_ASSIGNMENT_STRATEGY_COUNT) {
+        aws_jni_throw_illegal_argument_exception(env, "Unknown stream assignment strategy");
+        goto cleanup;
+    }
+
     uint16_t port = (uint16_t)jni_port;
 
     bool new_tls_conn_opts = (jni_tls_ctx != 0 && !tls_connection_options);
@@ -178,6 +311,19 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
     binding = aws_mem_calloc(allocator, 1, sizeof(struct aws_http2_stream_manager_binding));
     AWS_FATAL_ASSERT(binding);
     binding->java_http2_stream_manager = (*env)->NewWeakGlobalRef(env, stream_manager_jobject);
+    binding->latency_histograms = aws_http_latency_histograms_new(allocator);
+    binding->body_min_delivery_size = (size_t)jni_body_min_delivery_size;
+    binding->event_loop_group = aws_event_loop_group_acquire(client_bootstrap->event_loop_group);
+    binding->strategy = (enum aws_http2_stream_assignment_strategy)jni_stream_assignment_strategy;
+    binding->ideal_concurrent_streams_per_connection = (size_t)jni_ideal_concurrent_streams_per_connection;
+    binding->slot_count = binding->strategy == AWS_HTTP2_STREAM_ASSIGNMENT_DEFAULT ? 1 : (size_t)jni_max_conns;
+    binding->slots = aws_mem_calloc(allocator, binding->slot_count, sizeof(struct aws_http2_stream_manager_slot));
+    AWS_FATAL_ASSERT(binding->slots);
+    for (size_t i = 0; i < binding->slot_count; ++i) {
+        binding->slots[i].load = aws_http_connection_load_new(allocator, jni_manual_window_management);
+    }
+    aws_atomic_init_int(&binding->next_slot, 0);
+    aws_atomic_init_int(&binding->slots_shutting_down, 0);
 
     jint jvmresult = (*env)->GetJavaVM(env, &binding->jvm);
     (void)jvmresult;
@@ -201,7 +347,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
         .connection_ping_timeout_ms = jni_connection_ping_timeout_ms,
         .ideal_concurrent_streams_per_connection = (size_t)jni_ideal_concurrent_streams_per_connection,
         .max_concurrent_streams_per_connection = (size_t)jni_max_concurrent_streams_per_connection,
-        .max_connections = (size_t)jni_max_conns,
+        .max_connections = binding->slot_count == 1 ? (size_t)jni_max_conns : 1,
     };
 
     struct aws_http_connection_monitoring_options monitoring_options;
@@ -237,9 +383,22 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
         manager_options.proxy_options = &proxy_options;
     }
 
-    binding->stream_manager = aws_http2_stream_manager_new(allocator, &manager_options);
-    if (binding->stream_manager == NULL) {
-        aws_jni_throw_runtime_exception(env, "Failed to create stream manager: %s", aws_error_str(aws_last_error()));
+    size_t created_count = 0;
+    for (; created_count < binding->slot_count; ++created_count) {
+        struct aws_http2_stream_manager *stream_manager = aws_http2_stream_manager_new(allocator, &manager_options);
+        if (stream_manager == NULL) {
+            aws_jni_throw_runtime_exception(
+                env, "Failed to create stream manager: %s", aws_error_str(aws_last_error()));
+            break;
+        }
+        binding->slots[created_count].stream_manager = stream_manager;
+    }
+
+    if (created_count < binding->slot_count && created_count > 0) {
+        /* The slots that did start free the binding once they've shut down */
+        binding->creation_failed = true;
+        s_release_manager_slots(binding, created_count);
+        binding = NULL;
     }
 
     aws_http_proxy_options_jni_clean_up(
@@ -252,7 +411,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
 cleanup:
     aws_jni_byte_cursor_from_jbyteArray_release(env, jni_endpoint, endpoint);
 
-    if (binding->stream_manager == NULL) {
+    if (binding != NULL && binding->slots[binding->slot_count - 1].stream_manager == NULL) {
         s_destroy_manager_binding(binding, env);
         binding = NULL;
     }
@@ -261,14 +420,43 @@ cleanup:
 }
 
 /*
- * Stream manager binding, persists across the lifetime of the native object.
+ * Hand-off between tryAcquireStream and s_on_stream_acquired. The Java stream object is created before the
+ * acquisition starts, so the callback only attaches the native stream and never waits on the calling thread. While
+ * the caller is still waiting, the callback records the result and leaves completing the acquisition to the caller.
+ * If the caller gives up first it clears caller_waiting and the callback completes the acquisition as usual.
+ */
+struct aws_sm_inline_acquire {
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+    bool caller_waiting;
+    bool completed;
+    int error_code;
+};
+
+/* How long tryAcquireStream waits for a stream manager with available concurrency to hand over the stream */
+#define AWS_SM_INLINE_ACQUIRE_TIMEOUT_NS (1000 * 1000)
+
+/*
+ * Per-acquisition state, persists until the stream is handed over or the acquisition fails.
  */
 struct aws_sm_acquire_stream_callback_data {
     JavaVM *jvm;
     struct http_stream_binding *stream_binding;
     jobject java_async_callback;
+    uint64_t acquire_start_ns;
+    /* NULL unless this acquisition came from tryAcquireStream */
+    struct aws_sm_inline_acquire *inline_acquire;
 };
 
+static void s_destroy_sm_inline_acquire(struct aws_sm_inline_acquire *inline_acquire) {
+    if (inline_acquire == NULL) {
+        return;
+    }
+    aws_condition_variable_clean_up(&inline_acquire->signal);
+    aws_mutex_clean_up(&inline_acquire->lock);
+    aws_mem_release(aws_jni_get_allocator(), inline_acquire);
+}
+
 static void s_cleanup_sm_acquire_stream_callback_data(
     struct aws_sm_acquire_stream_callback_data *callback_data,
     JNIEnv *env) {
@@ -276,6 +464,7 @@ static void s_cleanup_sm_acquire_stream_callback_data(
     if (callback_data->java_async_callback) {
         (*env)->DeleteGlobalRef(env, callback_data->java_async_callback);
     }
+    s_destroy_sm_inline_acquire(callback_data->inline_acquire);
     aws_mem_release(aws_jni_get_allocator(), callback_data);
 }
 
@@ -292,70 +481,156 @@ static struct aws_sm_acquire_stream_callback_data *s_new_sm_acquire_stream_callb
     callback_data->java_async_callback = async_callback ? (*env)->NewGlobalRef(env, async_callback) : NULL;
     AWS_FATAL_ASSERT(callback_data->java_async_callback != NULL);
     callback_data->stream_binding = stream_binding;
+    callback_data->acquire_start_ns = aws_http_jni_timestamp_ns();
 
     return callback_data;
 }
 
-static void s_on_stream_acquired(struct aws_http_stream *stream, int error_code, void *user_data) {
-    struct aws_sm_acquire_stream_callback_data *callback_data = user_data;
-    /********** JNI ENV ACQUIRE **********/
-    JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
-    if (env == NULL) {
-        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
-        return;
+/*
+ * Attaches an acquired stream to its binding. Runs on the stream's event loop before it can deliver any response
+ * callback.
+ */
+static void s_attach_acquired_stream(
+    struct aws_sm_acquire_stream_callback_data *callback_data,
+    struct aws_http_stream *stream) {
+    struct http_stream_binding *stream_binding = callback_data->stream_binding;
+
+    /* Acquire for the native stream. The destroy callback for native stream will release the ref. */
+    aws_http_stream_binding_acquire(stream_binding);
+
+    /* The stream manager activates the stream itself before handing it over */
+    stream_binding->activate_ns = aws_http_jni_timestamp_ns();
+    stream_binding->acquire_wait_ns =
+        aws_http_jni_elapsed_ns(callback_data->acquire_start_ns, stream_binding->activate_ns);
+    if (stream_binding->acquire_wait_ns >= 0) {
+        aws_http_latency_histograms_record(
+            stream_binding->latency_histograms,
+            AWS_HTTP_JNI_LATENCY_ACQUIRE_WAIT,
+            (uint64_t)stream_binding->acquire_wait_ns);
     }
+
+    stream_binding->native_stream = stream;
+}
+
+/* Creates the Java stream object of a binding. Returns NULL on success, or the exception raised creating it. */
+static jthrowable s_new_java_stream(JNIEnv *env, struct http_stream_binding *stream_binding) {
+    jobject j_http_stream = aws_java_http_stream_from_native_new(env, stream_binding, AWS_HTTP_VERSION_2);
+    if (!j_http_stream) {
+        jthrowable crt_exception = (*env)->ExceptionOccurred(env);
+        AWS_ASSERT(crt_exception);
+        (*env)->ExceptionClear(env);
+        /* Release the refcount on binding for the java object that failed to be created. */
+        aws_http_stream_binding_release(env, stream_binding);
+        return crt_exception;
+    }
+
+    stream_binding->java_http_stream_base = (*env)->NewGlobalRef(env, j_http_stream);
+    (*env)->DeleteLocalRef(env, j_http_stream);
+    return NULL;
+}
+
+/* Completes the Java future for an acquisition and frees callback_data */
+static void s_finish_stream_acquisition(
+    JNIEnv *env,
+    struct aws_sm_acquire_stream_callback_data *callback_data,
+    int error_code,
+    jthrowable bind_exception) {
     if (error_code) {
-        AWS_ASSERT(stream == NULL);
         jobject crt_exception = aws_jni_new_crt_exception_from_error_code(env, error_code);
         (*env)->CallVoidMethod(
             env, callback_data->java_async_callback, async_callback_properties.on_failure, crt_exception);
         (*env)->DeleteLocalRef(env, crt_exception);
-        aws_http_stream_binding_release(env, callback_data->stream_binding);
-    } else {
-        /* Acquire for the native stream. The destroy callback for native stream will release the ref. */
-        aws_http_stream_binding_acquire(callback_data->stream_binding);
-
-        callback_data->stream_binding->native_stream = stream;
-        jobject j_http_stream =
-            aws_java_http_stream_from_native_new(env, callback_data->stream_binding, AWS_HTTP_VERSION_2);
-        if (!j_http_stream) {
-            jthrowable crt_exception = (*env)->ExceptionOccurred(env);
-            AWS_ASSERT(crt_exception);
+        aws_http_stream_binding_finish_connection_load(callback_data->stream_binding);
+        if (callback_data->stream_binding->java_http_stream_base != NULL) {
+            /* Created up front by tryAcquireStream, closing it releases its reference on the binding */
             (*env)->CallVoidMethod(
-                env, callback_data->java_async_callback, async_callback_properties.on_failure, crt_exception);
-            (*env)->DeleteLocalRef(env, crt_exception);
-            (*env)->ExceptionClear(env);
-            /* Release the refcount on binding for the java object that failed to be created. */
-            aws_http_stream_binding_release(env, callback_data->stream_binding);
+                env, callback_data->stream_binding->java_http_stream_base, crt_resource_properties.close);
         } else {
-            callback_data->stream_binding->java_http_stream_base = (*env)->NewGlobalRef(env, j_http_stream);
-            (*env)->CallVoidMethod(
-                env,
-                callback_data->java_async_callback,
-                async_callback_properties.on_success_with_object,
-                callback_data->stream_binding->java_http_stream_base);
-            (*env)->DeleteLocalRef(env, j_http_stream);
+            aws_http_stream_binding_release(env, callback_data->stream_binding);
         }
+    } else if (bind_exception) {
+        (*env)->CallVoidMethod(
+            env, callback_data->java_async_callback, async_callback_properties.on_failure, bind_exception);
+        (*env)->DeleteLocalRef(env, bind_exception);
+    } else {
+        (*env)->CallVoidMethod(
+            env,
+            callback_data->java_async_callback,
+            async_callback_properties.on_success_with_object,
+            callback_data->stream_binding->java_http_stream_base);
     }
     AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
     s_cleanup_sm_acquire_stream_callback_data(callback_data, env);
+}
+
+static void s_on_stream_acquired(struct aws_http_stream *stream, int error_code, void *user_data) {
+    struct aws_sm_acquire_stream_callback_data *callback_data = user_data;
+
+    if (!error_code) {
+        s_attach_acquired_stream(callback_data, stream);
+    }
+
+    struct aws_sm_inline_acquire *inline_acquire = callback_data->inline_acquire;
+    if (inline_acquire != NULL) {
+        aws_mutex_lock(&inline_acquire->lock);
+        if (inline_acquire->caller_waiting) {
+            /* The calling thread completes the acquisition, don't touch callback_data from here on */
+            inline_acquire->completed = true;
+            inline_acquire->error_code = error_code;
+            aws_condition_variable_notify_one(&inline_acquire->signal);
+            aws_mutex_unlock(&inline_acquire->lock);
+            return;
+        }
+        aws_mutex_unlock(&inline_acquire->lock);
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+    jthrowable bind_exception = NULL;
+    if (!error_code && callback_data->stream_binding->java_http_stream_base == NULL) {
+        bind_exception = s_new_java_stream(env, callback_data->stream_binding);
+    }
+    s_finish_stream_acquisition(env, callback_data, error_code, bind_exception);
     aws_jni_release_thread_env(callback_data->jvm, env);
     /********** JNI ENV RELEASE **********/
 }
 
-JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerAcquireStream(
+static bool s_inline_acquire_completed(void *user_data) {
+    struct aws_sm_inline_acquire *inline_acquire = user_data;
+    return inline_acquire->completed;
+}
+
+static bool s_is_event_loop_thread(struct aws_event_loop_group *event_loop_group) {
+    size_t loop_count = aws_event_loop_group_get_loop_count(event_loop_group);
+    for (size_t i = 0; i < loop_count; ++i) {
+        if (aws_event_loop_thread_is_callers_thread(aws_event_loop_group_get_loop_at(event_loop_group, i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Shared by acquireStream and tryAcquireStream. With try_inline set, and when the manager already has concurrency
+ * available, the Java stream object is created up front and the calling thread waits briefly for the event loop to
+ * attach the stream, then completes the Java future itself, so the future is done by the time the call returns.
+ * Otherwise, or if the wait times out, the future completes from the event loop.
+ */
+static void s_http2_stream_manager_acquire_stream(
     JNIEnv *env,
-    jclass jni_class,
     jlong jni_stream_manager,
     jbyteArray marshalled_request,
     jobject jni_http_request_body_stream,
     jobject jni_http_response_callback_handler,
-    jobject java_async_callback) {
-    (void)jni_class;
+    jobject java_async_callback,
+    bool try_inline) {
     struct aws_http2_stream_manager_binding *sm_binding = (struct aws_http2_stream_manager_binding *)jni_stream_manager;
-    struct aws_http2_stream_manager *stream_manager = sm_binding->stream_manager;
 
-    if (!stream_manager) {
+    if (!sm_binding) {
         aws_jni_throw_illegal_argument_exception(env, "Stream Manager can't be null");
         return;
     }
@@ -383,6 +658,33 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_h
         aws_http_stream_binding_release(env, stream_binding);
         return;
     }
+    stream_binding->latency_histograms = aws_http_latency_histograms_acquire(sm_binding->latency_histograms);
+    stream_binding->body_min_delivery_size = sm_binding->body_min_delivery_size;
+
+    struct aws_http2_stream_manager_slot *slot = s_choose_slot(sm_binding);
+    struct aws_http2_stream_manager *stream_manager = slot->stream_manager;
+
+    bool acquire_inline = false;
+    if (try_inline && !s_is_event_loop_thread(sm_binding->event_loop_group)) {
+        /* Waiting only pays off when a stream slot is free on an existing connection */
+        struct aws_http_manager_metrics metrics;
+        aws_http2_stream_manager_fetch_metrics(stream_manager, &metrics);
+        acquire_inline = metrics.available_concurrency > 0;
+    }
+    if (acquire_inline) {
+        /* Bound before the stream exists, so the event loop can hand it over without waiting on this thread */
+        jobject j_http_stream = aws_java_http_stream_from_native_new(env, stream_binding, AWS_HTTP_VERSION_2);
+        if (j_http_stream == NULL) {
+            /* Exception already thrown */
+            aws_http_stream_binding_release(env, stream_binding);
+            return;
+        }
+        stream_binding->java_http_stream_base = (*env)->NewGlobalRef(env, j_http_stream);
+        (*env)->DeleteLocalRef(env, j_http_stream);
+    }
+
+    stream_binding->connection_load = aws_http_connection_load_acquire(slot->load);
+    aws_http_connection_load_stream_started(slot->load);
 
     struct aws_http_make_request_options request_options = {
         .self_size = sizeof(request_options),
@@ -400,13 +702,86 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_h
     struct aws_sm_acquire_stream_callback_data *callback_data =
         s_new_sm_acquire_stream_callback_data(env, allocator, stream_binding, java_async_callback);
 
+    struct aws_sm_inline_acquire *inline_acquire = NULL;
+    if (acquire_inline) {
+        inline_acquire = aws_mem_calloc(allocator, 1, sizeof(struct aws_sm_inline_acquire));
+        AWS_FATAL_ASSERT(inline_acquire);
+        aws_mutex_init(&inline_acquire->lock);
+        aws_condition_variable_init(&inline_acquire->signal);
+        inline_acquire->caller_waiting = true;
+        callback_data->inline_acquire = inline_acquire;
+    }
+
     struct aws_http2_stream_manager_acquire_stream_options acquire_options = {
         .options = &request_options,
         .callback = s_on_stream_acquired,
         .user_data = callback_data,
     };
 
-    aws_http2_stream_manager_acquire_stream(sm_binding->stream_manager, &acquire_options);
+    aws_http2_stream_manager_acquire_stream(stream_manager, &acquire_options);
+
+    if (inline_acquire == NULL) {
+        return;
+    }
+
+    aws_mutex_lock(&inline_acquire->lock);
+    aws_condition_variable_wait_for_pred(
+        &inline_acquire->signal,
+        &inline_acquire->lock,
+        AWS_SM_INLINE_ACQUIRE_TIMEOUT_NS,
+        s_inline_acquire_completed,
+        inline_acquire);
+    bool completed = inline_acquire->completed;
+    /* From here on the callback owns callback_data if it hasn't fired yet */
+    inline_acquire->caller_waiting = false;
+    aws_mutex_unlock(&inline_acquire->lock);
+
+    if (!completed) {
+        return;
+    }
+
+    /* Frees inline_acquire along with callback_data */
+    s_finish_stream_acquisition(env, callback_data, inline_acquire->error_code, NULL);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerAcquireStream(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream_manager,
+    jbyteArray marshalled_request,
+    jobject jni_http_request_body_stream,
+    jobject jni_http_response_callback_handler,
+    jobject java_async_callback) {
+    (void)jni_class;
+
+    s_http2_stream_manager_acquire_stream(
+        env,
+        jni_stream_manager,
+        marshalled_request,
+        jni_http_request_body_stream,
+        jni_http_response_callback_handler,
+        java_async_callback,
+        false);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerTryAcquireStream(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream_manager,
+    jbyteArray marshalled_request,
+    jobject jni_http_request_body_stream,
+    jobject jni_http_response_callback_handler,
+    jobject java_async_callback) {
+    (void)jni_class;
+
+    s_http2_stream_manager_acquire_stream(
+        env,
+        jni_stream_manager,
+        marshalled_request,
+        jni_http_request_body_stream,
+        jni_http_response_callback_handler,
+        java_async_callback,
+        true);
 }
 
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerRelease(
@@ -416,15 +791,13 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_h
     (void)jni_class;
 
     struct aws_http2_stream_manager_binding *sm_binding = (struct aws_http2_stream_manager_binding *)jni_stream_manager;
-    struct aws_http2_stream_manager *stream_manager = sm_binding->stream_manager;
 
-    if (!stream_manager) {
+    if (!sm_binding) {
         aws_jni_throw_runtime_exception(env, "Stream Manager can't be null");
         return;
     }
 
-    AWS_LOGF_DEBUG(AWS_LS_HTTP_CONNECTION, "Releasing StreamManager: id: %p", (void *)stream_manager);
-    aws_http2_stream_manager_release(stream_manager);
+    s_release_manager_slots(sm_binding, sm_binding->slot_count);
 }
 
 JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerFetchMetrics(
@@ -434,15 +807,21 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManage
     (void)jni_class;
 
     struct aws_http2_stream_manager_binding *sm_binding = (struct aws_http2_stream_manager_binding *)jni_stream_manager;
-    struct aws_http2_stream_manager *stream_manager = sm_binding->stream_manager;
 
-    if (!stream_manager) {
+    if (!sm_binding) {
         aws_jni_throw_runtime_exception(env, "Stream Manager can't be null");
         return NULL;
     }
 
     struct aws_http_manager_metrics metrics;
-    aws_http2_stream_manager_fetch_metrics(stream_manager, &metrics);
+    AWS_ZERO_STRUCT(metrics);
+    for (size_t i = 0; i < sm_binding->slot_count; ++i) {
+        struct aws_http_manager_metrics slot_metrics;
+        aws_http2_stream_manager_fetch_metrics(sm_binding->slots[i].stream_manager, &slot_metrics);
+        metrics.available_concurrency += slot_metrics.available_concurrency;
+        metrics.pending_concurrency_acquires += slot_metrics.pending_concurrency_acquires;
+        metrics.leased_concurrency += slot_metrics.leased_concurrency;
+    }
 
     return (*env)->NewObject(
         env,
@@ -450,5 +829,62 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManage
         http_manager_metrics_properties.constructor_method_id,
         (jlong)metrics.available_concurrency,
         (jlong)metrics.pending_concurrency_acquires,
-        (jlong)metrics.leased_concurrency);
+        (jlong)metrics.leased_concurrency,
+        (jlong)0,
+        (jlong)0);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerFetchLatencyHistograms(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream_manager,
+    jlongArray java_buckets) {
+    (void)jni_class;
+
+    struct aws_http2_stream_manager_binding *sm_binding = (struct aws_http2_stream_manager_binding *)jni_stream_manager;
+
+    if (!sm_binding) {
+        aws_jni_throw_runtime_exception(env, "Stream Manager can't be null");
+        return;
+    }
+
+    aws_http_latency_histograms_fetch(env, sm_binding->latency_histograms, java_buckets);
+}
+
+/* Must stay in sync with HttpConnectionLoad.java */
+#define AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT 3
+
+/*
+ * Copies the load of every connection slot into a Java long[], AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT entries per
+ * slot: active streams, in-flight bytes, unacknowledged window bytes. Returns the number of slots written, which is
+ * limited by the array length.
+ */
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_http2StreamManagerFetchConnectionLoads(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream_manager,
+    jlongArray java_loads) {
+    (void)jni_class;
+
+    struct aws_http2_stream_manager_binding *sm_binding = (struct aws_http2_stream_manager_binding *)jni_stream_manager;
+
+    if (!sm_binding) {
+        aws_jni_throw_runtime_exception(env, "Stream Manager can't be null");
+        return 0;
+    }
+
+    jsize capacity = (*env)->GetArrayLength(env, java_loads) / AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT;
+    jsize slot_count = (jsize)sm_binding->slot_count < capacity ? (jsize)sm_binding->slot_count : capacity;
+    for (jsize i = 0; i < slot_count; ++i) {
+        struct aws_http_connection_load *load = sm_binding->slots[i].load;
+        jlong fields[AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT] = {
+            (jlong)aws_atomic_load_int(&load->active_streams),
+            (jlong)aws_atomic_load_int(&load->in_flight_bytes),
+            (jlong)aws_atomic_load_int(&load->unacknowledged_window_bytes),
+        };
+        (*env)->SetLongArrayRegion(
+            env, java_loads, i * AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT, AWS_HTTP2_CONNECTION_LOAD_FIELD_COUNT, fields);
+    }
+
+    return slot_count;
 }
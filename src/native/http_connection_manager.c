@@ -9,8 +9,16 @@
 #include <jni.h>
 #include <string.h>
 
+#include <aws/common/array_list.h>
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
 #include <aws/common/condition_variable.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
 #include <aws/common/string.h>
+#include <aws/common/task_scheduler.h>
 
 #include <aws/io/channel_bootstrap.h>
 #include <aws/io/event_loop.h>
@@ -24,6 +32,7 @@
 #include <aws/http/proxy.h>
 
 #include "http_connection_manager.h"
+#include "http_stream_metrics.h"
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
@@ -37,6 +46,93 @@
 #    endif
 #endif
 
+/* How often the pool is topped back up to its minimum number of idle connections when adaptive sizing is off */
+#define AWS_HTTP_JNI_MIN_IDLE_CHECK_PERIOD_MS 1000
+
+/*
+ * Adaptive pool sizing, see HttpAdaptivePoolSizingOptions.java. The native manager's max_connections is fixed when
+ * it is created, so the binding enforces a lower limit of its own: acquisitions beyond the limit wait in
+ * pending_acquisitions until a connection is released or the limit grows. Everything below the configuration is
+ * guarded by the pool state lock.
+ */
+struct http_connection_pool_sizing {
+    bool enabled;
+    size_t min_connections;
+    uint64_t target_acquire_wait_ns;
+    uint64_t min_throughput_bytes_per_second;
+
+    size_t limit;
+    /* Acquisitions counted against the limit, from being handed to the native manager until the connection is
+     * released */
+    size_t outstanding;
+    size_t peak_outstanding;
+    struct aws_linked_list pending_acquisitions;
+    size_t pending_count;
+
+    /* Samples since the last adjustment */
+    uint64_t acquire_wait_total_ns;
+    size_t acquire_count;
+    uint64_t last_adjustment_ns;
+    uint64_t last_body_bytes;
+};
+
+/*
+ * Pool state layered on top of the native manager: warm-up, minimum idle connections and adaptive sizing. Shared by
+ * the manager binding, the maintenance task, in-flight warm-ups and connection bindings, any of which can outlive the
+ * others.
+ */
+struct http_connection_manager_pool_state {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    struct aws_http_connection_manager *manager;
+    struct aws_http_latency_histograms *latency_histograms;
+    size_t max_connections;
+    size_t min_idle_connections;
+    struct aws_event_loop_group *event_loop_group;
+    struct aws_event_loop *maintenance_loop;
+    struct aws_task maintenance_task;
+    uint64_t maintenance_period_ns;
+    /* Warm-up acquisitions the native manager hasn't completed yet, mostly connections still being established */
+    struct aws_atomic_var warm_up_acquisitions_in_flight;
+
+    /*
+     * Guards released, manager_users and sizing. Once the Java object has released the manager no new native
+     * acquisitions may start, and the native manager is released when the last user started before that ends.
+     */
+    struct aws_mutex lock;
+    bool released;
+    size_t manager_users;
+    bool manager_released;
+    struct http_connection_pool_sizing sizing;
+
+    /*
+     * Guards warm_connections and warm_connections_closed. The native manager hands idle connections out before
+     * opening new ones, so a warm-up acquires the idle connections along with the new ones and keeps all of them here
+     * rather than in the manager. Acquisitions take a warm connection before asking the manager, so holding them never
+     * keeps a connection from a request. Once the Java object has released the manager nothing more is kept.
+     */
+    struct aws_mutex warm_connections_lock;
+    struct aws_array_list warm_connections;
+    bool warm_connections_closed;
+};
+
+/*
+ * One batch of warm-up acquisitions: the connections that were idle when it started, plus the new connections it
+ * opens. Each connection is kept as a warm connection as soon as it is acquired.
+ */
+struct http_connection_warm_up {
+    struct http_connection_manager_pool_state *pool_state;
+    JavaVM *jvm;
+    /* NULL for background warm-ups */
+    jobject java_warm_up_future;
+    size_t requested;
+    size_t acquisitions;
+    /* Warm connections held when the warm-up started */
+    size_t already_warm;
+    struct aws_atomic_var completed;
+    struct aws_atomic_var connections_kept;
+};
+
 /*
  * Connection manager binding, persists across the lifetime of the native object.
  */
@@ -44,8 +140,589 @@ struct http_connection_manager_binding {
     JavaVM *jvm;
     jweak java_http_conn_manager;
     struct aws_http_connection_manager *manager;
+    struct aws_http_latency_histograms *latency_histograms;
+    size_t body_min_delivery_size;
+    struct http_connection_manager_pool_state *pool_state;
 };
 
+static void s_on_http_conn_acquisition_callback(
+    struct aws_http_connection *connection,
+    int error_code,
+    void *user_data);
+
+static void s_destroy_pool_state(void *user_data) {
+    struct http_connection_manager_pool_state *pool_state = user_data;
+
+    AWS_ASSERT(aws_array_list_length(&pool_state->warm_connections) == 0);
+    aws_array_list_clean_up(&pool_state->warm_connections);
+    aws_mutex_clean_up(&pool_state->warm_connections_lock);
+    aws_mutex_clean_up(&pool_state->lock);
+    aws_event_loop_group_release(pool_state->event_loop_group);
+    aws_http_latency_histograms_release(pool_state->latency_histograms);
+    aws_mem_release(pool_state->allocator, pool_state);
+}
+
+static struct http_connection_manager_pool_state *s_pool_state_new(
+    struct aws_allocator *allocator,
+    struct aws_client_bootstrap *client_bootstrap,
+    struct aws_http_latency_histograms *latency_histograms,
+    size_t max_connections,
+    size_t min_idle_connections) {
+
+    struct http_connection_manager_pool_state *pool_state =
+        aws_mem_calloc(allocator, 1, sizeof(struct http_connection_manager_pool_state));
+    AWS_FATAL_ASSERT(pool_state);
+
+    pool_state->allocator = allocator;
+    aws_ref_count_init(&pool_state->ref_count, pool_state, s_destroy_pool_state);
+    pool_state->latency_histograms = aws_http_latency_histograms_acquire(latency_histograms);
+    pool_state->max_connections = max_connections;
+    pool_state->min_idle_connections = min_idle_connections;
+    pool_state->event_loop_group = aws_event_loop_group_acquire(client_bootstrap->event_loop_group);
+    pool_state->maintenance_period_ns = aws_timestamp_convert(
+        AWS_HTTP_JNI_MIN_IDLE_CHECK_PERIOD_MS, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    aws_atomic_init_int(&pool_state->warm_up_acquisitions_in_flight, 0);
+    AWS_FATAL_ASSERT(!aws_mutex_init(&pool_state->lock));
+    AWS_FATAL_ASSERT(!aws_mutex_init(&pool_state->warm_connections_lock));
+    AWS_FATAL_ASSERT(!aws_array_list_init_dynamic(
+        &pool_state->warm_connections, allocator, max_connections, sizeof(struct aws_http_connection *)));
+    aws_linked_list_init(&pool_state->sizing.pending_acquisitions);
+    pool_state->sizing.limit = max_connections;
+
+    return pool_state;
+}
+
+static void s_pool_state_enable_sizing(
+    struct http_connection_manager_pool_state *pool_state,
+    size_t min_connections,
+    uint64_t target_acquire_wait_ms,
+    uint64_t min_throughput_bytes_per_second,
+    uint64_t adjustment_interval_ms) {
+
+    struct http_connection_pool_sizing *sizing = &pool_state->sizing;
+    sizing->enabled = true;
+    sizing->min_connections = min_connections;
+    sizing->limit = min_connections;
+    sizing->target_acquire_wait_ns =
+        aws_timestamp_convert(target_acquire_wait_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    sizing->min_throughput_bytes_per_second = min_throughput_bytes_per_second;
+    sizing->last_adjustment_ns = aws_http_jni_timestamp_ns();
+    pool_state->maintenance_period_ns =
+        aws_timestamp_convert(adjustment_interval_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+}
+
+static struct http_connection_manager_pool_state *s_pool_state_acquire(
+    struct http_connection_manager_pool_state *pool_state) {
+    if (pool_state != NULL) {
+        aws_ref_count_acquire(&pool_state->ref_count);
+    }
+    return pool_state;
+}
+
+static void s_pool_state_release(struct http_connection_manager_pool_state *pool_state) {
+    if (pool_state != NULL) {
+        aws_ref_count_release(&pool_state->ref_count);
+    }
+}
+
+/*
+ * Brackets native acquisitions that aren't made directly on behalf of a Java call: warm-ups, the maintenance task
+ * and acquisitions released from the adaptive sizing queue. Returns false once the Java object has released the
+ * manager.
+ */
+static bool s_pool_state_begin_manager_use(struct http_connection_manager_pool_state *pool_state) {
+    aws_mutex_lock(&pool_state->lock);
+    bool usable = !pool_state->released;
+    if (usable) {
+        ++pool_state->manager_users;
+    }
+    aws_mutex_unlock(&pool_state->lock);
+
+    return usable;
+}
+
+static void s_pool_state_end_manager_use(struct http_connection_manager_pool_state *pool_state) {
+    aws_mutex_lock(&pool_state->lock);
+    AWS_ASSERT(pool_state->manager_users > 0);
+    --pool_state->manager_users;
+    bool release_manager = pool_state->released && pool_state->manager_users == 0 && !pool_state->manager_released;
+    if (release_manager) {
+        pool_state->manager_released = true;
+    }
+    aws_mutex_unlock(&pool_state->lock);
+
+    if (release_manager) {
+        aws_http_connection_manager_release(pool_state->manager);
+    }
+}
+
+/* Connection limit in effect, the pool size unless adaptive sizing is enabled */
+static size_t s_pool_state_connection_limit(struct http_connection_manager_pool_state *pool_state) {
+    aws_mutex_lock(&pool_state->lock);
+    size_t limit = pool_state->sizing.enabled ? pool_state->sizing.limit : pool_state->max_connections;
+    aws_mutex_unlock(&pool_state->lock);
+
+    return limit;
+}
+
+/* Acquisitions queued behind the adaptive connection limit, not yet known to the native manager */
+static size_t s_pool_state_queued_acquisitions(struct http_connection_manager_pool_state *pool_state) {
+    aws_mutex_lock(&pool_state->lock);
+    size_t queued = pool_state->sizing.pending_count;
+    aws_mutex_unlock(&pool_state->lock);
+
+    return queued;
+}
+
+static void s_pool_state_count_acquisition_synced(
+    struct http_connection_manager_pool_state *pool_state,
+    struct aws_http_connection_binding *binding) {
+    struct http_connection_pool_sizing *sizing = &pool_state->sizing;
+
+    binding->counts_against_limit = true;
+    ++sizing->outstanding;
+    sizing->peak_outstanding = aws_max_size(sizing->peak_outstanding, sizing->outstanding);
+}
+
+/*
+ * Returns true if the acquisition may go to the native manager now, false if it was queued until the adaptive
+ * connection limit allows it.
+ */
+static bool s_pool_state_admit_acquisition(
+    struct http_connection_manager_pool_state *pool_state,
+    struct aws_http_connection_binding *binding) {
+    if (!pool_state->sizing.enabled) {
+        return true;
+    }
+
+    struct http_connection_pool_sizing *sizing = &pool_state->sizing;
+    aws_mutex_lock(&pool_state->lock);
+    bool admitted = sizing->outstanding < sizing->limit && sizing->pending_count == 0;
+    if (admitted) {
+        s_pool_state_count_acquisition_synced(pool_state, binding);
+    } else {
+        aws_linked_list_push_back(&sizing->pending_acquisitions, &binding->pending_node);
+        ++sizing->pending_count;
+    }
+    aws_mutex_unlock(&pool_state->lock);
+
+    return admitted;
+}
+
+/* Hands the connections back to the native manager and cleans up the list */
+static void s_pool_state_release_connections(
+    struct http_connection_manager_pool_state *pool_state,
+    struct aws_array_list *connections) {
+    for (size_t i = 0; i < aws_array_list_length(connections); ++i) {
+        struct aws_http_connection *connection = NULL;
+        aws_array_list_get_at(connections, &connection, i);
+        aws_http_connection_manager_release_connection(pool_state->manager, connection);
+    }
+    aws_array_list_clean_up(connections);
+}
+
+/*
+ * Number of warm connections still open. Connections the server closed while warm are handed back to the native
+ * manager, which cleans them up. Releasing a connection can complete other acquisitions, so it happens unlocked.
+ */
+static size_t s_pool_state_count_warm_connections(struct http_connection_manager_pool_state *pool_state) {
+    struct aws_array_list closed_connections;
+    aws_array_list_init_dynamic(&closed_connections, pool_state->allocator, 0, sizeof(struct aws_http_connection *));
+
+    aws_mutex_lock(&pool_state->warm_connections_lock);
+    struct aws_array_list *warm_connections = &pool_state->warm_connections;
+    size_t i = 0;
+    while (i < aws_array_list_length(warm_connections)) {
+        struct aws_http_connection *connection = NULL;
+        aws_array_list_get_at(warm_connections, &connection, i);
+        if (aws_http_connection_is_open(connection)) {
+            ++i;
+            continue;
+        }
+
+        aws_array_list_push_back(&closed_connections, &connection);
+        aws_array_list_back(warm_connections, &connection);
+        aws_array_list_set_at(warm_connections, &connection, i);
+        aws_array_list_pop_back(warm_connections);
+    }
+    size_t count = aws_array_list_length(warm_connections);
+    aws_mutex_unlock(&pool_state->warm_connections_lock);
+
+    s_pool_state_release_connections(pool_state, &closed_connections);
+    return count;
+}
+
+/* Takes an open warm connection for a request, or returns NULL if none is left */
+static struct aws_http_connection *s_pool_state_take_warm_connection(
+    struct http_connection_manager_pool_state *pool_state) {
+    while (true) {
+        struct aws_http_connection *connection = NULL;
+        aws_mutex_lock(&pool_state->warm_connections_lock);
+        if (aws_array_list_length(&pool_state->warm_connections) > 0) {
+            aws_array_list_back(&pool_state->warm_connections, &connection);
+            aws_array_list_pop_back(&pool_state->warm_connections);
+        }
+        aws_mutex_unlock(&pool_state->warm_connections_lock);
+
+        if (connection == NULL || aws_http_connection_is_open(connection)) {
+            return connection;
+        }
+        aws_http_connection_manager_release_connection(pool_state->manager, connection);
+    }
+}
+
+/*
+ * Keeps a connection acquired by warm-up for the next request. It goes straight back to the native manager if it is
+ * already closed, if requests are waiting on the manager, or once the Java object has released the manager.
+ */
+static bool s_pool_state_keep_warm_connection(
+    struct http_connection_manager_pool_state *pool_state,
+    struct aws_http_connection *connection) {
+
+    bool keep = aws_http_connection_is_open(connection);
+    if (keep) {
+        struct aws_http_manager_metrics metrics;
+        aws_http_connection_manager_fetch_metrics(pool_state->manager, &metrics);
+        /* Other warm-up acquisitions are pending too, this one is still counted in flight but no longer pending */
+        size_t in_flight = aws_atomic_load_int(&pool_state->warm_up_acquisitions_in_flight);
+        keep = metrics.pending_concurrency_acquires < in_flight;
+    }
+    if (keep) {
+        aws_mutex_lock(&pool_state->warm_connections_lock);
+        keep = !pool_state->warm_connections_closed;
+        if (keep) {
+            aws_array_list_push_back(&pool_state->warm_connections, &connection);
+        }
+        aws_mutex_unlock(&pool_state->warm_connections_lock);
+    }
+
+    if (!keep) {
+        aws_http_connection_manager_release_connection(pool_state->manager, connection);
+    }
+    return keep;
+}
+
+/* Serves an acquisition with a warm connection if there is one, through the native manager otherwise */
+static void s_pool_state_acquire_connection(
+    struct http_connection_manager_pool_state *pool_state,
+    struct aws_http_connection_binding *binding) {
+
+    struct aws_http_connection *connection = s_pool_state_take_warm_connection(pool_state);
+    if (connection != NULL) {
+        s_on_http_conn_acquisition_callback(connection, AWS_ERROR_SUCCESS, binding);
+        return;
+    }
+
+    aws_http_connection_manager_acquire_connection(pool_state->manager, &s_on_http_conn_acquisition_callback, binding);
+}
+
+/* Hands queued acquisitions to the native manager while the adaptive connection limit allows */
+static void s_pool_state_dispatch_pending_acquisitions(struct http_connection_manager_pool_state *pool_state) {
+    struct http_connection_pool_sizing *sizing = &pool_state->sizing;
+
+    struct aws_linked_list ready;
+    aws_linked_list_init(&ready);
+
+    aws_mutex_lock(&pool_state->lock);
+    while (!pool_state->released && sizing->outstanding < sizing->limit &&
+           !aws_linked_list_empty(&sizing->pending_acquisitions)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&sizing->pending_acquisitions);
+        --sizing->pending_count;
+        s_pool_state_count_acquisition_synced(
+            pool_state, AWS_CONTAINER_OF(node, struct aws_http_connection_binding, pending_node));
+        aws_linked_list_push_back(&ready, node);
+    }
+    aws_mutex_unlock(&pool_state->lock);
+
+    while (!aws_linked_list_empty(&ready)) {
+        struct aws_http_connection_binding *binding =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&ready), struct aws_http_connection_binding, pending_node);
+        if (s_pool_state_begin_manager_use(pool_state)) {
+            s_pool_state_acquire_connection(pool_state, binding);
+            s_pool_state_end_manager_use(pool_state);
+        } else {
+            s_on_http_conn_acquisition_callback(NULL, AWS_ERROR_HTTP_CONNECTION_MANAGER_SHUTTING_DOWN, binding);
+        }
+    }
+}
+
+/* Called once a counted acquisition fails or its connection is released */
+static void s_pool_state_release_acquisition(struct http_connection_manager_pool_state *pool_state) {
+    aws_mutex_lock(&pool_state->lock);
+    AWS_ASSERT(pool_state->sizing.outstanding > 0);
+    --pool_state->sizing.outstanding;
+    aws_mutex_unlock(&pool_state->lock);
+
+    s_pool_state_dispatch_pending_acquisitions(pool_state);
+}
+
+static void s_pool_state_record_acquire_wait(
+    struct http_connection_manager_pool_state *pool_state,
+    uint64_t acquire_wait_ns) {
+    if (!pool_state->sizing.enabled) {
+        return;
+    }
+
+    aws_mutex_lock(&pool_state->lock);
+    pool_state->sizing.acquire_wait_total_ns += acquire_wait_ns;
+    ++pool_state->sizing.acquire_count;
+    aws_mutex_unlock(&pool_state->lock);
+}
+
+/*
+ * Re-evaluates the adaptive connection limit from what was observed since the last adjustment:
+ *  - grow while acquisitions are queued and waiting longer than the target, by up to the current limit at once so a
+ *    burst is absorbed in a few intervals,
+ *  - never grow while the connections already leased are each moving less than the minimum throughput, since the
+ *    bottleneck is then elsewhere and more connections only add load,
+ *  - shrink by one when nothing waited and fewer connections than the limit were needed, or when nothing waited and
+ *    throughput per connection is below the minimum.
+ * Shrinking only stops new connections from being opened. Surplus idle connections are closed by the manager's
+ * max connection idle time.
+ */
+static void s_pool_state_adjust_limit(
+    struct http_connection_manager_pool_state *pool_state,
+    const struct aws_http_manager_metrics *metrics) {
+    struct http_connection_pool_sizing *sizing = &pool_state->sizing;
+
+    uint64_t now_ns = aws_http_jni_timestamp_ns();
+    uint64_t body_bytes = aws_http_latency_histograms_get_body_bytes(pool_state->latency_histograms);
+
+    aws_mutex_lock(&pool_state->lock);
+    size_t old_limit = sizing->limit;
+    size_t waiting = sizing->pending_count + metrics->pending_concurrency_acquires;
+
+    bool below_min_throughput = false;
+    uint64_t elapsed_ns = now_ns > sizing->last_adjustment_ns ? now_ns - sizing->last_adjustment_ns : 0;
+    if (sizing->min_throughput_bytes_per_second > 0 && sizing->peak_outstanding > 0 && elapsed_ns > 0) {
+        /* the counter is size_t wide, so take the difference modulo its width in case it wrapped */
+        uint64_t interval_bytes = (size_t)(body_bytes - sizing->last_body_bytes);
+        uint64_t bytes_per_second = (uint64_t)((double)interval_bytes * (double)AWS_TIMESTAMP_NANOS /
+                                               (double)elapsed_ns / (double)sizing->peak_outstanding);
+        below_min_throughput = bytes_per_second < sizing->min_throughput_bytes_per_second;
+    }
+
+    bool slow_acquisitions = sizing->acquire_count == 0 ||
+                             sizing->acquire_wait_total_ns / sizing->acquire_count > sizing->target_acquire_wait_ns;
+
+    if (waiting > 0 && slow_acquisitions && !below_min_throughput) {
+        size_t step = aws_max_size(1, aws_min_size(waiting, sizing->limit));
+        sizing->limit = aws_min_size(pool_state->max_connections, aws_add_size_saturating(sizing->limit, step));
+    } else if (waiting == 0 && (sizing->peak_outstanding < sizing->limit || below_min_throughput)) {
+        sizing->limit = aws_max_size(sizing->min_connections, sizing->limit - 1);
+    }
+
+    sizing->peak_outstanding = sizing->outstanding;
+    sizing->acquire_wait_total_ns = 0;
+    sizing->acquire_count = 0;
+    sizing->last_adjustment_ns = now_ns;
+    sizing->last_body_bytes = body_bytes;
+    size_t new_limit = sizing->limit;
+    aws_mutex_unlock(&pool_state->lock);
+
+    if (new_limit != old_limit) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_HTTP_CONNECTION_MANAGER,
+            "id=%p: Adaptive connection limit changed from %zu to %zu, %zu acquisitions waiting",
+            (void *)pool_state->manager,
+            old_limit,
+            new_limit,
+            waiting);
+    }
+
+    if (new_limit > old_limit) {
+        s_pool_state_dispatch_pending_acquisitions(pool_state);
+    }
+}
+
+static void s_finish_warm_up(struct http_connection_warm_up *warm_up) {
+    struct http_connection_manager_pool_state *pool_state = warm_up->pool_state;
+
+    size_t connections_kept = aws_atomic_load_int(&warm_up->connections_kept);
+    jint connections_warmed = (jint)aws_min_size(warm_up->already_warm + connections_kept, warm_up->requested);
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_HTTP_CONNECTION_MANAGER,
+        "id=%p: Warm-up finished, %zu of %zu connections kept warm",
+        (void *)pool_state->manager,
+        connections_kept,
+        warm_up->acquisitions);
+
+    if (warm_up->java_warm_up_future != NULL) {
+        /********** JNI ENV ACQUIRE **********/
+        JNIEnv *env = aws_jni_acquire_thread_env(warm_up->jvm);
+        if (env != NULL) {
+            (*env)->CallStaticVoidMethod(
+                env,
+                http_client_connection_manager_properties.http_client_connection_manager_class,
+                http_client_connection_manager_properties.onWarmUpComplete,
+                warm_up->java_warm_up_future,
+                connections_warmed);
+            AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+            (*env)->DeleteGlobalRef(env, warm_up->java_warm_up_future);
+
+            aws_jni_release_thread_env(warm_up->jvm, env);
+            /********** JNI ENV RELEASE **********/
+        }
+    }
+
+    aws_mem_release(pool_state->allocator, warm_up);
+    s_pool_state_release(pool_state);
+}
+
+static void s_on_warm_up_connection_acquired(struct aws_http_connection *connection, int error_code, void *user_data) {
+    struct http_connection_warm_up *warm_up = user_data;
+    struct http_connection_manager_pool_state *pool_state = warm_up->pool_state;
+
+    if (!error_code) {
+        if (s_pool_state_keep_warm_connection(pool_state, connection)) {
+            aws_atomic_fetch_add(&warm_up->connections_kept, 1);
+        }
+    } else {
+        AWS_LOGF_DEBUG(
+            AWS_LS_HTTP_CONNECTION_MANAGER,
+            "id=%p: Warm-up connection failed, err_code: %d, err_str: %s",
+            (void *)pool_state->manager,
+            error_code,
+            aws_error_str(error_code));
+    }
+
+    /* Only stop counting the acquisition once its connection is counted as warm */
+    aws_atomic_fetch_sub(&pool_state->warm_up_acquisitions_in_flight, 1);
+    if (aws_atomic_fetch_add(&warm_up->completed, 1) + 1 == warm_up->acquisitions) {
+        s_finish_warm_up(warm_up);
+    }
+}
+
+/*
+ * Acquires the `idle_connections` connections idle in the native manager, which it hands out first, and opens
+ * `new_connections` more, keeping each as a warm connection. Must be called between s_pool_state_begin_manager_use
+ * and s_pool_state_end_manager_use. Acquisitions can complete synchronously and run Java callbacks, so no lock may be
+ * held.
+ */
+static void s_start_warm_up(
+    struct http_connection_manager_pool_state *pool_state,
+    size_t idle_connections,
+    size_t new_connections,
+    size_t already_warm,
+    size_t requested,
+    JavaVM *jvm,
+    jobject java_warm_up_future) {
+
+    AWS_ASSERT(new_connections > 0);
+    struct http_connection_warm_up *warm_up =
+        aws_mem_calloc(pool_state->allocator, 1, sizeof(struct http_connection_warm_up));
+    AWS_FATAL_ASSERT(warm_up);
+
+    warm_up->pool_state = s_pool_state_acquire(pool_state);
+    warm_up->jvm = jvm;
+    warm_up->java_warm_up_future = java_warm_up_future;
+    warm_up->requested = requested;
+    size_t acquisitions = idle_connections + new_connections;
+    warm_up->acquisitions = acquisitions;
+    warm_up->already_warm = already_warm;
+    aws_atomic_init_int(&warm_up->completed, 0);
+    aws_atomic_init_int(&warm_up->connections_kept, 0);
+    aws_atomic_fetch_add(&pool_state->warm_up_acquisitions_in_flight, acquisitions);
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_HTTP_CONNECTION_MANAGER,
+        "id=%p: Warming up %zu new connections and %zu idle connections",
+        (void *)pool_state->manager,
+        new_connections,
+        idle_connections);
+
+    /* The last acquisition can complete synchronously and free the warm-up */
+    for (size_t i = 0; i < acquisitions; ++i) {
+        aws_http_connection_manager_acquire_connection(
+            pool_state->manager, s_on_warm_up_connection_acquired, warm_up);
+    }
+}
+
+/*
+ * Tops the pool up to `requested` idle connections: the idle and warm connections count towards it, and so do
+ * connections warm-ups are still establishing. Opens the rest, capped so the pool stays within its connection limit.
+ * Returns the number of connections already idle or warm. Must be called between s_pool_state_begin_manager_use and
+ * s_pool_state_end_manager_use, with no lock held.
+ */
+static size_t s_warm_up(
+    struct http_connection_manager_pool_state *pool_state,
+    size_t requested,
+    JavaVM *jvm,
+    jobject java_warm_up_future,
+    size_t *out_new_connections) {
+
+    struct aws_http_manager_metrics metrics;
+    aws_http_connection_manager_fetch_metrics(pool_state->manager, &metrics);
+    size_t warm_connections = s_pool_state_count_warm_connections(pool_state);
+    size_t in_flight = aws_atomic_load_int(&pool_state->warm_up_acquisitions_in_flight);
+
+    /* Warm connections are leased from the native manager */
+    size_t ready = metrics.available_concurrency + warm_connections;
+    size_t open_or_opening = metrics.leased_concurrency + metrics.available_concurrency + in_flight;
+    size_t limit = s_pool_state_connection_limit(pool_state);
+    size_t wanted = requested > ready + in_flight ? requested - (ready + in_flight) : 0;
+    size_t capacity = limit > open_or_opening ? limit - open_or_opening : 0;
+
+    *out_new_connections = aws_min_size(wanted, capacity);
+    if (*out_new_connections > 0) {
+        s_start_warm_up(
+            pool_state,
+            metrics.available_concurrency,
+            *out_new_connections,
+            warm_connections,
+            requested,
+            jvm,
+            java_warm_up_future);
+    }
+    return ready;
+}
+
+static void s_maintain_min_idle_connections(
+    struct http_connection_manager_pool_state *pool_state,
+    const struct aws_http_manager_metrics *metrics) {
+
+    /* Leave it to pending acquisitions if there are any, they are already opening connections */
+    if (metrics->pending_concurrency_acquires == 0) {
+        size_t new_connections = 0;
+        s_warm_up(pool_state, pool_state->min_idle_connections, NULL, NULL, &new_connections);
+    }
+}
+
+static void s_schedule_maintenance_task(struct http_connection_manager_pool_state *pool_state) {
+    uint64_t now = 0;
+    aws_event_loop_current_clock_time(pool_state->maintenance_loop, &now);
+    aws_event_loop_schedule_task_future(
+        pool_state->maintenance_loop, &pool_state->maintenance_task, now + pool_state->maintenance_period_ns);
+}
+
+static void s_maintenance_task(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct http_connection_manager_pool_state *pool_state = arg;
+
+    bool rescheduled = false;
+    if (status == AWS_TASK_STATUS_RUN_READY && s_pool_state_begin_manager_use(pool_state)) {
+        struct aws_http_manager_metrics metrics;
+        aws_http_connection_manager_fetch_metrics(pool_state->manager, &metrics);
+
+        if (pool_state->sizing.enabled) {
+            s_pool_state_adjust_limit(pool_state, &metrics);
+        }
+        if (pool_state->min_idle_connections > 0) {
+            s_maintain_min_idle_connections(pool_state, &metrics);
+        }
+
+        s_schedule_maintenance_task(pool_state);
+        rescheduled = true;
+        s_pool_state_end_manager_use(pool_state);
+    }
+
+    if (!rescheduled) {
+        /* Release the task's reference */
+        s_pool_state_release(pool_state);
+    }
+}
+
 static void s_destroy_manager_binding(struct http_connection_manager_binding *binding, JNIEnv *env) {
     if (binding == NULL || env == NULL) {
         return;
@@ -55,6 +732,9 @@ static void s_destroy_manager_binding(struct http_connection_manager_binding *bi
         (*env)->DeleteWeakGlobalRef(env, binding->java_http_conn_manager);
     }
 
+    aws_http_latency_histograms_release(binding->latency_histograms);
+    s_pool_state_release(binding->pool_state);
+
     aws_mem_release(aws_jni_get_allocator(), binding);
 }
 
@@ -171,7 +851,13 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     jlong jni_max_connection_idle_in_milliseconds,
     jlong jni_monitoring_throughput_threshold_in_bytes_per_second,
     jint jni_monitoring_failure_interval_in_seconds,
-    jint jni_expected_protocol_version) {
+    jint jni_expected_protocol_version,
+    jint jni_body_min_delivery_size,
+    jint jni_min_idle_connections,
+    jint jni_adaptive_min_connections,
+    jlong jni_adaptive_target_acquire_latency_ms,
+    jlong jni_adaptive_min_throughput_bytes_per_second,
+    jlong jni_adaptive_adjustment_interval_ms) {
 
     (void)jni_class;
     (void)jni_expected_protocol_version;
@@ -211,6 +897,29 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
         goto cleanup;
     }
 
+    if (jni_body_min_delivery_size < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Response body minimum delivery size must be >= 0");
+        goto cleanup;
+    }
+
+    if (jni_min_idle_connections < 0 || jni_min_idle_connections > jni_max_conns) {
+        aws_jni_throw_runtime_exception(env, "Min idle connections must be between 0 and max connections");
+        goto cleanup;
+    }
+
+    /* A minimum of 0 connections means adaptive pool sizing is disabled */
+    if (jni_adaptive_min_connections < 0 || jni_adaptive_min_connections > jni_max_conns) {
+        aws_jni_throw_runtime_exception(env, "Adaptive min connections must be between 1 and max connections");
+        goto cleanup;
+    }
+
+    if (jni_adaptive_min_connections > 0 &&
+        (jni_adaptive_target_acquire_latency_ms < 0 || jni_adaptive_min_throughput_bytes_per_second < 0 ||
+         jni_adaptive_adjustment_interval_ms <= 0)) {
+        aws_jni_throw_runtime_exception(env, "Invalid adaptive pool sizing options");
+        goto cleanup;
+    }
+
     uint16_t port = (uint16_t)jni_port;
 
     bool new_tls_conn_opts = (jni_tls_ctx != 0 && !tls_connection_options);
@@ -226,6 +935,22 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     binding = aws_mem_calloc(allocator, 1, sizeof(struct http_connection_manager_binding));
     AWS_FATAL_ASSERT(binding);
     binding->java_http_conn_manager = (*env)->NewWeakGlobalRef(env, conn_manager_jobject);
+    binding->latency_histograms = aws_http_latency_histograms_new(allocator);
+    binding->body_min_delivery_size = (size_t)jni_body_min_delivery_size;
+    binding->pool_state = s_pool_state_new(
+        allocator,
+        client_bootstrap,
+        binding->latency_histograms,
+        (size_t)jni_max_conns,
+        (size_t)jni_min_idle_connections);
+    if (jni_adaptive_min_connections > 0) {
+        s_pool_state_enable_sizing(
+            binding->pool_state,
+            (size_t)jni_adaptive_min_connections,
+            (uint64_t)jni_adaptive_target_acquire_latency_ms,
+            (uint64_t)jni_adaptive_min_throughput_bytes_per_second,
+            (uint64_t)jni_adaptive_adjustment_interval_ms);
+    }
 
     jint jvmresult = (*env)->GetJavaVM(env, &binding->jvm);
     (void)jvmresult;
@@ -285,6 +1010,17 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     if (binding->manager == NULL) {
         aws_jni_throw_runtime_exception(
             env, "Failed to create connection manager: %s", aws_error_str(aws_last_error()));
+    } else {
+        struct http_connection_manager_pool_state *pool_state = binding->pool_state;
+        pool_state->manager = binding->manager;
+        if (pool_state->min_idle_connections > 0 || pool_state->sizing.enabled) {
+            /* The task holds its own reference, dropped once it sees the manager released */
+            s_pool_state_acquire(pool_state);
+            pool_state->maintenance_loop = aws_event_loop_group_get_next_loop(pool_state->event_loop_group);
+            aws_task_init(
+                &pool_state->maintenance_task, s_maintenance_task, pool_state, "http_conn_manager_pool_maintenance");
+            aws_event_loop_schedule_task_now(pool_state->maintenance_loop, &pool_state->maintenance_task);
+        }
     }
 
     aws_http_proxy_options_jni_clean_up(
@@ -322,8 +1058,44 @@ JNIEXPORT void JNICALL
         return;
     }
 
-    AWS_LOGF_DEBUG(AWS_LS_HTTP_CONNECTION, "Releasing ConnManager: id: %p", (void *)conn_manager);
-    aws_http_connection_manager_release(conn_manager);
+    /*
+     * Nothing may acquire connections once the manager starts shutting down. If a warm-up or queued acquisition is
+     * handing work to the native manager right now, the last of them releases it instead.
+     */
+    struct http_connection_manager_pool_state *pool_state = binding->pool_state;
+    struct aws_linked_list pending_acquisitions;
+    aws_linked_list_init(&pending_acquisitions);
+
+    aws_mutex_lock(&pool_state->lock);
+    pool_state->released = true;
+    bool release_manager = pool_state->manager_users == 0;
+    if (release_manager) {
+        pool_state->manager_released = true;
+    }
+    aws_linked_list_swap_contents(&pending_acquisitions, &pool_state->sizing.pending_acquisitions);
+    pool_state->sizing.pending_count = 0;
+    aws_mutex_unlock(&pool_state->lock);
+
+    /* Warm connections go back to the native manager, which closes them as it shuts down */
+    struct aws_array_list warm_connections;
+    aws_array_list_init_dynamic(&warm_connections, pool_state->allocator, 0, sizeof(struct aws_http_connection *));
+    aws_mutex_lock(&pool_state->warm_connections_lock);
+    pool_state->warm_connections_closed = true;
+    aws_array_list_swap_contents(&warm_connections, &pool_state->warm_connections);
+    aws_mutex_unlock(&pool_state->warm_connections_lock);
+    s_pool_state_release_connections(pool_state, &warm_connections);
+
+    while (!aws_linked_list_empty(&pending_acquisitions)) {
+        struct aws_http_connection_binding *connection_binding = AWS_CONTAINER_OF(
+            aws_linked_list_pop_front(&pending_acquisitions), struct aws_http_connection_binding, pending_node);
+        s_on_http_conn_acquisition_callback(
+            NULL, AWS_ERROR_HTTP_CONNECTION_MANAGER_SHUTTING_DOWN, connection_binding);
+    }
+
+    if (release_manager) {
+        AWS_LOGF_DEBUG(AWS_LS_HTTP_CONNECTION, "Releasing ConnManager: id: %p", (void *)conn_manager);
+        aws_http_connection_manager_release(conn_manager);
+    }
 }
 
 /********************************************************************************************************************/
@@ -341,6 +1113,13 @@ static void s_destroy_connection_binding(struct aws_http_connection_binding *bin
         aws_http_connection_manager_release_connection(binding->manager, binding->connection);
     }
 
+    if (binding->counts_against_limit) {
+        s_pool_state_release_acquisition(binding->pool_state);
+    }
+
+    aws_http_latency_histograms_release(binding->latency_histograms);
+    s_pool_state_release(binding->pool_state);
+
     aws_mem_release(aws_jni_get_allocator(), binding);
 }
 
@@ -352,6 +1131,15 @@ static void s_on_http_conn_acquisition_callback(
     struct aws_http_connection_binding *binding = (struct aws_http_connection_binding *)user_data;
     binding->connection = connection;
 
+    if (!error_code) {
+        binding->acquire_wait_ns = aws_http_jni_elapsed_ns(binding->acquire_start_ns, aws_http_jni_timestamp_ns());
+        if (binding->acquire_wait_ns >= 0) {
+            aws_http_latency_histograms_record(
+                binding->latency_histograms, AWS_HTTP_JNI_LATENCY_ACQUIRE_WAIT, (uint64_t)binding->acquire_wait_ns);
+            s_pool_state_record_acquire_wait(binding->pool_state, (uint64_t)binding->acquire_wait_ns);
+        }
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
     if (env == NULL) {
@@ -420,13 +1208,22 @@ JNIEXPORT void JNICALL
         aws_mem_calloc(allocator, 1, sizeof(struct aws_http_connection_binding));
     connection_binding->java_acquire_connection_future = future_ref;
     connection_binding->manager = conn_manager;
+    connection_binding->latency_histograms = aws_http_latency_histograms_acquire(manager_binding->latency_histograms);
+    connection_binding->acquire_wait_ns = -1;
+    connection_binding->body_min_delivery_size = manager_binding->body_min_delivery_size;
+    connection_binding->pool_state = s_pool_state_acquire(manager_binding->pool_state);
 
     jint jvmresult = (*env)->GetJavaVM(env, &connection_binding->jvm);
     (void)jvmresult;
     AWS_FATAL_ASSERT(jvmresult == 0);
 
-    aws_http_connection_manager_acquire_connection(
-        conn_manager, &s_on_http_conn_acquisition_callback, (void *)connection_binding);
+    /* Time spent queued behind the adaptive connection limit counts as acquire wait */
+    connection_binding->acquire_start_ns = aws_http_jni_timestamp_ns();
+    if (!s_pool_state_admit_acquisition(manager_binding->pool_state, connection_binding)) {
+        return;
+    }
+
+    s_pool_state_acquire_connection(manager_binding->pool_state, connection_binding);
 }
 
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnection_httpClientConnectionReleaseManaged(
@@ -478,14 +1275,85 @@ JNIEXPORT jobject JNICALL
 
     struct aws_http_manager_metrics metrics;
     aws_http_connection_manager_fetch_metrics(conn_manager, &metrics);
+    /* Warm connections are leased from the native manager but ready for requests */
+    size_t warm_connections = s_pool_state_count_warm_connections(manager_binding->pool_state);
+    warm_connections = aws_min_size(warm_connections, metrics.leased_concurrency);
 
     return (*env)->NewObject(
         env,
         http_manager_metrics_properties.http_manager_metrics_class,
         http_manager_metrics_properties.constructor_method_id,
-        (jlong)metrics.available_concurrency,
-        (jlong)metrics.pending_concurrency_acquires,
-        (jlong)metrics.leased_concurrency);
+        (jlong)(metrics.available_concurrency + warm_connections),
+        (jlong)(metrics.pending_concurrency_acquires + s_pool_state_queued_acquisitions(manager_binding->pool_state)),
+        (jlong)(metrics.leased_concurrency - warm_connections),
+        (jlong)warm_connections,
+        (jlong)s_pool_state_connection_limit(manager_binding->pool_state));
+}
+
+JNIEXPORT void JNICALL
+    Java_software_amazon_awssdk_crt_http_HttpClientConnectionManager_httpClientConnectionManagerWarmUp(
+        JNIEnv *env,
+        jclass jni_class,
+        jlong jni_conn_manager_binding,
+        jint jni_connections,
+        jobject warm_up_future) {
+    (void)jni_class;
+
+    struct http_connection_manager_binding *manager_binding =
+        (struct http_connection_manager_binding *)jni_conn_manager_binding;
+    struct http_connection_manager_pool_state *pool_state = manager_binding->pool_state;
+
+    if (!manager_binding->manager) {
+        aws_jni_throw_runtime_exception(env, "Connection Manager can't be null");
+        return;
+    }
+
+    if (jni_connections <= 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Number of connections to warm up must be > 0");
+        return;
+    }
+
+    if (!s_pool_state_begin_manager_use(pool_state)) {
+        aws_jni_throw_runtime_exception(env, "Connection Manager has been released");
+        return;
+    }
+
+    jobject future_ref = (*env)->NewGlobalRef(env, warm_up_future);
+    AWS_FATAL_ASSERT(future_ref);
+    size_t new_connections = 0;
+    size_t ready = s_warm_up(pool_state, (size_t)jni_connections, manager_binding->jvm, future_ref, &new_connections);
+    s_pool_state_end_manager_use(pool_state);
+
+    if (new_connections == 0) {
+        /* Either enough connections are idle or being established, or every connection the pool may open is leased */
+        (*env)->DeleteGlobalRef(env, future_ref);
+        jint idle_connections = (jint)aws_min_size(ready, (size_t)jni_connections);
+        (*env)->CallStaticVoidMethod(
+            env,
+            http_client_connection_manager_properties.http_client_connection_manager_class,
+            http_client_connection_manager_properties.onWarmUpComplete,
+            warm_up_future,
+            idle_connections);
+    }
+}
+
+JNIEXPORT void JNICALL
+    Java_software_amazon_awssdk_crt_http_HttpClientConnectionManager_httpConnectionManagerFetchLatencyHistograms(
+        JNIEnv *env,
+        jclass jni_class,
+        jlong jni_conn_manager_binding,
+        jlongArray java_buckets) {
+    (void)jni_class;
+
+    struct http_connection_manager_binding *manager_binding =
+        (struct http_connection_manager_binding *)jni_conn_manager_binding;
+
+    if (!manager_binding->manager) {
+        aws_jni_throw_runtime_exception(env, "Connection Manager can't be null");
+        return;
+    }
+
+    aws_http_latency_histograms_fetch(env, manager_binding->latency_histograms, java_buckets);
 }
 
 #if UINTPTR_MAX == 0xffffffff
@@ -8,8 +8,15 @@
 
 #include <jni.h>
 
+#include <aws/common/linked_list.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
 struct aws_http_connection;
 struct aws_http_connection_manager;
+struct http_connection_manager_pool_state;
+struct aws_http_latency_histograms;
 struct aws_http_proxy_options;
 struct aws_tls_connection_options;
 struct aws_tls_ctx;
@@ -19,6 +26,19 @@ struct aws_http_connection_binding {
     jobject java_acquire_connection_future;
     struct aws_http_connection_manager *manager;
     struct aws_http_connection *connection;
+    /* Histograms of the owning manager, shared with streams made on this connection */
+    struct aws_http_latency_histograms *latency_histograms;
+    uint64_t acquire_start_ns;
+    /* Acquire wait not yet reported to a stream, -1 once the first stream has taken it */
+    int64_t acquire_wait_ns;
+    size_t body_min_delivery_size;
+    /* Pool state of the owning manager, used to serve the acquisition with a warm connection and to enforce the
+     * adaptive connection limit */
+    struct http_connection_manager_pool_state *pool_state;
+    /* Links the binding into the pool state's queue while it waits for the adaptive connection limit */
+    struct aws_linked_list_node pending_node;
+    /* Set once the acquisition has been counted against the adaptive connection limit */
+    bool counts_against_limit;
 };
 
 void aws_http_proxy_options_jni_init(
@@ -9,6 +9,7 @@
 #include "http_connection_manager.h"
 #include "http_request_response.h"
 #include "http_request_utils.h"
+#include "http_stream_metrics.h"
 #include "java_class_ids.h"
 
 #include <aws/common/atomics.h>
@@ -79,6 +80,9 @@ static void s_http_stream_binding_destroy(JNIEnv *env, struct http_stream_bindin
         aws_http_message_release(binding->native_request);
     }
     aws_byte_buf_clean_up(&binding->headers_buf);
+    aws_byte_buf_clean_up(&binding->body_buf);
+    aws_http_latency_histograms_release(binding->latency_histograms);
+    aws_http_connection_load_release(binding->connection_load);
     aws_mem_release(aws_jni_get_allocator(), binding);
 }
 
@@ -116,13 +120,100 @@ struct http_stream_binding *aws_http_stream_binding_new(JNIEnv *env, jobject jav
 
     binding->java_http_response_stream_handler = (*env)->NewGlobalRef(env, java_callback_handler);
     AWS_FATAL_ASSERT(binding->java_http_response_stream_handler);
+    binding->deliver_metrics = (*env)->GetBooleanField(
+        env, java_callback_handler, http_stream_response_handler_properties.deliverMetrics);
     AWS_FATAL_ASSERT(!aws_byte_buf_init(&binding->headers_buf, allocator, 1024));
+    binding->acquire_wait_ns = -1;
 
     aws_atomic_init_int(&binding->ref, 1);
+    aws_atomic_init_int(&binding->unacknowledged_window_bytes, 0);
 
     return binding;
 }
 
+void aws_http_stream_binding_finish_connection_load(struct http_stream_binding *binding) {
+    if (binding->connection_load == NULL) {
+        return;
+    }
+
+    size_t unacknowledged = aws_atomic_exchange_int(&binding->unacknowledged_window_bytes, 0);
+    aws_http_connection_load_stream_finished(binding->connection_load, binding->body_bytes, unacknowledged);
+}
+
+/*
+ * Window updates can come from Java on any thread, racing the stream's completion. Only the bytes this stream still
+ * has outstanding are taken off the connection slot load, so a late or oversized update never drives it negative.
+ */
+static void s_http_stream_binding_record_window_update(struct http_stream_binding *binding, size_t window_update) {
+    if (binding->connection_load == NULL || !binding->connection_load->track_window) {
+        return;
+    }
+
+    size_t outstanding = aws_atomic_load_int(&binding->unacknowledged_window_bytes);
+    size_t acknowledged = 0;
+    do {
+        acknowledged = window_update < outstanding ? window_update : outstanding;
+        if (acknowledged == 0) {
+            return;
+        }
+    } while (!aws_atomic_compare_exchange_int(
+        &binding->unacknowledged_window_bytes, &outstanding, outstanding - acknowledged));
+
+    aws_http_connection_load_record_window_update(binding->connection_load, acknowledged);
+}
+
+static void s_http_stream_binding_add_callback_time(struct http_stream_binding *binding, uint64_t start_ns) {
+    int64_t elapsed_ns = aws_http_jni_elapsed_ns(start_ns, aws_http_jni_timestamp_ns());
+    if (elapsed_ns > 0) {
+        binding->jni_callback_ns += (uint64_t)elapsed_ns;
+    }
+}
+
+static void s_record_latency(
+    struct aws_http_latency_histograms *histograms,
+    enum aws_http_jni_latency_phase phase,
+    int64_t duration_ns) {
+    if (duration_ns >= 0) {
+        aws_http_latency_histograms_record(histograms, phase, (uint64_t)duration_ns);
+    }
+}
+
+/*
+ * Called once the stream completes: records the stream's phases into the manager histograms and hands the
+ * per-stream breakdown to the Java handler if it asked for it. Acquire wait is recorded into the histograms by the managers themselves,
+ * once per acquisition.
+ */
+static void s_http_stream_binding_deliver_metrics(JNIEnv *env, struct http_stream_binding *binding) {
+    int64_t time_to_first_byte_ns = aws_http_jni_elapsed_ns(binding->activate_ns, binding->first_header_ns);
+    int64_t body_transfer_ns = aws_http_jni_elapsed_ns(binding->first_body_ns, binding->complete_ns);
+    int64_t total_ns = aws_http_jni_elapsed_ns(binding->activate_ns, binding->complete_ns);
+
+    struct aws_http_latency_histograms *histograms = binding->latency_histograms;
+    s_record_latency(histograms, AWS_HTTP_JNI_LATENCY_TIME_TO_FIRST_BYTE, time_to_first_byte_ns);
+    s_record_latency(histograms, AWS_HTTP_JNI_LATENCY_BODY_TRANSFER, body_transfer_ns);
+    s_record_latency(histograms, AWS_HTTP_JNI_LATENCY_TOTAL, total_ns);
+    s_record_latency(histograms, AWS_HTTP_JNI_LATENCY_JNI_CALLBACK, (int64_t)binding->jni_callback_ns);
+
+    if (!binding->deliver_metrics) {
+        return;
+    }
+
+    (*env)->CallVoidMethod(
+        env,
+        binding->java_http_response_stream_handler,
+        http_stream_response_handler_properties.onMetrics,
+        binding->java_http_stream_base,
+        (jlong)binding->acquire_wait_ns,
+        (jlong)time_to_first_byte_ns,
+        (jlong)body_transfer_ns,
+        (jlong)total_ns,
+        (jlong)binding->jni_callback_ns,
+        (jlong)binding->body_bytes);
+
+    /* Metrics are informational, a throwing handler doesn't affect the connection */
+    aws_jni_check_and_clear_exception(env);
+}
+
 int aws_java_http_stream_on_incoming_headers_fn(
     struct aws_http_stream *stream,
     enum aws_http_header_block block_type,
@@ -140,6 +231,9 @@ int aws_java_http_stream_on_incoming_headers_fn(
     }
 
     binding->response_status = resp_status;
+    if (binding->first_header_ns == 0) {
+        binding->first_header_ns = aws_http_jni_timestamp_ns();
+    }
 
     if (aws_marshal_http_headers_to_dynamic_buffer(&binding->headers_buf, header_array, num_headers)) {
         AWS_LOGF_ERROR(
@@ -167,6 +261,7 @@ int aws_java_http_stream_on_incoming_header_block_done_fn(
 
     int result = AWS_OP_ERR;
     jint jni_block_type = block_type;
+    uint64_t callback_start_ns = aws_http_jni_timestamp_ns();
 
     jobject jni_headers_buf =
         aws_jni_direct_byte_buffer_from_raw_ptr(env, binding->headers_buf.buffer, binding->headers_buf.len);
@@ -206,30 +301,26 @@ int aws_java_http_stream_on_incoming_header_block_done_fn(
 
 done:
 
+    s_http_stream_binding_add_callback_time(binding, callback_start_ns);
+
     aws_jni_release_thread_env(binding->jvm, env);
     /********** JNI ENV RELEASE **********/
 
     return result;
 }
 
-int aws_java_http_stream_on_incoming_body_fn(
+/*
+ * Hands one chunk of body to Java. Raises AWS_ERROR_HTTP_CALLBACK_FAILURE if the handler throws or returns a
+ * negative window increment.
+ */
+static int s_deliver_body(
+    JNIEnv *env,
+    struct http_stream_binding *binding,
     struct aws_http_stream *stream,
-    const struct aws_byte_cursor *data,
-    void *user_data) {
-    struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
-
-    size_t total_window_increment = 0;
-
-    /********** JNI ENV ACQUIRE **********/
-    JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
-    if (env == NULL) {
-        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
-        return AWS_OP_ERR;
-    }
+    struct aws_byte_cursor body,
+    bool update_window) {
 
-    int result = AWS_OP_ERR;
-
-    jobject jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, data->ptr, data->len);
+    jobject jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, body.ptr, body.len);
 
     jint window_increment = (*env)->CallIntMethod(
         env,
@@ -242,25 +333,74 @@ int aws_java_http_stream_on_incoming_body_fn(
 
     if (aws_jni_check_and_clear_exception(env)) {
         AWS_LOGF_ERROR(AWS_LS_HTTP_STREAM, "id=%p: Received Exception from onResponseBody", (void *)stream);
-        aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
-        goto done;
+        return aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
     }
 
     if (window_increment < 0) {
         AWS_LOGF_ERROR(AWS_LS_HTTP_STREAM, "id=%p: Window Increment from onResponseBody < 0", (void *)stream);
-        aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
-        goto done;
+        return aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
+    }
+
+    if (update_window && window_increment > 0) {
+        s_http_stream_binding_record_window_update(binding, (size_t)window_increment);
+        aws_http_stream_update_window(stream, (size_t)window_increment);
     }
 
-    total_window_increment += window_increment;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_java_http_stream_on_incoming_body_fn(
+    struct aws_http_stream *stream,
+    const struct aws_byte_cursor *data,
+    void *user_data) {
+    struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
 
-    if (total_window_increment > 0) {
-        aws_http_stream_update_window(stream, total_window_increment);
+    uint64_t callback_start_ns = aws_http_jni_timestamp_ns();
+    if (binding->first_body_ns == 0) {
+        binding->first_body_ns = callback_start_ns;
+    }
+    binding->body_bytes += data->len;
+    aws_http_latency_histograms_record_body_bytes(binding->latency_histograms, data->len);
+    if (binding->connection_load != NULL && binding->connection_load->track_window) {
+        aws_atomic_fetch_add(&binding->unacknowledged_window_bytes, data->len);
+    }
+    aws_http_connection_load_record_body(binding->connection_load, data->len);
+
+    struct aws_byte_cursor body = *data;
+    if (binding->body_min_delivery_size > 0) {
+        /*
+         * Aggregated delivery: small frames are copied into the stream's buffer and handed over together once the
+         * threshold is reached or the stream completes. A frame that meets the threshold on its own while nothing is
+         * buffered goes straight through without a copy.
+         */
+        if (binding->body_buf.len > 0 || data->len < binding->body_min_delivery_size) {
+            if (binding->body_buf.allocator == NULL &&
+                aws_byte_buf_init(&binding->body_buf, aws_jni_get_allocator(), binding->body_min_delivery_size)) {
+                return AWS_OP_ERR;
+            }
+            if (aws_byte_buf_append_dynamic(&binding->body_buf, data)) {
+                return AWS_OP_ERR;
+            }
+            if (binding->body_buf.len < binding->body_min_delivery_size) {
+                return AWS_OP_SUCCESS;
+            }
+            body = aws_byte_cursor_from_buf(&binding->body_buf);
+        }
     }
 
-    result = AWS_OP_SUCCESS;
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return AWS_OP_ERR;
+    }
 
-done:
+    int result = s_deliver_body(env, binding, stream, body, true);
+
+    /* The buffer keeps its capacity for the next round of frames */
+    aws_byte_buf_reset(&binding->body_buf, false);
+
+    s_http_stream_binding_add_callback_time(binding, callback_start_ns);
 
     aws_jni_release_thread_env(binding->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -270,6 +410,8 @@ done:
 
 void aws_java_http_stream_on_stream_complete_fn(struct aws_http_stream *stream, int error_code, void *user_data) {
     struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
+    binding->complete_ns = aws_http_jni_timestamp_ns();
+    aws_http_stream_binding_finish_connection_load(binding);
 
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
@@ -278,6 +420,17 @@ void aws_java_http_stream_on_stream_complete_fn(struct aws_http_stream *stream,
         return;
     }
 
+    /* Hand over whatever aggregated body is still buffered before completing. The window no longer matters. */
+    if (binding->body_buf.len > 0) {
+        if (s_deliver_body(env, binding, stream, aws_byte_cursor_from_buf(&binding->body_buf), false)) {
+            aws_http_connection_close(aws_http_stream_get_connection(stream));
+            if (error_code == AWS_ERROR_SUCCESS) {
+                error_code = AWS_ERROR_HTTP_CALLBACK_FAILURE;
+            }
+        }
+        aws_byte_buf_reset(&binding->body_buf, false);
+    }
+
     /* Don't invoke Java callbacks if Java HttpStream failed to completely setup */
     jint jErrorCode = error_code;
     (*env)->CallVoidMethod(
@@ -292,6 +445,9 @@ void aws_java_http_stream_on_stream_complete_fn(struct aws_http_stream *stream,
         aws_http_connection_close(aws_http_stream_get_connection(stream));
     }
 
+    s_http_stream_binding_add_callback_time(binding, binding->complete_ns);
+    s_http_stream_binding_deliver_metrics(env, binding);
+
     aws_jni_release_thread_env(binding->jvm, env);
     /********** JNI ENV RELEASE **********/
 }
@@ -338,33 +494,25 @@ jobjectArray aws_java_http_headers_from_native(JNIEnv *env, struct aws_http_head
     return (ret);
 }
 
-static jobject s_make_request_general(
+/*
+ * Creates the binding and the native stream for one request, without the Java stream object. The binding holds one
+ * ref for the Java object and one for the native stream. If stream creation fails, a Java exception is thrown and
+ * NULL is returned.
+ */
+static struct http_stream_binding *s_new_request_stream_binding(
     JNIEnv *env,
-    jlong jni_connection,
+    struct aws_http_connection_binding *connection_binding,
     jbyteArray marshalled_request,
     jobject jni_http_request_body_stream,
-    jobject jni_http_response_callback_handler,
-    enum aws_http_version version) {
+    jobject jni_http_response_callback_handler) {
 
-    struct aws_http_connection_binding *connection_binding = (struct aws_http_connection_binding *)jni_connection;
     struct aws_http_connection *native_conn = connection_binding->connection;
 
-    if (!native_conn) {
-        aws_jni_throw_null_pointer_exception(env, "HttpClientConnection.MakeRequest: Invalid aws_http_connection");
-        return (jobject)NULL;
-    }
-
-    if (!jni_http_response_callback_handler) {
-        aws_jni_throw_illegal_argument_exception(
-            env, "HttpClientConnection.MakeRequest: Invalid jni_http_response_callback_handler");
-        return (jobject)NULL;
-    }
-
     /* initial refcount created for the Java object */
     struct http_stream_binding *stream_binding = aws_http_stream_binding_new(env, jni_http_response_callback_handler);
     if (!stream_binding) {
         /* Exception already thrown */
-        return (jobject)NULL;
+        return NULL;
     }
 
     stream_binding->native_request =
@@ -374,6 +522,12 @@ static jobject s_make_request_general(
         goto error;
     }
 
+    stream_binding->latency_histograms = aws_http_latency_histograms_acquire(connection_binding->latency_histograms);
+    /* The time spent waiting for the connection is attributed to the first request made on it */
+    stream_binding->acquire_wait_ns = connection_binding->acquire_wait_ns;
+    connection_binding->acquire_wait_ns = -1;
+    stream_binding->body_min_delivery_size = connection_binding->body_min_delivery_size;
+
     struct aws_http_make_request_options request_options = {
         .self_size = sizeof(request_options),
         .request = stream_binding->native_request,
@@ -396,25 +550,92 @@ static jobject s_make_request_general(
     /* Stream created successfully, acquire on binding for the native stream lifetime. */
     aws_http_stream_binding_acquire(stream_binding);
 
-    jobject jHttpStreamBase = aws_java_http_stream_from_native_new(env, stream_binding, version);
-    if (jHttpStreamBase == NULL) {
-        goto error;
-    }
-
     AWS_LOGF_TRACE(
         AWS_LS_HTTP_CONNECTION,
         "Opened new Stream on Connection. conn: %p, stream: %p",
         (void *)native_conn,
         (void *)stream_binding->native_stream);
 
-    return jHttpStreamBase;
+    return stream_binding;
 
 error:
-    aws_http_stream_release(stream_binding->native_stream);
     aws_http_stream_binding_release(env, stream_binding);
     return NULL;
 }
 
+/* Undoes s_new_request_stream_binding for a stream whose Java object could not be created */
+static void s_release_request_stream_binding(JNIEnv *env, struct http_stream_binding *stream_binding) {
+    /* The stream was never activated, releasing it fires on_destroy which drops the native stream's ref */
+    aws_http_stream_release(stream_binding->native_stream);
+    aws_http_stream_binding_release(env, stream_binding);
+}
+
+static jobject s_make_request_general(
+    JNIEnv *env,
+    jlong jni_connection,
+    jbyteArray marshalled_request,
+    jobject jni_http_request_body_stream,
+    jobject jni_http_response_callback_handler,
+    enum aws_http_version version) {
+
+    struct aws_http_connection_binding *connection_binding = (struct aws_http_connection_binding *)jni_connection;
+    struct aws_http_connection *native_conn = connection_binding->connection;
+
+    if (!native_conn) {
+        aws_jni_throw_null_pointer_exception(env, "HttpClientConnection.MakeRequest: Invalid aws_http_connection");
+        return (jobject)NULL;
+    }
+
+    if (!jni_http_response_callback_handler) {
+        aws_jni_throw_illegal_argument_exception(
+            env, "HttpClientConnection.MakeRequest: Invalid jni_http_response_callback_handler");
+        return (jobject)NULL;
+    }
+
+    struct http_stream_binding *stream_binding = s_new_request_stream_binding(
+        env, connection_binding, marshalled_request, jni_http_request_body_stream, jni_http_response_callback_handler);
+    if (stream_binding == NULL) {
+        /* Exception already thrown */
+        return (jobject)NULL;
+    }
+
+    jobject jHttpStreamBase = aws_java_http_stream_from_native_new(env, stream_binding, version);
+    if (jHttpStreamBase == NULL) {
+        s_release_request_stream_binding(env, stream_binding);
+        return (jobject)NULL;
+    }
+
+    return jHttpStreamBase;
+}
+
+/* Activates a stream whose Java object already exists. Throws and returns AWS_OP_ERR on failure. */
+static int s_activate_stream(JNIEnv *env, struct http_stream_binding *binding, jobject j_http_stream_base) {
+    struct aws_http_stream *stream = binding->native_stream;
+
+    if (stream == NULL) {
+        aws_jni_throw_runtime_exception(env, "HttpStream is null.");
+        return AWS_OP_ERR;
+    }
+
+    AWS_LOGF_TRACE(AWS_LS_HTTP_STREAM, "Activating Stream. stream: %p", (void *)stream);
+
+    /* global ref this because now the callbacks will be firing, and they will release their reference when the
+     * stream callback sequence completes. */
+    binding->java_http_stream_base = (*env)->NewGlobalRef(env, j_http_stream_base);
+    if (binding->activate_ns == 0) {
+        binding->activate_ns = aws_http_jni_timestamp_ns();
+    }
+    if (aws_http_stream_activate(stream)) {
+        (*env)->DeleteGlobalRef(env, binding->java_http_stream_base);
+        binding->java_http_stream_base = NULL;
+        aws_jni_throw_runtime_exception(
+            env, "HttpStream activate failed with error %s\n", aws_error_str(aws_last_error()));
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnection_httpClientConnectionMakeRequest(
     JNIEnv *env,
     jclass jni_class,
@@ -449,6 +670,92 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_Http2ClientConnec
         AWS_HTTP_VERSION_2);
 }
 
+/*
+ * Creates and activates one HTTP/1.1 stream per request, all sharing the same response handler, and stores them into
+ * java_streams in request order. Streams are created first and only activated once every one of them exists, so the
+ * requests go out pipelined on the connection. On failure an exception is thrown and java_streams keeps the streams
+ * made so far, which the caller must close.
+ */
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnection_httpClientConnectionMakeRequests(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_connection,
+    jobjectArray marshalled_requests,
+    jobjectArray jni_http_request_body_streams,
+    jobject jni_http_response_callback_handler,
+    jobjectArray java_streams) {
+    (void)jni_class;
+
+    struct aws_http_connection_binding *connection_binding = (struct aws_http_connection_binding *)jni_connection;
+
+    if (!connection_binding->connection) {
+        aws_jni_throw_null_pointer_exception(env, "HttpClientConnection.MakeRequests: Invalid aws_http_connection");
+        return;
+    }
+
+    if (!jni_http_response_callback_handler) {
+        aws_jni_throw_illegal_argument_exception(
+            env, "HttpClientConnection.MakeRequests: Invalid jni_http_response_callback_handler");
+        return;
+    }
+
+    jsize request_count = (*env)->GetArrayLength(env, marshalled_requests);
+    if ((*env)->GetArrayLength(env, jni_http_request_body_streams) != request_count ||
+        (*env)->GetArrayLength(env, java_streams) != request_count) {
+        aws_jni_throw_illegal_argument_exception(env, "HttpClientConnection.MakeRequests: Array lengths differ");
+        return;
+    }
+
+    if (request_count == 0) {
+        return;
+    }
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct http_stream_binding **stream_bindings =
+        aws_mem_calloc(allocator, (size_t)request_count, sizeof(struct http_stream_binding *));
+    AWS_FATAL_ASSERT(stream_bindings);
+
+    for (jsize i = 0; i < request_count; ++i) {
+        jbyteArray marshalled_request = (*env)->GetObjectArrayElement(env, marshalled_requests, i);
+        jobject body_stream = (*env)->GetObjectArrayElement(env, jni_http_request_body_streams, i);
+
+        struct http_stream_binding *stream_binding = s_new_request_stream_binding(
+            env, connection_binding, marshalled_request, body_stream, jni_http_response_callback_handler);
+
+        (*env)->DeleteLocalRef(env, marshalled_request);
+        if (body_stream != NULL) {
+            (*env)->DeleteLocalRef(env, body_stream);
+        }
+        if (stream_binding == NULL) {
+            /* Exception already thrown */
+            goto done;
+        }
+
+        jobject java_stream = aws_java_http_stream_from_native_new(env, stream_binding, AWS_HTTP_VERSION_1_1);
+        if (java_stream == NULL) {
+            s_release_request_stream_binding(env, stream_binding);
+            goto done;
+        }
+
+        (*env)->SetObjectArrayElement(env, java_streams, i, java_stream);
+        (*env)->DeleteLocalRef(env, java_stream);
+        stream_bindings[i] = stream_binding;
+    }
+
+    for (jsize i = 0; i < request_count; ++i) {
+        jobject java_stream = (*env)->GetObjectArrayElement(env, java_streams, i);
+        int result = s_activate_stream(env, stream_bindings[i], java_stream);
+        (*env)->DeleteLocalRef(env, java_stream);
+        if (result) {
+            /* Exception already thrown */
+            goto done;
+        }
+    }
+
+done:
+    aws_mem_release(allocator, stream_bindings);
+}
+
 struct http_stream_chunked_callback_data {
     struct http_stream_binding *stream_cb_data;
     struct aws_byte_buf chunk_data;
@@ -548,23 +855,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpStreamBase_httpS
     (void)jni_class;
 
     struct http_stream_binding *binding = (struct http_stream_binding *)jni_stream_binding;
-    struct aws_http_stream *stream = binding->native_stream;
-
-    if (stream == NULL) {
-        aws_jni_throw_runtime_exception(env, "HttpStream is null.");
-        return;
-    }
-
-    AWS_LOGF_TRACE(AWS_LS_HTTP_STREAM, "Activating Stream. stream: %p", (void *)stream);
-
-    /* global ref this because now the callbacks will be firing, and they will release their reference when the
-     * stream callback sequence completes. */
-    binding->java_http_stream_base = (*env)->NewGlobalRef(env, j_http_stream_base);
-    if (aws_http_stream_activate(stream)) {
-        (*env)->DeleteGlobalRef(env, binding->java_http_stream_base);
-        aws_jni_throw_runtime_exception(
-            env, "HttpStream activate failed with error %s\n", aws_error_str(aws_last_error()));
-    }
+    s_activate_stream(env, binding, j_http_stream_base);
 }
 
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpStreamBase_httpStreamBaseRelease(
@@ -577,12 +868,11 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpStreamBase_httpS
     struct http_stream_binding *binding = (struct http_stream_binding *)jni_binding;
     struct aws_http_stream *stream = binding->native_stream;
 
-    if (stream == NULL) {
-        aws_jni_throw_runtime_exception(env, "HttpStream is null.");
-        return;
+    /* A stream whose acquisition failed after its Java object was created never got a native stream */
+    if (stream != NULL) {
+        AWS_LOGF_TRACE(AWS_LS_HTTP_STREAM, "Releasing Stream. stream: %p", (void *)stream);
+        aws_http_stream_release(stream);
     }
-    AWS_LOGF_TRACE(AWS_LS_HTTP_STREAM, "Releasing Stream. stream: %p", (void *)stream);
-    aws_http_stream_release(stream);
 
     aws_http_stream_binding_release(env, binding);
 }
@@ -636,6 +926,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpStreamBase_httpS
 
     AWS_LOGF_TRACE(
         AWS_LS_HTTP_STREAM, "Updating Stream Window. stream: %p, update: %d", (void *)stream, (int)window_update);
+    s_http_stream_binding_record_window_update(binding, (size_t)window_update);
     aws_http_stream_update_window(stream, window_update);
 }
 
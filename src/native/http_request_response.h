@@ -13,6 +13,8 @@ struct aws_http_message;
 struct aws_http_stream;
 struct aws_byte_buf;
 struct aws_atomic_var;
+struct aws_http_latency_histograms;
+struct aws_http_connection_load;
 
 struct http_stream_binding {
     JavaVM *jvm;
@@ -28,6 +30,28 @@ struct http_stream_binding {
     int response_status;
     /* For the native http stream and the Java stream object */
     struct aws_atomic_var ref;
+
+    /* Timing for HttpStreamMetrics, high-res clock nanoseconds, 0 when not reached */
+    int64_t acquire_wait_ns;
+    uint64_t activate_ns;
+    uint64_t first_header_ns;
+    uint64_t first_body_ns;
+    uint64_t complete_ns;
+    uint64_t jni_callback_ns;
+    uint64_t body_bytes;
+    /* Set when the Java handler overrides onMetrics, otherwise the per-stream upcall is skipped */
+    bool deliver_metrics;
+    /* When non-zero, body frames are aggregated in body_buf until this many bytes are ready */
+    size_t body_min_delivery_size;
+    struct aws_byte_buf body_buf;
+
+    /* Histograms of the manager the stream came from, may be NULL */
+    struct aws_http_latency_histograms *latency_histograms;
+
+    /* Load of the stream manager connection slot the stream was assigned to, may be NULL */
+    struct aws_http_connection_load *connection_load;
+    /* This stream's share of connection_load's unacknowledged window bytes, updated from any thread */
+    struct aws_atomic_var unacknowledged_window_bytes;
 };
 
 jobject aws_java_http_stream_from_native_new(JNIEnv *env, void *opaque, int version);
@@ -36,6 +60,12 @@ void aws_java_http_stream_from_native_delete(JNIEnv *env, jobject jHttpStream);
 void *aws_http_stream_binding_release(JNIEnv *env, struct http_stream_binding *binding);
 void *aws_http_stream_binding_acquire(struct http_stream_binding *binding);
 
+/*
+ * Removes the stream from its connection slot load. Called once the stream completes, or once its acquisition fails
+ * if it never started.
+ */
+void aws_http_stream_binding_finish_connection_load(struct http_stream_binding *binding);
+
 // If error occurs, A Java exception is thrown and NULL is returned.
 struct http_stream_binding *aws_http_stream_binding_new(JNIEnv *env, jobject java_callback_handler);
 
@@ -9,6 +9,8 @@
 #include "java_class_ids.h"
 
 #include <aws/common/byte_order.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/thread.h>
 #include <aws/http/http.h>
 #include <aws/http/request_response.h>
 #include <aws/io/stream.h>
@@ -22,6 +24,9 @@ struct aws_http_request_body_stream_impl {
     struct aws_allocator *allocator;
     JavaVM *jvm;
     jobject http_request_body_stream;
+    /* Global ref to the DirectByteBuffer over scratch handed to sendRequestBody for reads that fit in it */
+    jobject scratch_buffer;
+    uint8_t *scratch;
     bool body_done;
     bool is_valid;
 };
@@ -67,6 +72,33 @@ static int s_aws_input_stream_seek(struct aws_input_stream *stream, int64_t offs
     return result;
 }
 
+/*
+ * Reads of up to this many bytes go through one reused DirectByteBuffer per body stream. That covers the reads the
+ * HTTP/1.1 and HTTP/2 encoders make, which never exceed a channel message. Larger reads, such as S3 filling a whole
+ * part, wrap dest directly instead of copying, and the one wrapper they allocate is amortised over the read.
+ */
+#define AWS_HTTP_BODY_STREAM_SCRATCH_SIZE (16 * 1024)
+
+/* Returns the scratch DirectByteBuffer ready for a read of len bytes, or NULL if it can't be created */
+static jobject s_prepare_scratch_buffer(JNIEnv *env, struct aws_http_request_body_stream_impl *impl, size_t len) {
+    if (impl->scratch_buffer == NULL) {
+        uint8_t *scratch = aws_mem_acquire(impl->allocator, AWS_HTTP_BODY_STREAM_SCRATCH_SIZE);
+        jobject scratch_buffer = (*env)->NewDirectByteBuffer(env, scratch, AWS_HTTP_BODY_STREAM_SCRATCH_SIZE);
+        if (scratch_buffer == NULL) {
+            aws_jni_check_and_clear_exception(env);
+            aws_mem_release(impl->allocator, scratch);
+            return NULL;
+        }
+        impl->scratch = scratch;
+        impl->scratch_buffer = (*env)->NewGlobalRef(env, scratch_buffer);
+        (*env)->DeleteLocalRef(env, scratch_buffer);
+    }
+
+    /* Undo whatever the previous sendRequestBody call did to the buffer, including its byte order */
+    aws_jni_byte_buffer_reset(env, impl->scratch_buffer, (jint)len);
+    return impl->scratch_buffer;
+}
+
 static int s_aws_input_stream_read(struct aws_input_stream *stream, struct aws_byte_buf *dest) {
     struct aws_http_request_body_stream_impl *impl =
         AWS_CONTAINER_OF(stream, struct aws_http_request_body_stream_impl, base);
@@ -93,7 +125,14 @@ static int s_aws_input_stream_read(struct aws_input_stream *stream, struct aws_b
 
     size_t out_remaining = dest->capacity - dest->len;
 
-    jobject direct_buffer = aws_jni_direct_byte_buffer_from_raw_ptr(env, dest->buffer + dest->len, out_remaining);
+    jobject direct_buffer = NULL;
+    if (out_remaining <= AWS_HTTP_BODY_STREAM_SCRATCH_SIZE) {
+        direct_buffer = s_prepare_scratch_buffer(env, impl, out_remaining);
+    }
+    bool is_scratch_buffer = direct_buffer != NULL;
+    if (!is_scratch_buffer) {
+        direct_buffer = aws_jni_direct_byte_buffer_from_raw_ptr(env, dest->buffer + dest->len, out_remaining);
+    }
 
     impl->body_done = (*env)->CallBooleanMethod(
         env, impl->http_request_body_stream, http_request_body_stream_properties.send_outgoing_body, direct_buffer);
@@ -103,10 +142,17 @@ static int s_aws_input_stream_read(struct aws_input_stream *stream, struct aws_b
         result = aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
     } else {
         size_t amt_written = aws_jni_byte_buffer_get_position(env, direct_buffer);
-        dest->len += amt_written;
+        if (!is_scratch_buffer) {
+            dest->len += amt_written;
+        } else if (!aws_byte_buf_write(dest, impl->scratch, amt_written)) {
+            /* The Java stream raised the limit past what dest can take */
+            result = aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
+        }
     }
 
-    (*env)->DeleteLocalRef(env, direct_buffer);
+    if (!is_scratch_buffer) {
+        (*env)->DeleteLocalRef(env, direct_buffer);
+    }
 
     aws_jni_release_thread_env(impl->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -168,9 +214,16 @@ static void s_aws_input_stream_destroy(struct aws_http_request_body_stream_impl
         (*env)->DeleteGlobalRef(env, impl->http_request_body_stream);
     }
 
+    if (impl->scratch_buffer != NULL) {
+        /* Leave nothing to write to in case the Java stream wrongly kept the buffer */
+        aws_jni_byte_buffer_set_limit(env, impl->scratch_buffer, 0);
+        (*env)->DeleteGlobalRef(env, impl->scratch_buffer);
+    }
+
     aws_jni_release_thread_env(impl->jvm, env);
     /********** JNI ENV RELEASE **********/
 
+    aws_mem_release(impl->allocator, impl->scratch);
     aws_mem_release(impl->allocator, impl);
 }
 
@@ -214,16 +267,187 @@ on_error:
     return NULL;
 }
 
+/*
+ * Header names common enough to be worth interning. A marshalled header whose name is in this table is written as
+ * AWS_HTTP_JNI_STATIC_NAME_FLAG | index in place of the name length, with no name bytes following. Matching is
+ * exact, so both the lowercase (HTTP/2, HPACK static table) and Title-Case (HTTP/1.1) spellings are listed.
+ *
+ * Order must stay in sync with STATIC_NAMES in HttpHeader.java: the index is part of the wire format between them.
+ */
+static const struct aws_byte_cursor s_static_header_names[] = {
+    /* HTTP/2 pseudo-headers */
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL(":authority"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL(":method"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL(":path"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL(":scheme"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL(":status"),
+    /* HPACK static table names (RFC 7541, Appendix A) */
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("accept-charset"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("accept-encoding"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("accept-language"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("accept-ranges"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("accept"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("access-control-allow-origin"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("age"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("allow"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("authorization"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("cache-control"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-disposition"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-encoding"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-language"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-length"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-location"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-range"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-type"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("cookie"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("date"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("etag"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("expect"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("expires"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("from"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("host"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("if-match"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("if-modified-since"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("if-none-match"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("if-range"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("if-unmodified-since"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("last-modified"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("link"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("location"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("max-forwards"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("proxy-authenticate"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("proxy-authorization"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("range"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("referer"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("refresh"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("retry-after"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("server"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("set-cookie"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("strict-transport-security"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("transfer-encoding"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("user-agent"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("vary"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("via"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("www-authenticate"),
+    /* Other common lowercase names */
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("connection"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("content-md5"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-date"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-content-sha256"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-security-token"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-target"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-user-agent"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-request-id"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-id-2"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amzn-requestid"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-server-side-encryption"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-decoded-content-length"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-trailer"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-checksum-crc32"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("x-amz-checksum-crc32c"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("amz-sdk-invocation-id"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("amz-sdk-request"),
+    /* HTTP/1.1 Title-Case spellings */
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Accept"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Accept-Encoding"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Authorization"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Cache-Control"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Connection"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Content-Encoding"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Content-Length"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Content-MD5"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Content-Type"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Date"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("ETag"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Expect"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Host"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Last-Modified"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Location"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Server"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("Transfer-Encoding"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("User-Agent"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("X-Amz-Date"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("X-Amz-Content-Sha256"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("X-Amz-Security-Token"),
+    AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("X-Amz-Target"),
+};
+
+#define AWS_HTTP_JNI_STATIC_NAME_FLAG 0x80000000u
+
+/* Open-addressed lookup from name to table index, built once. Sized to stay well under half full. */
+#define AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT 256
+static int16_t s_static_header_name_slots[AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT];
+static aws_thread_once s_static_header_name_slots_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_init_static_header_name_slots(void *user_data) {
+    (void)user_data;
+    const size_t name_count = AWS_ARRAY_SIZE(s_static_header_names);
+    AWS_FATAL_ASSERT(name_count * 2 < AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT);
+
+    for (size_t slot = 0; slot < AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT; ++slot) {
+        s_static_header_name_slots[slot] = -1;
+    }
+
+    for (size_t i = 0; i < name_count; ++i) {
+        size_t slot = aws_hash_byte_cursor_ptr(&s_static_header_names[i]) % AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT;
+        while (s_static_header_name_slots[slot] >= 0) {
+            slot = (slot + 1) % AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT;
+        }
+        s_static_header_name_slots[slot] = (int16_t)i;
+    }
+}
+
+/* Returns the static table index of name, or -1 if it is not interned */
+static int s_find_static_header_name(const struct aws_byte_cursor *name) {
+    aws_thread_call_once(&s_static_header_name_slots_once, s_init_static_header_name_slots, NULL);
+
+    size_t slot = aws_hash_byte_cursor_ptr(name) % AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT;
+    while (s_static_header_name_slots[slot] >= 0) {
+        int index = s_static_header_name_slots[slot];
+        if (aws_byte_cursor_eq(name, &s_static_header_names[index])) {
+            return index;
+        }
+        slot = (slot + 1) % AWS_HTTP_JNI_STATIC_NAME_SLOT_COUNT;
+    }
+    return -1;
+}
+
+/* Reads a header name written by s_marshal_http_header_to_buffer or HttpHeader.java */
+static bool s_read_header_name(struct aws_byte_cursor *blob, struct aws_byte_cursor *out_name) {
+    uint32_t field_len = 0;
+    if (!aws_byte_cursor_read_be32(blob, &field_len)) {
+        return false;
+    }
+
+    if (field_len & AWS_HTTP_JNI_STATIC_NAME_FLAG) {
+        uint32_t index = field_len & ~AWS_HTTP_JNI_STATIC_NAME_FLAG;
+        if (index >= AWS_ARRAY_SIZE(s_static_header_names)) {
+            return false;
+        }
+        *out_name = s_static_header_names[index];
+        return true;
+    }
+
+    *out_name = aws_byte_cursor_advance(blob, field_len);
+    return true;
+}
+
 static inline int s_marshal_http_header_to_buffer(
     struct aws_byte_buf *buf,
     const struct aws_byte_cursor *name,
     const struct aws_byte_cursor *value) {
-    if (aws_byte_buf_reserve_relative(buf, sizeof(int) + sizeof(int) + name->len + value->len)) {
+    int static_index = s_find_static_header_name(name);
+    size_t name_len = static_index >= 0 ? 0 : name->len;
+    if (aws_byte_buf_reserve_relative(buf, sizeof(int) + sizeof(int) + name_len + value->len)) {
         return AWS_OP_ERR;
     }
 
-    aws_byte_buf_write_be32(buf, (uint32_t)name->len);
-    aws_byte_buf_write_from_whole_cursor(buf, *name);
+    if (static_index >= 0) {
+        aws_byte_buf_write_be32(buf, AWS_HTTP_JNI_STATIC_NAME_FLAG | (uint32_t)static_index);
+    } else {
+        aws_byte_buf_write_be32(buf, (uint32_t)name->len);
+        aws_byte_buf_write_from_whole_cursor(buf, *name);
+    }
     aws_byte_buf_write_be32(buf, (uint32_t)value->len);
     aws_byte_buf_write_from_whole_cursor(buf, *value);
     return AWS_OP_SUCCESS;
@@ -252,6 +476,9 @@ int aws_marshal_http_headers_to_dynamic_buffer(
  * Each request is like: [version][method][path][header name-value
  *          pairs]
  *
+ * A header name length with the high bit set is instead the index of an interned name in
+ *          s_static_header_names, and no name bytes follow.
+ *
  * s_unmarshal_http_request_to_get_version to get the version field, which is a 4 byte int.
  * s_unmarshal_http_request_without_version to get the whole request without version field.
  */
@@ -300,12 +527,11 @@ static inline int s_unmarshal_http_request_without_version(
         }
     }
     while (request_blob->len) {
-        if (!aws_byte_cursor_read_be32(request_blob, &field_len)) {
+        struct aws_byte_cursor header_name;
+        if (!s_read_header_name(request_blob, &header_name)) {
             return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
         }
 
-        struct aws_byte_cursor header_name = aws_byte_cursor_advance(request_blob, field_len);
-
         if (!aws_byte_cursor_read_be32(request_blob, &field_len)) {
             return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
         }
@@ -326,12 +552,11 @@ static inline int s_unmarshal_http_request_without_version(
 static inline int s_unmarshal_http_headers(struct aws_http_headers *headers, struct aws_byte_cursor *request_blob) {
     uint32_t field_len = 0;
     while (request_blob->len) {
-        if (!aws_byte_cursor_read_be32(request_blob, &field_len)) {
+        struct aws_byte_cursor header_name;
+        if (!s_read_header_name(request_blob, &header_name)) {
             return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
         }
 
-        struct aws_byte_cursor header_name = aws_byte_cursor_advance(request_blob, field_len);
-
         if (!aws_byte_cursor_read_be32(request_blob, &field_len)) {
             return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
         }
@@ -0,0 +1,183 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "http_stream_metrics.h"
+
+#include "crt.h"
+
+#include <aws/common/clock.h>
+
+static void s_aws_http_latency_histograms_destroy(void *user_data) {
+    struct aws_http_latency_histograms *histograms = user_data;
+    aws_mem_release(histograms->allocator, histograms);
+}
+
+struct aws_http_latency_histograms *aws_http_latency_histograms_new(struct aws_allocator *allocator) {
+    struct aws_http_latency_histograms *histograms =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_http_latency_histograms));
+    AWS_FATAL_ASSERT(histograms);
+
+    histograms->allocator = allocator;
+    aws_ref_count_init(&histograms->ref_count, histograms, s_aws_http_latency_histograms_destroy);
+
+    for (size_t phase = 0; phase < AWS_HTTP_JNI_LATENCY_PHASE_COUNT; ++phase) {
+        aws_jni_latency_histogram_init(&histograms->phases[phase]);
+    }
+    aws_atomic_init_int(&histograms->body_bytes, 0);
+
+    return histograms;
+}
+
+struct aws_http_latency_histograms *aws_http_latency_histograms_acquire(
+    struct aws_http_latency_histograms *histograms) {
+    if (histograms != NULL) {
+        aws_ref_count_acquire(&histograms->ref_count);
+    }
+    return histograms;
+}
+
+struct aws_http_latency_histograms *aws_http_latency_histograms_release(
+    struct aws_http_latency_histograms *histograms) {
+    if (histograms != NULL) {
+        aws_ref_count_release(&histograms->ref_count);
+    }
+    return NULL;
+}
+
+void aws_http_latency_histograms_record(
+    struct aws_http_latency_histograms *histograms,
+    enum aws_http_jni_latency_phase phase,
+    uint64_t duration_ns) {
+    if (histograms == NULL) {
+        return;
+    }
+
+    AWS_ASSERT(phase < AWS_HTTP_JNI_LATENCY_PHASE_COUNT);
+    aws_jni_latency_histogram_record(&histograms->phases[phase], duration_ns);
+}
+
+void aws_http_latency_histograms_record_body_bytes(struct aws_http_latency_histograms *histograms, size_t bytes) {
+    if (histograms == NULL || bytes == 0) {
+        return;
+    }
+
+    aws_atomic_fetch_add(&histograms->body_bytes, bytes);
+}
+
+uint64_t aws_http_latency_histograms_get_body_bytes(struct aws_http_latency_histograms *histograms) {
+    if (histograms == NULL) {
+        return 0;
+    }
+
+    return (uint64_t)aws_atomic_load_int(&histograms->body_bytes);
+}
+
+void aws_http_latency_histograms_fetch(
+    JNIEnv *env,
+    struct aws_http_latency_histograms *histograms,
+    jlongArray java_buckets) {
+
+    const jsize bucket_total = AWS_HTTP_JNI_LATENCY_PHASE_COUNT * AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT;
+    if (java_buckets == NULL || (*env)->GetArrayLength(env, java_buckets) != bucket_total) {
+        aws_jni_throw_illegal_argument_exception(env, "Latency histogram array has the wrong length");
+        return;
+    }
+
+    jlong buckets[AWS_HTTP_JNI_LATENCY_PHASE_COUNT * AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT];
+    for (size_t phase = 0; phase < AWS_HTTP_JNI_LATENCY_PHASE_COUNT; ++phase) {
+        aws_jni_latency_histogram_load(
+            &histograms->phases[phase], &buckets[phase * AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT]);
+    }
+
+    (*env)->SetLongArrayRegion(env, java_buckets, 0, bucket_total, buckets);
+}
+
+static void s_aws_http_connection_load_destroy(void *user_data) {
+    struct aws_http_connection_load *load = user_data;
+    aws_mem_release(load->allocator, load);
+}
+
+struct aws_http_connection_load *aws_http_connection_load_new(struct aws_allocator *allocator, bool track_window) {
+    struct aws_http_connection_load *load = aws_mem_calloc(allocator, 1, sizeof(struct aws_http_connection_load));
+    AWS_FATAL_ASSERT(load);
+
+    load->allocator = allocator;
+    load->track_window = track_window;
+    aws_ref_count_init(&load->ref_count, load, s_aws_http_connection_load_destroy);
+    aws_atomic_init_int(&load->active_streams, 0);
+    aws_atomic_init_int(&load->in_flight_bytes, 0);
+    aws_atomic_init_int(&load->unacknowledged_window_bytes, 0);
+
+    return load;
+}
+
+struct aws_http_connection_load *aws_http_connection_load_acquire(struct aws_http_connection_load *load) {
+    if (load != NULL) {
+        aws_ref_count_acquire(&load->ref_count);
+    }
+    return load;
+}
+
+struct aws_http_connection_load *aws_http_connection_load_release(struct aws_http_connection_load *load) {
+    if (load != NULL) {
+        aws_ref_count_release(&load->ref_count);
+    }
+    return NULL;
+}
+
+void aws_http_connection_load_stream_started(struct aws_http_connection_load *load) {
+    if (load == NULL) {
+        return;
+    }
+
+    aws_atomic_fetch_add(&load->active_streams, 1);
+}
+
+void aws_http_connection_load_stream_finished(
+    struct aws_http_connection_load *load,
+    uint64_t body_bytes,
+    uint64_t unacknowledged_window_bytes) {
+    if (load == NULL) {
+        return;
+    }
+
+    aws_atomic_fetch_sub(&load->active_streams, 1);
+    aws_atomic_fetch_sub(&load->in_flight_bytes, (size_t)body_bytes);
+    aws_atomic_fetch_sub(&load->unacknowledged_window_bytes, (size_t)unacknowledged_window_bytes);
+}
+
+void aws_http_connection_load_record_body(struct aws_http_connection_load *load, size_t bytes) {
+    if (load == NULL || bytes == 0) {
+        return;
+    }
+
+    aws_atomic_fetch_add(&load->in_flight_bytes, bytes);
+    if (load->track_window) {
+        aws_atomic_fetch_add(&load->unacknowledged_window_bytes, bytes);
+    }
+}
+
+void aws_http_connection_load_record_window_update(struct aws_http_connection_load *load, size_t bytes) {
+    if (load == NULL || bytes == 0 || !load->track_window) {
+        return;
+    }
+
+    aws_atomic_fetch_sub(&load->unacknowledged_window_bytes, bytes);
+}
+
+uint64_t aws_http_jni_timestamp_ns(void) {
+    uint64_t now = 0;
+    if (aws_high_res_clock_get_ticks(&now)) {
+        return 0;
+    }
+    return now;
+}
+
+int64_t aws_http_jni_elapsed_ns(uint64_t start_ns, uint64_t end_ns) {
+    if (start_ns == 0 || end_ns == 0 || end_ns < start_ns) {
+        return -1;
+    }
+    return (int64_t)(end_ns - start_ns);
+}
@@ -0,0 +1,100 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_HTTP_STREAM_METRICS_H
+#define AWS_JNI_CRT_HTTP_STREAM_METRICS_H
+
+#include <jni.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/ref_count.h>
+
+#include "latency_histogram.h"
+
+struct aws_allocator;
+
+/* Must stay in sync with HttpManagerLatencyMetrics.java */
+enum aws_http_jni_latency_phase {
+    AWS_HTTP_JNI_LATENCY_ACQUIRE_WAIT,
+    AWS_HTTP_JNI_LATENCY_TIME_TO_FIRST_BYTE,
+    AWS_HTTP_JNI_LATENCY_BODY_TRANSFER,
+    AWS_HTTP_JNI_LATENCY_TOTAL,
+    AWS_HTTP_JNI_LATENCY_JNI_CALLBACK,
+
+    AWS_HTTP_JNI_LATENCY_PHASE_COUNT,
+};
+
+/*
+ * Per-manager latency histograms, updated lock-free from any event loop thread. Shared by the manager binding and
+ * every connection and stream binding created from it, since streams can outlive the Java manager.
+ */
+struct aws_http_latency_histograms {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    struct aws_jni_latency_histogram phases[AWS_HTTP_JNI_LATENCY_PHASE_COUNT];
+    /*
+     * Response body bytes received by every stream, sampled by adaptive pool sizing to estimate throughput. Wraps at
+     * 4 GiB on 32-bit platforms, where atomics are 32 bits wide.
+     */
+    struct aws_atomic_var body_bytes;
+};
+
+struct aws_http_latency_histograms *aws_http_latency_histograms_new(struct aws_allocator *allocator);
+struct aws_http_latency_histograms *aws_http_latency_histograms_acquire(struct aws_http_latency_histograms *histograms);
+struct aws_http_latency_histograms *aws_http_latency_histograms_release(struct aws_http_latency_histograms *histograms);
+
+void aws_http_latency_histograms_record(
+    struct aws_http_latency_histograms *histograms,
+    enum aws_http_jni_latency_phase phase,
+    uint64_t duration_ns);
+
+void aws_http_latency_histograms_record_body_bytes(struct aws_http_latency_histograms *histograms, size_t bytes);
+uint64_t aws_http_latency_histograms_get_body_bytes(struct aws_http_latency_histograms *histograms);
+
+/*
+ * Copies every bucket into a Java long[] of AWS_HTTP_JNI_LATENCY_PHASE_COUNT * AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT
+ * entries, phase-major. Throws IllegalArgumentException if the array has the wrong length.
+ */
+void aws_http_latency_histograms_fetch(
+    JNIEnv *env,
+    struct aws_http_latency_histograms *histograms,
+    jlongArray java_buckets);
+
+/*
+ * Load on one connection slot of an HTTP/2 stream manager, read by the stream assignment strategies and surfaced
+ * through HttpManagerMetrics. Shared by the slot and every stream assigned to it, since streams can outlive the
+ * Java manager.
+ */
+struct aws_http_connection_load {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    /* Only set with manual window management, otherwise the stream window is reopened as data arrives */
+    bool track_window;
+    struct aws_atomic_var active_streams;
+    /* Response body bytes received so far by the streams that are still active */
+    struct aws_atomic_var in_flight_bytes;
+    /* Response body bytes received but not yet handed back through a window update */
+    struct aws_atomic_var unacknowledged_window_bytes;
+};
+
+struct aws_http_connection_load *aws_http_connection_load_new(struct aws_allocator *allocator, bool track_window);
+struct aws_http_connection_load *aws_http_connection_load_acquire(struct aws_http_connection_load *load);
+struct aws_http_connection_load *aws_http_connection_load_release(struct aws_http_connection_load *load);
+
+void aws_http_connection_load_stream_started(struct aws_http_connection_load *load);
+void aws_http_connection_load_stream_finished(
+    struct aws_http_connection_load *load,
+    uint64_t body_bytes,
+    uint64_t unacknowledged_window_bytes);
+void aws_http_connection_load_record_body(struct aws_http_connection_load *load, size_t bytes);
+void aws_http_connection_load_record_window_update(struct aws_http_connection_load *load, size_t bytes);
+
+/* Returns the current high-res clock time in nanoseconds, or 0 if the clock could not be read */
+uint64_t aws_http_jni_timestamp_ns(void);
+
+/* Returns end - start, or -1 if either timestamp was never taken */
+int64_t aws_http_jni_elapsed_ns(uint64_t start_ns, uint64_t end_ns);
+
+#endif /* AWS_JNI_CRT_HTTP_STREAM_METRICS_H */
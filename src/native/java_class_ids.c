@@ -229,6 +229,21 @@ static void s_cache_byte_buffer(JNIEnv *env) {
 
     byte_buffer_properties.wrap = (*env)->GetStaticMethodID(env, cls, "wrap", "([B)Ljava/nio/ByteBuffer;");
     AWS_FATAL_ASSERT(byte_buffer_properties.wrap);
+
+    byte_buffer_properties.set_order =
+        (*env)->GetMethodID(env, cls, "order", "(Ljava/nio/ByteOrder;)Ljava/nio/ByteBuffer;");
+    AWS_FATAL_ASSERT(byte_buffer_properties.set_order);
+
+    jclass byte_order_cls = (*env)->FindClass(env, "java/nio/ByteOrder");
+    AWS_FATAL_ASSERT(byte_order_cls);
+
+    jfieldID big_endian_field = (*env)->GetStaticFieldID(env, byte_order_cls, "BIG_ENDIAN", "Ljava/nio/ByteOrder;");
+    AWS_FATAL_ASSERT(big_endian_field);
+
+    jobject big_endian = (*env)->GetStaticObjectField(env, byte_order_cls, big_endian_field);
+    AWS_FATAL_ASSERT(big_endian);
+    byte_buffer_properties.big_endian = (*env)->NewGlobalRef(env, big_endian);
+    AWS_FATAL_ASSERT(byte_buffer_properties.big_endian);
 }
 
 struct java_credentials_provider_properties credentials_provider_properties;
@@ -321,6 +336,18 @@ static void s_cache_client_bootstrap(JNIEnv *env) {
 
     client_bootstrap_properties.onShutdownComplete = (*env)->GetMethodID(env, cls, "onShutdownComplete", "()V");
     AWS_FATAL_ASSERT(client_bootstrap_properties.onShutdownComplete);
+
+    client_bootstrap_properties.client_bootstrap_class = (*env)->NewGlobalRef(env, cls);
+    AWS_FATAL_ASSERT(client_bootstrap_properties.client_bootstrap_class);
+
+    client_bootstrap_properties.onHostResolved = (*env)->GetStaticMethodID(
+        env, cls, "onHostResolved", "(Ljava/util/concurrent/CompletableFuture;[Ljava/lang/String;I)V");
+    AWS_FATAL_ASSERT(client_bootstrap_properties.onHostResolved);
+
+    jclass string_class = (*env)->FindClass(env, "java/lang/String");
+    AWS_FATAL_ASSERT(string_class);
+    client_bootstrap_properties.string_class = (*env)->NewGlobalRef(env, string_class);
+    AWS_FATAL_ASSERT(client_bootstrap_properties.string_class);
 }
 
 struct java_tls_context_pkcs11_options_properties tls_context_pkcs11_options_properties;
@@ -408,10 +435,15 @@ struct java_http_client_connection_manager_properties http_client_connection_man
 static void s_cache_http_client_connection_manager(JNIEnv *env) {
     jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/http/HttpClientConnectionManager");
     AWS_FATAL_ASSERT(cls);
+    http_client_connection_manager_properties.http_client_connection_manager_class = (*env)->NewGlobalRef(env, cls);
 
     http_client_connection_manager_properties.onShutdownComplete =
         (*env)->GetMethodID(env, cls, "onShutdownComplete", "()V");
     AWS_FATAL_ASSERT(http_client_connection_manager_properties.onShutdownComplete);
+
+    http_client_connection_manager_properties.onWarmUpComplete =
+        (*env)->GetStaticMethodID(env, cls, "onWarmUpComplete", "(Ljava/util/concurrent/CompletableFuture;I)V");
+    AWS_FATAL_ASSERT(http_client_connection_manager_properties.onWarmUpComplete);
 }
 
 struct java_http2_stream_manager_properties http2_stream_manager_properties;
@@ -482,6 +514,13 @@ static void s_cache_http_stream_response_handler_native_adapter(JNIEnv *env) {
     http_stream_response_handler_properties.onResponseComplete =
         (*env)->GetMethodID(env, cls, "onResponseComplete", "(Lsoftware/amazon/awssdk/crt/http/HttpStreamBase;I)V");
     AWS_FATAL_ASSERT(http_stream_response_handler_properties.onResponseComplete);
+
+    http_stream_response_handler_properties.onMetrics =
+        (*env)->GetMethodID(env, cls, "onMetrics", "(Lsoftware/amazon/awssdk/crt/http/HttpStreamBase;JJJJJJ)V");
+    AWS_FATAL_ASSERT(http_stream_response_handler_properties.onMetrics);
+
+    http_stream_response_handler_properties.deliverMetrics = (*env)->GetFieldID(env, cls, "deliverMetrics", "Z");
+    AWS_FATAL_ASSERT(http_stream_response_handler_properties.deliverMetrics);
 }
 
 struct java_http_stream_write_chunk_completion_properties http_stream_write_chunk_completion_properties;
@@ -656,6 +695,10 @@ static void s_cache_s3_meta_request_response_handler_native_adapter_properties(J
         (*env)->GetMethodID(env, cls, "onResponseBody", "([BJJ)I");
     AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onResponseBody);
 
+    s3_meta_request_response_handler_native_adapter_properties.onResponseBodyDirect =
+        (*env)->GetMethodID(env, cls, "onResponseBodyDirect", "(Ljava/nio/ByteBuffer;JJ)I");
+    AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onResponseBodyDirect);
+
     s3_meta_request_response_handler_native_adapter_properties.onFinished =
         (*env)->GetMethodID(env, cls, "onFinished", "(II[BIZ)V");
     AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onFinished);
@@ -755,7 +798,7 @@ static void s_cache_http_manager_metrics(JNIEnv *env) {
     AWS_FATAL_ASSERT(cls);
     http_manager_metrics_properties.http_manager_metrics_class = (*env)->NewGlobalRef(env, cls);
 
-    http_manager_metrics_properties.constructor_method_id = (*env)->GetMethodID(env, cls, "<init>", "(JJJ)V");
+    http_manager_metrics_properties.constructor_method_id = (*env)->GetMethodID(env, cls, "<init>", "(JJJJJ)V");
     AWS_FATAL_ASSERT(http_manager_metrics_properties.constructor_method_id);
 }
 
@@ -1507,6 +1550,15 @@ static void s_cache_mqtt5_client_options(JNIEnv *env) {
         "lifecycleEvents",
         "Lsoftware/amazon/awssdk/crt/mqtt5/Mqtt5ClientOptions$LifecycleEvents;");
     AWS_FATAL_ASSERT(mqtt5_client_options_properties.lifecycle_events_field_id);
+    mqtt5_client_options_properties.direct_publish_delivery_enabled_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "directPublishDeliveryEnabled", "Z");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.direct_publish_delivery_enabled_field_id);
+    mqtt5_client_options_properties.publish_batch_max_messages_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "publishBatchMaxMessages", "I");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.publish_batch_max_messages_field_id);
+    mqtt5_client_options_properties.publish_batch_max_delay_micros_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "publishBatchMaxDelayMicros", "J");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.publish_batch_max_delay_micros_field_id);
 }
 
 struct java_aws_mqtt5_client_properties mqtt5_client_properties;
@@ -1863,6 +1915,12 @@ static void s_cache_mqtt5_publish_events_properties(JNIEnv *env) {
         "onMessageReceived",
         "(Lsoftware/amazon/awssdk/crt/mqtt5/Mqtt5Client;Lsoftware/amazon/awssdk/crt/mqtt5/PublishReturn;)V");
     AWS_FATAL_ASSERT(mqtt5_publish_events_properties.publish_events_publish_received_id);
+    mqtt5_publish_events_properties.publish_events_publishes_received_id = (*env)->GetMethodID(
+        env,
+        mqtt5_publish_events_properties.publish_events_class,
+        "onMessagesReceived",
+        "(Lsoftware/amazon/awssdk/crt/mqtt5/Mqtt5Client;[Lsoftware/amazon/awssdk/crt/mqtt5/PublishReturn;)V");
+    AWS_FATAL_ASSERT(mqtt5_publish_events_properties.publish_events_publishes_received_id);
 }
 
 struct java_aws_mqtt5_lifecycle_events mqtt5_lifecycle_events_properties;
@@ -1927,6 +1985,19 @@ static void s_cache_mqtt5_puback_result(JNIEnv *env) {
     AWS_FATAL_ASSERT(mqtt5_publish_result_properties.result_puback_constructor_id);
 }
 
+struct java_aws_mqtt5_publish_batch_result_properties mqtt5_publish_batch_result_properties;
+
+static void s_cache_mqtt5_publish_batch_result(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/mqtt5/PublishBatchResult");
+    AWS_FATAL_ASSERT(cls);
+    mqtt5_publish_batch_result_properties.result_class = (*env)->NewGlobalRef(env, cls);
+    AWS_FATAL_ASSERT(mqtt5_publish_batch_result_properties.result_class);
+    // Functions
+    mqtt5_publish_batch_result_properties.result_constructor_id =
+        (*env)->GetMethodID(env, mqtt5_publish_batch_result_properties.result_class, "<init>", "([I[I)V");
+    AWS_FATAL_ASSERT(mqtt5_publish_batch_result_properties.result_constructor_id);
+}
+
 struct java_aws_mqtt5_publish_return_properties mqtt5_publish_return_properties;
 
 static void s_cache_mqtt5_publish_return(JNIEnv *env) {
@@ -1941,6 +2012,16 @@ static void s_cache_mqtt5_publish_return(JNIEnv *env) {
         "<init>",
         "(Lsoftware/amazon/awssdk/crt/mqtt5/packets/PublishPacket;)V");
     AWS_FATAL_ASSERT(mqtt5_publish_return_properties.return_constructor_id);
+    mqtt5_publish_return_properties.return_direct_constructor_id = (*env)->GetMethodID(
+        env,
+        mqtt5_publish_return_properties.return_class,
+        "<init>",
+        "(Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;J)V");
+    AWS_FATAL_ASSERT(mqtt5_publish_return_properties.return_direct_constructor_id);
+    // Field IDs
+    mqtt5_publish_return_properties.native_publish_view_field_id =
+        (*env)->GetFieldID(env, mqtt5_publish_return_properties.return_class, "nativePublishView", "J");
+    AWS_FATAL_ASSERT(mqtt5_publish_return_properties.native_publish_view_field_id);
 }
 
 struct java_aws_mqtt5_on_stopped_return_properties mqtt5_on_stopped_return_properties;
@@ -2165,6 +2246,7 @@ void cache_java_class_ids(JNIEnv *env) {
     s_cache_mqtt5_publish_events_properties(env);
     s_cache_mqtt5_lifecycle_events_properties(env);
     s_cache_mqtt5_puback_result(env);
+    s_cache_mqtt5_publish_batch_result(env);
     s_cache_mqtt5_publish_return(env);
     s_cache_mqtt5_on_stopped_return(env);
     s_cache_mqtt5_on_attempting_connect_return(env);
@@ -100,6 +100,8 @@ struct java_byte_buffer_properties {
     jmethodID set_position;
     jmethodID get_remaining; /* Remaining number of bytes before the limit is reached. Equal to (limit - position). */
     jmethodID wrap;          /* Creates a new ByteBuffer Object from a Java byte[]. */
+    jmethodID set_order;
+    jobject big_endian; /* ByteOrder.BIG_ENDIAN, the order of a newly created ByteBuffer */
 };
 extern struct java_byte_buffer_properties byte_buffer_properties;
 
@@ -143,6 +145,10 @@ extern struct java_event_loop_group_properties event_loop_group_properties;
 /* ClientBootstrap */
 struct java_client_bootstrap_properties {
     jmethodID onShutdownComplete;
+    jclass client_bootstrap_class;
+    jmethodID onHostResolved;
+    /* Element type of the address array handed to onHostResolved */
+    jclass string_class;
 };
 extern struct java_client_bootstrap_properties client_bootstrap_properties;
 
@@ -183,7 +189,9 @@ extern struct java_tls_key_operation_properties tls_key_operation_properties;
 
 /* HttpClientConnectionManager */
 struct java_http_client_connection_manager_properties {
+    jclass http_client_connection_manager_class;
     jmethodID onShutdownComplete;
+    jmethodID onWarmUpComplete;
 };
 extern struct java_http_client_connection_manager_properties http_client_connection_manager_properties;
 
@@ -221,6 +229,8 @@ struct java_http_stream_response_handler_native_adapter_properties {
     jmethodID onResponseHeadersDone;
     jmethodID onResponseBody;
     jmethodID onResponseComplete;
+    jmethodID onMetrics;
+    jfieldID deliverMetrics;
 };
 extern struct java_http_stream_response_handler_native_adapter_properties http_stream_response_handler_properties;
 
@@ -299,6 +309,7 @@ extern struct java_s3_meta_request_properties s3_meta_request_properties;
 /* S3MetaRequestResponseHandlerNativeAdapter */
 struct java_s3_meta_request_response_handler_native_adapter_properties {
     jmethodID onResponseBody;
+    jmethodID onResponseBodyDirect;
     jmethodID onFinished;
     jmethodID onResponseHeaders;
     jmethodID onProgress;
@@ -626,6 +637,9 @@ struct java_aws_mqtt5_client_options_properties {
     jfieldID ack_timeout_seconds_field_id;
     jfieldID publish_events_field_id;
     jfieldID lifecycle_events_field_id;
+    jfieldID direct_publish_delivery_enabled_field_id;
+    jfieldID publish_batch_max_messages_field_id;
+    jfieldID publish_batch_max_delay_micros_field_id;
 };
 extern struct java_aws_mqtt5_client_options_properties mqtt5_client_options_properties;
 
@@ -778,6 +792,7 @@ extern struct java_aws_mqtt5_user_property_properties mqtt5_user_property_proper
 struct java_aws_mqtt5_publish_events {
     jclass publish_events_class;
     jmethodID publish_events_publish_received_id;
+    jmethodID publish_events_publishes_received_id;
 };
 extern struct java_aws_mqtt5_publish_events mqtt5_publish_events_properties;
 
@@ -800,10 +815,19 @@ struct java_aws_mqtt5_publish_result_properties {
 };
 extern struct java_aws_mqtt5_publish_result_properties mqtt5_publish_result_properties;
 
+/* mqtt5.PublishBatchResult */
+struct java_aws_mqtt5_publish_batch_result_properties {
+    jclass result_class;
+    jmethodID result_constructor_id;
+};
+extern struct java_aws_mqtt5_publish_batch_result_properties mqtt5_publish_batch_result_properties;
+
 /* mqtt5.PublishReturn */
 struct java_aws_mqtt5_publish_return_properties {
     jclass return_class;
     jmethodID return_constructor_id;
+    jmethodID return_direct_constructor_id;
+    jfieldID native_publish_view_field_id;
 };
 extern struct java_aws_mqtt5_publish_return_properties mqtt5_publish_return_properties;
 
@@ -0,0 +1,32 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "latency_histogram.h"
+
+void aws_jni_latency_histogram_init(struct aws_jni_latency_histogram *histogram) {
+    for (size_t bucket = 0; bucket < AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT; ++bucket) {
+        aws_atomic_init_int(&histogram->buckets[bucket], 0);
+    }
+}
+
+static size_t s_bucket_for_duration(uint64_t duration_ns) {
+    uint64_t duration_us = duration_ns / 1000;
+    size_t bucket = 0;
+    while (duration_us != 0 && bucket < AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT - 1) {
+        duration_us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void aws_jni_latency_histogram_record(struct aws_jni_latency_histogram *histogram, uint64_t duration_ns) {
+    aws_atomic_fetch_add(&histogram->buckets[s_bucket_for_duration(duration_ns)], 1);
+}
+
+void aws_jni_latency_histogram_load(const struct aws_jni_latency_histogram *histogram, jlong *values) {
+    for (size_t bucket = 0; bucket < AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT; ++bucket) {
+        values[bucket] = (jlong)aws_atomic_load_int(&histogram->buckets[bucket]);
+    }
+}
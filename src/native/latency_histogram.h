@@ -0,0 +1,31 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_LATENCY_HISTOGRAM_H
+#define AWS_JNI_CRT_LATENCY_HISTOGRAM_H
+
+#include <jni.h>
+
+#include <aws/common/atomics.h>
+
+/*
+ * Bucket 0 counts samples under 1 microsecond, bucket i counts samples in [2^(i-1), 2^i) microseconds and the last
+ * bucket counts everything above that. Must stay in sync with LatencyHistogramUtils.java.
+ */
+#define AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT 32
+
+/* Latency histogram with power-of-two microsecond buckets, updated lock-free from any thread */
+struct aws_jni_latency_histogram {
+    struct aws_atomic_var buckets[AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT];
+};
+
+void aws_jni_latency_histogram_init(struct aws_jni_latency_histogram *histogram);
+
+void aws_jni_latency_histogram_record(struct aws_jni_latency_histogram *histogram, uint64_t duration_ns);
+
+/* Copies every bucket into `values`, which must hold AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT entries */
+void aws_jni_latency_histogram_load(const struct aws_jni_latency_histogram *histogram, jlong *values);
+
+#endif /* AWS_JNI_CRT_LATENCY_HISTOGRAM_H */
@@ -4,7 +4,11 @@
  */
 #include <aws/mqtt/v5/mqtt5_client.h>
 
+#include <aws/common/clock.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
 #include <aws/http/proxy.h>
+#include <aws/io/channel_bootstrap.h>
 #include <aws/io/event_loop.h>
 #include <aws/io/socket.h>
 #include <aws/io/tls_channel_handler.h>
@@ -13,7 +17,9 @@
 #include <http_request_utils.h>
 #include <java_class_ids.h>
 #include <jni.h>
+#include <mqtt5_client_metrics.h>
 #include <mqtt5_packets.h>
+#include <mqtt5_topic_router.h>
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
@@ -31,6 +37,8 @@
  * CLIENT ONLY STRUCTS
  ******************************************************************************/
 
+struct aws_mqtt5_client_java_publish_batch;
+
 struct aws_mqtt5_client_java_jni {
     struct aws_mqtt5_client *client;
     jobject jni_client;
@@ -41,11 +49,99 @@ struct aws_mqtt5_client_java_jni {
 
     jobject jni_publish_events;
     jobject jni_lifecycle_events;
+
+    /* Hand publishes to Java as direct buffers over native memory instead of building a PublishPacket */
+    bool direct_publish_delivery;
+
+    /* Non-NULL when received publishes are accumulated and delivered to Java in batches */
+    struct aws_mqtt5_client_java_publish_batch *publish_batch;
+
+    /* Topic filter handlers registered through Mqtt5Client.addTopicHandler */
+    struct aws_mqtt5_topic_router *topic_router;
+
+    /* Read by Mqtt5Client.getMetrics */
+    struct aws_mqtt5_client_jni_metrics metrics;
+};
+
+/* A received publish copied out of the client's decoder so it can outlive the publish received callback */
+struct aws_mqtt5_client_java_received_publish {
+    struct aws_mqtt5_packet_publish_view view;
+
+    /* Storage the optional fields of the view point to */
+    enum aws_mqtt5_payload_format_indicator payload_format;
+    uint32_t message_expiry_interval_seconds;
+    uint16_t topic_alias;
+    struct aws_byte_cursor response_topic;
+    struct aws_byte_cursor correlation_data;
+    struct aws_byte_cursor content_type;
+    uint32_t *subscription_identifiers;
+    struct aws_mqtt5_user_property *user_properties;
+
+    /* Every byte cursor in the view points into this buffer */
+    struct aws_byte_buf data;
+};
+
+/*
+ * Received publishes waiting to be handed to PublishEvents.onMessagesReceived. A batch is flushed when it reaches
+ * max_messages, when its oldest publish has waited max_delay_ns, on any lifecycle event, and on termination.
+ *
+ * The batch is ref counted because the flush task can still be scheduled when the client terminates; the client
+ * and a scheduled flush task each hold a reference. The lock is held across the flush so batches reach Java in
+ * order even if termination runs on a different thread than the client's event loop.
+ */
+struct aws_mqtt5_client_java_publish_batch {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    struct aws_mutex lock;
+
+    /* Cleared when the client terminates */
+    struct aws_mqtt5_client_java_jni *java_client;
+
+    struct aws_event_loop_group *event_loop_group;
+    /* The client's event loop, found from the first publish received callback */
+    struct aws_event_loop *loop;
+    struct aws_task flush_task;
+    bool flush_task_scheduled;
+
+    size_t max_messages;
+    uint64_t max_delay_ns;
+    uint64_t oldest_publish_ns;
+
+    size_t publish_count;
+    struct aws_mqtt5_client_java_received_publish **publishes;
 };
 
 struct aws_mqtt5_client_publish_return_data {
     struct aws_mqtt5_client_java_jni *java_client;
     jobject jni_publish_future;
+    /* High res clock time the publish was handed to the client, for the publish to PUBACK latency */
+    uint64_t submit_timestamp_ns;
+};
+
+struct aws_mqtt5_client_publish_batch_return_data;
+
+/* Completion user data for one publish of a batch */
+struct aws_mqtt5_client_publish_batch_entry {
+    struct aws_mqtt5_client_publish_batch_return_data *batch;
+    size_t index;
+};
+
+/*
+ * Shared by every publish of a publishBatch call, allocated in one block together with its entries and result arrays.
+ * The submitting call holds one extra count on outstanding so the batch can't finish before every publish is handed
+ * to the client.
+ */
+struct aws_mqtt5_client_publish_batch_return_data {
+    struct aws_mqtt5_client_java_jni *java_client;
+    jobject jni_batch_future;
+    uint64_t submit_timestamp_ns;
+    struct aws_atomic_var outstanding;
+    size_t publish_count;
+    struct aws_mqtt5_client_publish_batch_entry *entries;
+    /* Per publish, each written once by its own completion before outstanding is decremented */
+    jint *error_codes;
+    /* PUBACK reason code for QoS 1, -1 when there was no PUBACK */
+    jint *reason_codes;
 };
 
 struct aws_mqtt5_client_subscribe_return_data {
@@ -247,6 +343,152 @@ on_error:
  * HELPER FUNCTIONS
  ******************************************************************************/
 
+static void s_aws_mqtt5_client_java_received_publish_destroy(
+    struct aws_allocator *allocator,
+    struct aws_mqtt5_client_java_received_publish *received_publish) {
+    if (received_publish == NULL) {
+        return;
+    }
+
+    aws_byte_buf_clean_up(&received_publish->data);
+    if (received_publish->subscription_identifiers != NULL) {
+        aws_mem_release(allocator, received_publish->subscription_identifiers);
+    }
+    if (received_publish->user_properties != NULL) {
+        aws_mem_release(allocator, received_publish->user_properties);
+    }
+    aws_mem_release(allocator, received_publish);
+}
+
+static struct aws_mqtt5_client_java_received_publish *s_aws_mqtt5_client_java_received_publish_new(
+    struct aws_allocator *allocator,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+
+    struct aws_mqtt5_client_java_received_publish *received_publish =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_client_java_received_publish));
+    struct aws_mqtt5_packet_publish_view *view = &received_publish->view;
+    *view = *publish;
+
+    size_t data_size = publish->topic.len + publish->payload.len;
+    if (publish->response_topic != NULL) {
+        data_size += publish->response_topic->len;
+    }
+    if (publish->correlation_data != NULL) {
+        data_size += publish->correlation_data->len;
+    }
+    if (publish->content_type != NULL) {
+        data_size += publish->content_type->len;
+    }
+    for (size_t i = 0; i < publish->user_property_count; ++i) {
+        data_size += publish->user_properties[i].name.len + publish->user_properties[i].value.len;
+    }
+
+    if (aws_byte_buf_init(&received_publish->data, allocator, data_size)) {
+        goto on_error;
+    }
+
+    /* The buffer is sized for everything, so the appends below cannot fail */
+    aws_byte_buf_append_and_update(&received_publish->data, &view->topic);
+    aws_byte_buf_append_and_update(&received_publish->data, &view->payload);
+
+    if (publish->payload_format != NULL) {
+        received_publish->payload_format = *publish->payload_format;
+        view->payload_format = &received_publish->payload_format;
+    }
+    if (publish->message_expiry_interval_seconds != NULL) {
+        received_publish->message_expiry_interval_seconds = *publish->message_expiry_interval_seconds;
+        view->message_expiry_interval_seconds = &received_publish->message_expiry_interval_seconds;
+    }
+    if (publish->topic_alias != NULL) {
+        received_publish->topic_alias = *publish->topic_alias;
+        view->topic_alias = &received_publish->topic_alias;
+    }
+    if (publish->response_topic != NULL) {
+        received_publish->response_topic = *publish->response_topic;
+        aws_byte_buf_append_and_update(&received_publish->data, &received_publish->response_topic);
+        view->response_topic = &received_publish->response_topic;
+    }
+    if (publish->correlation_data != NULL) {
+        received_publish->correlation_data = *publish->correlation_data;
+        aws_byte_buf_append_and_update(&received_publish->data, &received_publish->correlation_data);
+        view->correlation_data = &received_publish->correlation_data;
+    }
+    if (publish->content_type != NULL) {
+        received_publish->content_type = *publish->content_type;
+        aws_byte_buf_append_and_update(&received_publish->data, &received_publish->content_type);
+        view->content_type = &received_publish->content_type;
+    }
+
+    if (publish->subscription_identifier_count > 0) {
+        received_publish->subscription_identifiers =
+            aws_mem_calloc(allocator, publish->subscription_identifier_count, sizeof(uint32_t));
+        memcpy(
+            received_publish->subscription_identifiers,
+            publish->subscription_identifiers,
+            publish->subscription_identifier_count * sizeof(uint32_t));
+        view->subscription_identifiers = received_publish->subscription_identifiers;
+    }
+
+    if (publish->user_property_count > 0) {
+        received_publish->user_properties =
+            aws_mem_calloc(allocator, publish->user_property_count, sizeof(struct aws_mqtt5_user_property));
+        for (size_t i = 0; i < publish->user_property_count; ++i) {
+            struct aws_mqtt5_user_property *property = &received_publish->user_properties[i];
+            *property = publish->user_properties[i];
+            aws_byte_buf_append_and_update(&received_publish->data, &property->name);
+            aws_byte_buf_append_and_update(&received_publish->data, &property->value);
+        }
+        view->user_properties = received_publish->user_properties;
+    }
+
+    return received_publish;
+
+on_error:
+
+    s_aws_mqtt5_client_java_received_publish_destroy(allocator, received_publish);
+    return NULL;
+}
+
+static void s_aws_mqtt5_client_java_publish_batch_destroy(void *user_data) {
+    struct aws_mqtt5_client_java_publish_batch *batch = user_data;
+
+    for (size_t i = 0; i < batch->publish_count; ++i) {
+        s_aws_mqtt5_client_java_received_publish_destroy(batch->allocator, batch->publishes[i]);
+    }
+    aws_mem_release(batch->allocator, batch->publishes);
+    aws_mutex_clean_up(&batch->lock);
+    aws_mem_release(batch->allocator, batch);
+}
+
+static void s_aws_mqtt5_client_java_publish_batch_flush_task(
+    struct aws_task *task,
+    void *arg,
+    enum aws_task_status status);
+
+static struct aws_mqtt5_client_java_publish_batch *s_aws_mqtt5_client_java_publish_batch_new(
+    struct aws_allocator *allocator,
+    struct aws_mqtt5_client_java_jni *java_client,
+    struct aws_event_loop_group *event_loop_group,
+    size_t max_messages,
+    uint64_t max_delay_ns) {
+
+    struct aws_mqtt5_client_java_publish_batch *batch =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_client_java_publish_batch));
+    batch->allocator = allocator;
+    aws_ref_count_init(&batch->ref_count, batch, s_aws_mqtt5_client_java_publish_batch_destroy);
+    aws_mutex_init(&batch->lock);
+    batch->java_client = java_client;
+    batch->event_loop_group = event_loop_group;
+    aws_task_init(
+        &batch->flush_task, s_aws_mqtt5_client_java_publish_batch_flush_task, batch, "mqtt5_java_publish_batch");
+    batch->max_messages = max_messages;
+    batch->max_delay_ns = max_delay_ns;
+    batch->publishes =
+        aws_mem_calloc(allocator, max_messages, sizeof(struct aws_mqtt5_client_java_received_publish *));
+
+    return batch;
+}
+
 static void aws_mqtt5_client_java_destroy(
     JNIEnv *env,
     struct aws_allocator *allocator,
@@ -268,6 +510,16 @@ static void aws_mqtt5_client_java_destroy(
         (*env)->DeleteGlobalRef(env, java_client->jni_lifecycle_events);
     }
 
+    if (java_client->publish_batch) {
+        /* A flush task that is still scheduled holds its own reference and will find the client gone */
+        aws_mutex_lock(&java_client->publish_batch->lock);
+        java_client->publish_batch->java_client = NULL;
+        aws_mutex_unlock(&java_client->publish_batch->lock);
+        aws_ref_count_release(&java_client->publish_batch->ref_count);
+    }
+
+    aws_mqtt5_topic_router_destroy(java_client->topic_router, env);
+
     aws_tls_connection_options_clean_up(&java_client->tls_options);
     aws_tls_connection_options_clean_up(&java_client->http_proxy_tls_options);
 
@@ -1059,6 +1311,283 @@ static void s_aws_count_allocation(const void *pointer, size_t *counter) {
     }
 }
 
+/* Number of local references s_aws_mqtt5_client_create_jni_publish_packet_from_native() needs for a publish */
+static size_t s_aws_mqtt5_publish_packet_reference_count(const struct aws_mqtt5_packet_publish_view *publish) {
+    /* A Publish packet will need 5 references at minimum */
+    size_t references_needed = 5;
+    /* Optionals */
+    s_aws_count_allocation(publish->content_type, &references_needed);
+    s_aws_count_allocation(publish->correlation_data, &references_needed);
+    s_aws_count_allocation(publish->message_expiry_interval_seconds, &references_needed);
+    s_aws_count_allocation(publish->response_topic, &references_needed);
+    s_aws_count_allocation(publish->topic_alias, &references_needed);
+    s_aws_count_allocation(publish->payload_format, &references_needed);
+    /* Add user properties and subscription identifiers */
+    references_needed += publish->user_property_count * 2;
+    references_needed += 1; /* Add 1 for array to hold user properties */
+    if (publish->subscription_identifier_count > 0) {
+        references_needed += publish->subscription_identifier_count;
+        references_needed += 1; /* Add 1 for array */
+    }
+    return references_needed;
+}
+
+/*
+ * Direct publish delivery: the topic and payload are handed to Java as direct buffers over the native publish view,
+ * which is only valid for the duration of the publish received callback. The full PublishPacket is built on demand
+ * through PublishReturn.publishReturnMaterializePacket() while the callback is running.
+ */
+static jobject s_aws_mqtt5_client_create_jni_direct_publish_return_from_native(
+    JNIEnv *env,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+
+    /* NewDirectByteBuffer() does not accept a NULL address, even for an empty buffer */
+    static uint8_t s_empty_buffer[1];
+
+    void *topic_ptr = publish->topic.len > 0 ? (void *)publish->topic.ptr : s_empty_buffer;
+    jobject jni_topic = (*env)->NewDirectByteBuffer(env, topic_ptr, (jlong)publish->topic.len);
+    if (jni_topic == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "When creating direct PublishReturn could not create topic buffer!");
+        return NULL;
+    }
+
+    void *payload_ptr = publish->payload.len > 0 ? (void *)publish->payload.ptr : s_empty_buffer;
+    jobject jni_payload = (*env)->NewDirectByteBuffer(env, payload_ptr, (jlong)publish->payload.len);
+    if (jni_payload == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "When creating direct PublishReturn could not create payload buffer!");
+        return NULL;
+    }
+
+    jobject publish_return_data = (*env)->NewObject(
+        env,
+        mqtt5_publish_return_properties.return_class,
+        mqtt5_publish_return_properties.return_direct_constructor_id,
+        jni_topic,
+        jni_payload,
+        (jlong)publish);
+    if (aws_jni_check_and_clear_exception(env)) {
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "When creating direct PublishReturn could not create PublishReturn!");
+        return NULL;
+    }
+
+    return publish_return_data;
+}
+
+static struct aws_event_loop *s_aws_mqtt5_client_java_find_current_loop(struct aws_event_loop_group *event_loop_group) {
+    size_t loop_count = aws_event_loop_group_get_loop_count(event_loop_group);
+    for (size_t i = 0; i < loop_count; ++i) {
+        struct aws_event_loop *loop = aws_event_loop_group_get_loop_at(event_loop_group, i);
+        if (aws_event_loop_thread_is_callers_thread(loop)) {
+            return loop;
+        }
+    }
+
+    /* Not expected, publishes are received on one of the bootstrap's event loops */
+    return aws_event_loop_group_get_next_loop(event_loop_group);
+}
+
+/* Shrinks the PublishReturn array when some publishes could not be converted */
+static jobjectArray s_aws_mqtt5_client_java_truncate_publish_returns(
+    JNIEnv *env,
+    jobjectArray jni_publish_returns,
+    jsize length) {
+    jobjectArray jni_truncated =
+        (*env)->NewObjectArray(env, length, mqtt5_publish_return_properties.return_class, NULL);
+    if (jni_truncated == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        return NULL;
+    }
+    for (jsize i = 0; i < length; ++i) {
+        jobject jni_element = (*env)->GetObjectArrayElement(env, jni_publish_returns, i);
+        (*env)->SetObjectArrayElement(env, jni_truncated, i, jni_element);
+        (*env)->DeleteLocalRef(env, jni_element);
+    }
+    return jni_truncated;
+}
+
+/* Hands every accumulated publish to PublishEvents.onMessagesReceived in one call. Called with the batch lock held. */
+static void s_aws_mqtt5_client_java_publish_batch_flush_synced(
+    struct aws_mqtt5_client_java_publish_batch *batch,
+    JNIEnv *env) {
+
+    if (batch->publish_count == 0) {
+        return;
+    }
+
+    struct aws_mqtt5_client_java_jni *java_client = batch->java_client;
+    if (java_client != NULL && java_client->jni_publish_events != NULL) {
+        jobjectArray jni_publish_returns = (*env)->NewObjectArray(
+            env, (jsize)batch->publish_count, mqtt5_publish_return_properties.return_class, NULL);
+        if (jni_publish_returns == NULL) {
+            aws_jni_check_and_clear_exception(env);
+            AWS_LOGF_ERROR(
+                AWS_LS_MQTT_CLIENT,
+                "java_client=%p: Could not create PublishReturn array, dropping %zu publishes",
+                (void *)java_client,
+                batch->publish_count);
+            goto clean_up;
+        }
+
+        jsize converted_count = 0;
+        for (size_t i = 0; i < batch->publish_count; ++i) {
+            const struct aws_mqtt5_packet_publish_view *publish = &batch->publishes[i]->view;
+
+            /* One frame per publish keeps the local reference count bounded regardless of the batch size */
+            if ((*env)->PushLocalFrame(env, (jint)(s_aws_mqtt5_publish_packet_reference_count(publish) + 1)) != 0) {
+                aws_jni_check_and_clear_exception(env);
+                AWS_LOGF_ERROR(
+                    AWS_LS_MQTT_CLIENT, "java_client=%p: Could not push local JNI frame", (void *)java_client);
+                continue;
+            }
+
+            jobject publish_return_data = NULL;
+            jobject publish_packet_data = s_aws_mqtt5_client_create_jni_publish_packet_from_native(env, publish);
+            if (publish_packet_data != NULL) {
+                publish_return_data = (*env)->NewObject(
+                    env,
+                    mqtt5_publish_return_properties.return_class,
+                    mqtt5_publish_return_properties.return_constructor_id,
+                    publish_packet_data);
+            }
+            aws_jni_check_and_clear_exception(env);
+
+            if (publish_return_data != NULL) {
+                (*env)->SetObjectArrayElement(env, jni_publish_returns, converted_count++, publish_return_data);
+            } else {
+                AWS_LOGF_ERROR(
+                    AWS_LS_MQTT_CLIENT,
+                    "java_client=%p: Could not create PublishReturn, dropping publish",
+                    (void *)java_client);
+            }
+
+            (*env)->PopLocalFrame(env, NULL);
+        }
+
+        if ((size_t)converted_count < batch->publish_count) {
+            jobjectArray jni_truncated =
+                s_aws_mqtt5_client_java_truncate_publish_returns(env, jni_publish_returns, converted_count);
+            (*env)->DeleteLocalRef(env, jni_publish_returns);
+            jni_publish_returns = jni_truncated;
+        }
+
+        if (jni_publish_returns != NULL && converted_count > 0) {
+            uint64_t callback_start_ns = 0;
+            aws_high_res_clock_get_ticks(&callback_start_ns);
+            (*env)->CallVoidMethod(
+                env,
+                java_client->jni_publish_events,
+                mqtt5_publish_events_properties.publish_events_publishes_received_id,
+                java_client->jni_client,
+                jni_publish_returns);
+            aws_jni_check_and_clear_exception(env); // To hide JNI warning
+            aws_mqtt5_client_jni_metrics_record_since(
+                &java_client->metrics, AWS_MQTT5_JNI_LATENCY_JNI_CALLBACK, callback_start_ns);
+        }
+
+        if (jni_publish_returns != NULL) {
+            (*env)->DeleteLocalRef(env, jni_publish_returns);
+        }
+    }
+
+clean_up:
+
+    for (size_t i = 0; i < batch->publish_count; ++i) {
+        s_aws_mqtt5_client_java_received_publish_destroy(batch->allocator, batch->publishes[i]);
+        batch->publishes[i] = NULL;
+    }
+    batch->publish_count = 0;
+}
+
+/* Flush from a native thread that does not hold a JNIEnv yet. Called with the batch lock held. */
+static void s_aws_mqtt5_client_java_publish_batch_flush_acquire_env_synced(
+    struct aws_mqtt5_client_java_publish_batch *batch) {
+
+    if (batch->publish_count == 0 || batch->java_client == NULL) {
+        return;
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = batch->java_client->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived batch flush: could not get env");
+        return;
+    }
+
+    s_aws_mqtt5_client_java_publish_batch_flush_synced(batch, env);
+
+    /********** JNI ENV RELEASE **********/
+    aws_jni_release_thread_env(jvm, env);
+}
+
+static void s_aws_mqtt5_client_java_publish_batch_flush_task(
+    struct aws_task *task,
+    void *arg,
+    enum aws_task_status status) {
+    (void)task;
+
+    struct aws_mqtt5_client_java_publish_batch *batch = arg;
+    bool rescheduled = false;
+
+    aws_mutex_lock(&batch->lock);
+    batch->flush_task_scheduled = false;
+    if (status == AWS_TASK_STATUS_RUN_READY && batch->java_client != NULL && batch->publish_count > 0) {
+        /* The batch that scheduled us may already have been flushed for size; wait out the current one's delay */
+        uint64_t now = 0;
+        aws_event_loop_current_clock_time(batch->loop, &now);
+        uint64_t deadline = batch->oldest_publish_ns + batch->max_delay_ns;
+        if (now >= deadline) {
+            s_aws_mqtt5_client_java_publish_batch_flush_acquire_env_synced(batch);
+        } else {
+            batch->flush_task_scheduled = true;
+            rescheduled = true;
+            aws_event_loop_schedule_task_future(batch->loop, &batch->flush_task, deadline);
+        }
+    }
+    aws_mutex_unlock(&batch->lock);
+
+    if (!rescheduled) {
+        aws_ref_count_release(&batch->ref_count);
+    }
+}
+
+static void s_aws_mqtt5_client_java_publish_batch_add(
+    struct aws_mqtt5_client_java_publish_batch *batch,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+
+    struct aws_mqtt5_client_java_received_publish *received_publish =
+        s_aws_mqtt5_client_java_received_publish_new(batch->allocator, publish);
+    if (received_publish == NULL) {
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: could not copy publish for batching");
+        return;
+    }
+
+    aws_mutex_lock(&batch->lock);
+
+    if (batch->loop == NULL) {
+        batch->loop = s_aws_mqtt5_client_java_find_current_loop(batch->event_loop_group);
+    }
+
+    if (batch->publish_count == 0) {
+        aws_event_loop_current_clock_time(batch->loop, &batch->oldest_publish_ns);
+    }
+    batch->publishes[batch->publish_count++] = received_publish;
+
+    if (batch->publish_count >= batch->max_messages) {
+        s_aws_mqtt5_client_java_publish_batch_flush_acquire_env_synced(batch);
+    } else if (!batch->flush_task_scheduled) {
+        batch->flush_task_scheduled = true;
+        aws_ref_count_acquire(&batch->ref_count);
+        aws_event_loop_schedule_task_future(
+            batch->loop, &batch->flush_task, batch->oldest_publish_ns + batch->max_delay_ns);
+    }
+
+    aws_mutex_unlock(&batch->lock);
+}
+
 static char s_client_string[] = "MQTT5 Client";
 
 /*******************************************************************************
@@ -1073,6 +1602,23 @@ static void s_aws_mqtt5_client_java_lifecycle_event(const struct aws_mqtt5_clien
         return;
     }
 
+    switch (event->event_type) {
+        case AWS_MQTT5_CLET_CONNECTION_SUCCESS:
+            if (aws_mqtt5_client_jni_metrics_add(
+                    &java_client->metrics, AWS_MQTT5_JNI_METRIC_CONNECTION_SUCCESSES, 1) > 0) {
+                aws_mqtt5_client_jni_metrics_add(&java_client->metrics, AWS_MQTT5_JNI_METRIC_RECONNECTS, 1);
+            }
+            break;
+        case AWS_MQTT5_CLET_CONNECTION_FAILURE:
+            aws_mqtt5_client_jni_metrics_add(&java_client->metrics, AWS_MQTT5_JNI_METRIC_CONNECTION_FAILURES, 1);
+            break;
+        case AWS_MQTT5_CLET_DISCONNECTION:
+            aws_mqtt5_client_jni_metrics_add(&java_client->metrics, AWS_MQTT5_JNI_METRIC_DISCONNECTIONS, 1);
+            break;
+        default:
+            break;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JavaVM *jvm = java_client->jvm;
     JNIEnv *env = aws_jni_acquire_thread_env(jvm);
@@ -1082,6 +1628,13 @@ static void s_aws_mqtt5_client_java_lifecycle_event(const struct aws_mqtt5_clien
         return;
     }
 
+    /* Publishes received before the event are delivered before it */
+    if (java_client->publish_batch) {
+        aws_mutex_lock(&java_client->publish_batch->lock);
+        s_aws_mqtt5_client_java_publish_batch_flush_synced(java_client->publish_batch, env);
+        aws_mutex_unlock(&java_client->publish_batch->lock);
+    }
+
     /* Calculate the number of references needed (1 is always needed for the return struct) */
     size_t references_needed = 1;
     if (event->connack_data != NULL) {
@@ -1165,6 +1718,9 @@ static void s_aws_mqtt5_client_java_lifecycle_event(const struct aws_mqtt5_clien
         goto clean_up;
     }
 
+    uint64_t callback_start_ns = 0;
+    aws_high_res_clock_get_ticks(&callback_start_ns);
+
     jobject java_lifecycle_return_data;
 
     switch (event->event_type) {
@@ -1270,6 +1826,8 @@ static void s_aws_mqtt5_client_java_lifecycle_event(const struct aws_mqtt5_clien
             AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "LifecycleEvent: unsupported event type: %i", event->event_type);
     }
 
+    aws_mqtt5_client_jni_metrics_record_since(
+        &java_client->metrics, AWS_MQTT5_JNI_LATENCY_JNI_CALLBACK, callback_start_ns);
     goto clean_up;
 
 clean_up:
@@ -1281,52 +1839,23 @@ clean_up:
     aws_jni_release_thread_env(jvm, env);
 }
 
-static void s_aws_mqtt5_client_java_publish_received(
+/* Builds the PublishReturn for a received publish and hands it to each handler in turn */
+static void s_aws_mqtt5_client_java_deliver_publish(
+    JNIEnv *env,
+    struct aws_mqtt5_client_java_jni *java_client,
     const struct aws_mqtt5_packet_publish_view *publish,
-    void *user_data) {
-
-    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)user_data;
-    if (!java_client) {
-        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: invalid client");
-        return;
-    }
-
-    if (!publish) {
-        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: invalid publish packet");
-        return;
-    }
-
-    /********** JNI ENV ACQUIRE **********/
-    JavaVM *jvm = java_client->jvm;
-    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
-    if (env == NULL) {
-        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
-        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: could not get env");
-        return;
-    }
+    const jobject *handlers,
+    size_t handler_count) {
 
     /* Calculate the number of references needed */
     size_t references_needed = 0;
-    {
+    if (java_client->direct_publish_delivery) {
+        /* The PublishReturn and the two direct buffers it wraps */
+        references_needed += 3;
+    } else {
         /* One reference is needed for the PublishReturn */
         references_needed += 1;
-
-        /* A Publish packet will need 5 references at minimum */
-        references_needed += 5;
-        /* Optionals */
-        s_aws_count_allocation(publish->content_type, &references_needed);
-        s_aws_count_allocation(publish->correlation_data, &references_needed);
-        s_aws_count_allocation(publish->message_expiry_interval_seconds, &references_needed);
-        s_aws_count_allocation(publish->response_topic, &references_needed);
-        s_aws_count_allocation(publish->topic_alias, &references_needed);
-        s_aws_count_allocation(publish->payload_format, &references_needed);
-        /* Add user properties and subscription identifiers */
-        references_needed += publish->user_property_count * 2;
-        references_needed += 1; /* Add 1 for array to hold user properties */
-        if (publish->subscription_identifier_count > 0) {
-            references_needed += publish->subscription_identifier_count;
-            references_needed += 1; /* Add 1 for array */
-        }
+        references_needed += s_aws_mqtt5_publish_packet_reference_count(publish);
     }
 
     /**
@@ -1344,34 +1873,126 @@ static void s_aws_mqtt5_client_java_publish_received(
     /* The return result */
     jobject publish_packet_return_data;
 
-    /* Make the PublishPacket */
-    jobject publish_packet_data = s_aws_mqtt5_client_create_jni_publish_packet_from_native(env, publish);
-    if (publish_packet_data == NULL) {
-        goto clean_up;
-    }
+    if (java_client->direct_publish_delivery) {
+        publish_packet_return_data = s_aws_mqtt5_client_create_jni_direct_publish_return_from_native(env, publish);
+        if (publish_packet_return_data == NULL) {
+            goto clean_up;
+        }
+    } else {
+        /* Make the PublishPacket */
+        jobject publish_packet_data = s_aws_mqtt5_client_create_jni_publish_packet_from_native(env, publish);
+        if (publish_packet_data == NULL) {
+            goto clean_up;
+        }
 
-    /* Make the PublishReturn struct that will hold all of the data that is passed to Java */
-    publish_packet_return_data = (*env)->NewObject(
-        env,
-        mqtt5_publish_return_properties.return_class,
-        mqtt5_publish_return_properties.return_constructor_id,
-        publish_packet_data);
-    aws_jni_check_and_clear_exception(env); // To hide JNI warning
+        /* Make the PublishReturn struct that will hold all of the data that is passed to Java */
+        publish_packet_return_data = (*env)->NewObject(
+            env,
+            mqtt5_publish_return_properties.return_class,
+            mqtt5_publish_return_properties.return_constructor_id,
+            publish_packet_data);
+        aws_jni_check_and_clear_exception(env); // To hide JNI warning
+    }
 
-    if (java_client->jni_publish_events) {
+    uint64_t callback_start_ns = 0;
+    aws_high_res_clock_get_ticks(&callback_start_ns);
+    for (size_t i = 0; i < handler_count; ++i) {
         (*env)->CallObjectMethod(
             env,
-            java_client->jni_publish_events,
+            handlers[i],
             mqtt5_publish_events_properties.publish_events_publish_received_id,
             java_client->jni_client,
             publish_packet_return_data);
         aws_jni_check_and_clear_exception(env); // To hide JNI warning
     }
+    aws_mqtt5_client_jni_metrics_record_since(
+        &java_client->metrics, AWS_MQTT5_JNI_LATENCY_JNI_CALLBACK, callback_start_ns);
+
+    if (java_client->direct_publish_delivery) {
+        /* The publish view goes away when we return, so stop the PublishReturn from reaching into it */
+        (*env)->SetLongField(
+            env, publish_packet_return_data, mqtt5_publish_return_properties.native_publish_view_field_id, (jlong)0);
+    }
     goto clean_up;
 
 clean_up:
 
     (*env)->PopLocalFrame(env, NULL);
+}
+
+static void s_aws_mqtt5_client_java_publish_received(
+    const struct aws_mqtt5_packet_publish_view *publish,
+    void *user_data) {
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)user_data;
+    if (!java_client) {
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: invalid client");
+        return;
+    }
+
+    if (!publish) {
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: invalid publish packet");
+        return;
+    }
+
+    aws_mqtt5_client_jni_metrics_add(&java_client->metrics, AWS_MQTT5_JNI_METRIC_PUBLISHES_IN, 1);
+    aws_mqtt5_client_jni_metrics_add(
+        &java_client->metrics, AWS_MQTT5_JNI_METRIC_BYTES_IN, publish->topic.len + publish->payload.len);
+
+    bool has_routes = aws_mqtt5_topic_router_has_routes(java_client->topic_router);
+    if (!has_routes) {
+        if (!java_client->jni_publish_events) {
+            /* Nobody is listening, so don't build anything for Java */
+            return;
+        }
+
+        if (java_client->publish_batch) {
+            /* Delivered to Java from the batch flush instead, so no JNIEnv is needed per publish */
+            s_aws_mqtt5_client_java_publish_batch_add(java_client->publish_batch, publish);
+            return;
+        }
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = java_client->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: could not get env");
+        return;
+    }
+
+    if (!has_routes) {
+        s_aws_mqtt5_client_java_deliver_publish(env, java_client, publish, &java_client->jni_publish_events, 1);
+    } else {
+        /* Publishes matching a topic handler go only to those handlers, everything else falls back to publish events */
+        struct aws_array_list matched_handlers;
+        aws_array_list_init_dynamic(&matched_handlers, aws_jni_get_allocator(), 0, sizeof(jobject));
+        size_t matched_count =
+            aws_mqtt5_topic_router_match(java_client->topic_router, env, publish->topic, &matched_handlers);
+
+        if (matched_count > 0) {
+            s_aws_mqtt5_client_java_deliver_publish(env, java_client, publish, matched_handlers.data, matched_count);
+        } else if (!java_client->jni_publish_events) {
+            AWS_LOGF_TRACE(
+                AWS_LS_MQTT_CLIENT,
+                "java_client=%p: Dropping publish on topic " PRInSTR " with no interested handler",
+                (void *)java_client,
+                AWS_BYTE_CURSOR_PRI(publish->topic));
+        } else if (java_client->publish_batch) {
+            s_aws_mqtt5_client_java_publish_batch_add(java_client->publish_batch, publish);
+        } else {
+            s_aws_mqtt5_client_java_deliver_publish(env, java_client, publish, &java_client->jni_publish_events, 1);
+        }
+
+        for (size_t i = 0; i < matched_count; ++i) {
+            jobject handler = NULL;
+            aws_array_list_get_at(&matched_handlers, &handler, i);
+            (*env)->DeleteLocalRef(env, handler);
+        }
+        aws_array_list_clean_up(&matched_handlers);
+    }
+
     /********** JNI ENV RELEASE **********/
     aws_jni_release_thread_env(jvm, env);
 }
@@ -1392,6 +2013,15 @@ static void s_aws_mqtt5_client_java_publish_callback_destructor(
     }
 }
 
+static void s_aws_mqtt5_client_java_record_publish_out(
+    struct aws_mqtt5_client_java_jni *java_client,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+
+    aws_mqtt5_client_jni_metrics_add(&java_client->metrics, AWS_MQTT5_JNI_METRIC_PUBLISHES_OUT, 1);
+    aws_mqtt5_client_jni_metrics_add(
+        &java_client->metrics, AWS_MQTT5_JNI_METRIC_BYTES_OUT, publish->topic.len + publish->payload.len);
+}
+
 static void s_aws_mqtt5_client_java_publish_completion(
     enum aws_mqtt5_packet_type packet_type,
     const void *packet,
@@ -1414,6 +2044,11 @@ static void s_aws_mqtt5_client_java_publish_completion(
         goto clean_up;
     }
 
+    if (error_code == AWS_ERROR_SUCCESS && packet_type == AWS_MQTT5_PT_PUBACK) {
+        aws_mqtt5_client_jni_metrics_record_since(
+            &java_client->metrics, AWS_MQTT5_JNI_LATENCY_PUBLISH_TO_PUBACK, return_data->submit_timestamp_ns);
+    }
+
     /********** JNI ENV ACQUIRE **********/
     jvm = java_client->jvm;
     env = aws_jni_acquire_thread_env(jvm);
@@ -1495,8 +2130,12 @@ static void s_aws_mqtt5_client_java_publish_completion(
     }
 
     /* Complete the future */
+    uint64_t callback_start_ns = 0;
+    aws_high_res_clock_get_ticks(&callback_start_ns);
     (*env)->CallBooleanMethod(
         env, jni_publish_future, completable_future_properties.complete_method_id, publish_packet_result_data);
+    aws_mqtt5_client_jni_metrics_record_since(
+        &java_client->metrics, AWS_MQTT5_JNI_LATENCY_JNI_CALLBACK, callback_start_ns);
     if (aws_jni_check_and_clear_exception(env)) {
         AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "PublishCompletion function: exception when completing future");
         goto exception;
@@ -1835,6 +2474,12 @@ static void s_aws_mqtt5_client_java_termination(void *complete_ctx) {
         return;
     }
 
+    if (java_client->publish_batch) {
+        aws_mutex_lock(&java_client->publish_batch->lock);
+        s_aws_mqtt5_client_java_publish_batch_flush_synced(java_client->publish_batch, env);
+        aws_mutex_unlock(&java_client->publish_batch->lock);
+    }
+
     (*env)->CallVoidMethod(env, java_client->jni_client, crt_resource_properties.release_references);
 
     struct aws_allocator *allocator = aws_jni_get_allocator();
@@ -1969,12 +2614,15 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
     }
 
     return_data->jni_publish_future = (*env)->NewGlobalRef(env, jni_publish_future);
+    aws_high_res_clock_get_ticks(&return_data->submit_timestamp_ns);
     int return_result = aws_mqtt5_client_publish(
         java_client->client, aws_mqtt5_packet_publish_view_get_packet(java_publish_packet), &completion_options);
     if (return_result != AWS_OP_SUCCESS) {
         s_aws_mqtt5_client_log_and_throw_exception(env, "Mqtt5Client.publish: Unsuccessful publish", return_result);
         goto exception;
     }
+    s_aws_mqtt5_client_java_record_publish_out(
+        java_client, aws_mqtt5_packet_publish_view_get_packet(java_publish_packet));
     goto clean_up;
 
 exception:
@@ -1987,6 +2635,361 @@ clean_up:
     aws_mqtt5_packet_publish_view_java_destroy(env, allocator, java_publish_packet);
 }
 
+/*
+ * Publishes from the compact form written by PublishPacketSerializer, read straight out of a direct buffer. Nothing is
+ * read from Java objects, and the native client copies the packet before this returns so the buffer can be reused
+ * right away.
+ */
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalPublishSerialized(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jobject jni_serialized_publish,
+    jint jni_offset,
+    jint jni_length,
+    jobject jni_publish_future) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishSerialized: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!java_client->client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishSerialized: Invalid/null native client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!jni_publish_future) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishSerialized: Invalid/null publish future", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    uint8_t *serialized_bytes =
+        jni_serialized_publish ? (*env)->GetDirectBufferAddress(env, jni_serialized_publish) : NULL;
+    if (serialized_bytes == NULL || jni_offset < 0 || jni_length < 0 ||
+        (jlong)jni_offset + jni_length > (*env)->GetDirectBufferCapacity(env, jni_serialized_publish)) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishSerialized: Invalid serialized publish buffer", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+
+    struct aws_mqtt5_packet_publish_view_serialized serialized_packet;
+    if (aws_mqtt5_packet_publish_view_serialized_init(
+            &serialized_packet,
+            allocator,
+            aws_byte_cursor_from_array(serialized_bytes + jni_offset, (size_t)jni_length))) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishSerialized: Malformed serialized publish packet", aws_last_error());
+        return;
+    }
+
+    /* Cannot fail */
+    struct aws_mqtt5_client_publish_return_data *return_data =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_client_publish_return_data));
+    return_data->java_client = java_client;
+    return_data->jni_publish_future = (*env)->NewGlobalRef(env, jni_publish_future);
+
+    struct aws_mqtt5_publish_completion_options completion_options;
+    completion_options.completion_callback = &s_aws_mqtt5_client_java_publish_completion;
+    completion_options.completion_user_data = (void *)return_data;
+
+    aws_high_res_clock_get_ticks(&return_data->submit_timestamp_ns);
+    int return_result = aws_mqtt5_client_publish(java_client->client, &serialized_packet.packet, &completion_options);
+    if (return_result == AWS_OP_SUCCESS) {
+        s_aws_mqtt5_client_java_record_publish_out(java_client, &serialized_packet.packet);
+    }
+    aws_mqtt5_packet_publish_view_serialized_clean_up(&serialized_packet, allocator);
+    if (return_result != AWS_OP_SUCCESS) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishSerialized: Unsuccessful publish", return_result);
+        s_complete_future_with_exception(env, jni_publish_future, AWS_ERROR_MQTT5_OPERATION_PROCESSING_FAILURE);
+        s_aws_mqtt5_client_java_publish_callback_destructor(env, return_data);
+    }
+}
+
+static struct aws_mqtt5_client_publish_batch_return_data *s_aws_mqtt5_client_publish_batch_new(
+    struct aws_mqtt5_client_java_jni *java_client,
+    size_t publish_count) {
+
+    struct aws_mqtt5_client_publish_batch_return_data *batch = NULL;
+    struct aws_mqtt5_client_publish_batch_entry *entries = NULL;
+    jint *error_codes = NULL;
+    jint *reason_codes = NULL;
+    /* Cannot fail */
+    aws_mem_acquire_many(
+        aws_jni_get_allocator(),
+        4,
+        &batch,
+        sizeof(struct aws_mqtt5_client_publish_batch_return_data),
+        &entries,
+        publish_count * sizeof(struct aws_mqtt5_client_publish_batch_entry),
+        &error_codes,
+        publish_count * sizeof(jint),
+        &reason_codes,
+        publish_count * sizeof(jint));
+
+    AWS_ZERO_STRUCT(*batch);
+    batch->java_client = java_client;
+    batch->publish_count = publish_count;
+    batch->entries = entries;
+    batch->error_codes = error_codes;
+    batch->reason_codes = reason_codes;
+    aws_atomic_init_int(&batch->outstanding, publish_count + 1);
+    for (size_t i = 0; i < publish_count; ++i) {
+        entries[i].batch = batch;
+        entries[i].index = i;
+        error_codes[i] = AWS_ERROR_SUCCESS;
+        reason_codes[i] = -1;
+    }
+
+    return batch;
+}
+
+/* Completes the batch future with the per-publish results and frees the batch */
+static void s_aws_mqtt5_client_publish_batch_finish(
+    JNIEnv *env,
+    struct aws_mqtt5_client_publish_batch_return_data *batch) {
+
+    jsize publish_count = (jsize)batch->publish_count;
+    jintArray jni_error_codes = (*env)->NewIntArray(env, publish_count);
+    jintArray jni_reason_codes = (*env)->NewIntArray(env, publish_count);
+    if (jni_error_codes == NULL || jni_reason_codes == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        s_complete_future_with_exception(env, batch->jni_batch_future, AWS_ERROR_OOM);
+        goto clean_up;
+    }
+    (*env)->SetIntArrayRegion(env, jni_error_codes, 0, publish_count, batch->error_codes);
+    (*env)->SetIntArrayRegion(env, jni_reason_codes, 0, publish_count, batch->reason_codes);
+
+    jobject jni_result = (*env)->NewObject(
+        env,
+        mqtt5_publish_batch_result_properties.result_class,
+        mqtt5_publish_batch_result_properties.result_constructor_id,
+        jni_error_codes,
+        jni_reason_codes);
+    if (jni_result == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        s_complete_future_with_exception(env, batch->jni_batch_future, AWS_ERROR_INVALID_STATE);
+        goto clean_up;
+    }
+
+    uint64_t callback_start_ns = 0;
+    aws_high_res_clock_get_ticks(&callback_start_ns);
+    (*env)->CallBooleanMethod(
+        env, batch->jni_batch_future, completable_future_properties.complete_method_id, jni_result);
+    aws_mqtt5_client_jni_metrics_record_since(
+        &batch->java_client->metrics, AWS_MQTT5_JNI_LATENCY_JNI_CALLBACK, callback_start_ns);
+    aws_jni_check_and_clear_exception(env);
+    (*env)->DeleteLocalRef(env, jni_result);
+
+clean_up:
+    if (jni_error_codes != NULL) {
+        (*env)->DeleteLocalRef(env, jni_error_codes);
+    }
+    if (jni_reason_codes != NULL) {
+        (*env)->DeleteLocalRef(env, jni_reason_codes);
+    }
+    (*env)->DeleteGlobalRef(env, batch->jni_batch_future);
+    aws_mem_release(aws_jni_get_allocator(), batch);
+}
+
+/* Drops one count from the batch, returns true if the caller dropped the last one and must finish it */
+static bool s_aws_mqtt5_client_publish_batch_release(struct aws_mqtt5_client_publish_batch_return_data *batch) {
+    return aws_atomic_fetch_sub(&batch->outstanding, 1) == 1;
+}
+
+static void s_aws_mqtt5_client_java_publish_batch_completion(
+    enum aws_mqtt5_packet_type packet_type,
+    const void *packet,
+    int error_code,
+    void *user_data) {
+
+    struct aws_mqtt5_client_publish_batch_entry *entry = user_data;
+    struct aws_mqtt5_client_publish_batch_return_data *batch = entry->batch;
+
+    batch->error_codes[entry->index] = error_code;
+    if (error_code == AWS_ERROR_SUCCESS && packet_type == AWS_MQTT5_PT_PUBACK && packet != NULL) {
+        const struct aws_mqtt5_packet_puback_view *puback_packet = packet;
+        batch->reason_codes[entry->index] = (jint)puback_packet->reason_code;
+        aws_mqtt5_client_jni_metrics_record_since(
+            &batch->java_client->metrics, AWS_MQTT5_JNI_LATENCY_PUBLISH_TO_PUBACK, batch->submit_timestamp_ns);
+    }
+
+    if (!s_aws_mqtt5_client_publish_batch_release(batch)) {
+        return;
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = batch->java_client->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "PublishBatchCompletion function: could not get env");
+        aws_mem_release(aws_jni_get_allocator(), batch);
+        return;
+    }
+
+    s_aws_mqtt5_client_publish_batch_finish(env, batch);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+/*
+ * Submits every publish of the batch with a single JNI call and one allocation. A publish the client rejects up front
+ * is recorded in the results rather than failing the batch, so the future always completes with one result per
+ * publish once they have all completed.
+ */
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalPublishBatch(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jobjectArray jni_publish_packets,
+    jobject jni_batch_future) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishBatch: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!java_client->client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishBatch: Invalid/null native client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!jni_publish_packets) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishBatch: Invalid/null publish packets", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!jni_batch_future) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishBatch: Invalid/null publish future", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    size_t publish_count = (size_t)(*env)->GetArrayLength(env, jni_publish_packets);
+
+    struct aws_mqtt5_client_publish_batch_return_data *batch =
+        s_aws_mqtt5_client_publish_batch_new(java_client, publish_count);
+    batch->jni_batch_future = (*env)->NewGlobalRef(env, jni_batch_future);
+    aws_high_res_clock_get_ticks(&batch->submit_timestamp_ns);
+
+    for (size_t i = 0; i < publish_count; ++i) {
+        struct aws_mqtt5_client_publish_batch_entry *entry = &batch->entries[i];
+
+        jobject jni_publish_packet = (*env)->GetObjectArrayElement(env, jni_publish_packets, (jsize)i);
+        struct aws_mqtt5_packet_publish_view_java_jni *java_publish_packet =
+            jni_publish_packet ? aws_mqtt5_packet_publish_view_create_from_java(env, allocator, jni_publish_packet)
+                               : NULL;
+        if (jni_publish_packet != NULL) {
+            (*env)->DeleteLocalRef(env, jni_publish_packet);
+        }
+
+        int error_code = AWS_ERROR_SUCCESS;
+        if (java_publish_packet == NULL) {
+            /* The packet conversion threw, the failure is reported in the batch results instead */
+            aws_jni_check_and_clear_exception(env);
+            error_code = AWS_ERROR_INVALID_ARGUMENT;
+        } else {
+            struct aws_mqtt5_publish_completion_options completion_options = {
+                .completion_callback = &s_aws_mqtt5_client_java_publish_batch_completion,
+                .completion_user_data = entry,
+            };
+            const struct aws_mqtt5_packet_publish_view *publish_view =
+                aws_mqtt5_packet_publish_view_get_packet(java_publish_packet);
+            if (aws_mqtt5_client_publish(java_client->client, publish_view, &completion_options)) {
+                error_code = aws_last_error();
+            } else {
+                s_aws_mqtt5_client_java_record_publish_out(java_client, publish_view);
+            }
+            aws_mqtt5_packet_publish_view_java_destroy(env, allocator, java_publish_packet);
+        }
+
+        if (error_code != AWS_ERROR_SUCCESS) {
+            /* Rejected up front, the completion callback won't fire for this one */
+            batch->error_codes[i] = error_code;
+            s_aws_mqtt5_client_publish_batch_release(batch);
+        }
+    }
+
+    /* Drop the submission count, the last publish may already have completed */
+    if (s_aws_mqtt5_client_publish_batch_release(batch)) {
+        s_aws_mqtt5_client_publish_batch_finish(env, batch);
+    }
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalAddTopicHandler(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jstring jni_topic_filter,
+    jobject jni_handler) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client || !java_client->topic_router) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.addTopicHandler: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!jni_topic_filter || !jni_handler) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.addTopicHandler: Invalid/null topic filter or handler", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    struct aws_byte_cursor topic_filter = aws_jni_byte_cursor_from_jstring_acquire(env, jni_topic_filter);
+    if (topic_filter.ptr == NULL) {
+        /* An exception is already pending */
+        return;
+    }
+
+    if (aws_mqtt5_topic_router_add(java_client->topic_router, env, topic_filter, jni_handler)) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.addTopicHandler: Invalid topic filter", aws_last_error());
+    }
+
+    aws_jni_byte_cursor_from_jstring_release(env, jni_topic_filter, topic_filter);
+}
+
+JNIEXPORT jboolean JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalRemoveTopicHandler(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jstring jni_topic_filter,
+    jobject jni_handler) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client || !java_client->topic_router) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.removeTopicHandler: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return JNI_FALSE;
+    }
+    if (!jni_topic_filter || !jni_handler) {
+        return JNI_FALSE;
+    }
+
+    struct aws_byte_cursor topic_filter = aws_jni_byte_cursor_from_jstring_acquire(env, jni_topic_filter);
+    if (topic_filter.ptr == NULL) {
+        return JNI_FALSE;
+    }
+
+    bool removed = aws_mqtt5_topic_router_remove(java_client->topic_router, env, topic_filter, jni_handler);
+
+    aws_jni_byte_cursor_from_jstring_release(env, jni_topic_filter, topic_filter);
+    return removed ? JNI_TRUE : JNI_FALSE;
+}
+
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalSubscribe(
     JNIEnv *env,
     jclass jni_class,
@@ -2124,6 +3127,32 @@ clean_up:
     aws_mqtt5_packet_unsubscribe_view_java_destroy(env, allocator, java_unsubscribe_packet);
 }
 
+/* Allocation-free counterpart of getOperationStatistics, fills the caller's array in place */
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalFetchMetrics(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jlongArray jni_metrics) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.getMetrics: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!java_client->client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.getMetrics: Invalid/null native client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    struct aws_mqtt5_client_operation_statistics client_stats;
+    aws_mqtt5_client_get_stats(java_client->client, &client_stats);
+
+    aws_mqtt5_client_jni_metrics_fetch(env, &java_client->metrics, &client_stats, jni_metrics);
+}
+
 JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalGetOperationStatistics(
     JNIEnv *env,
     jclass jni_class,
@@ -2355,6 +3384,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5C
             env, "MQTT5 client new: could not initialize new client", AWS_ERROR_INVALID_STATE);
         return (jlong)NULL;
     }
+    aws_mqtt5_client_jni_metrics_init(&java_client->metrics);
 
     jstring jni_host_name = NULL;
     struct aws_byte_cursor *pointer_host_name = &client_options.host_name;
@@ -2677,6 +3707,32 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5C
         java_client->jni_publish_events = (*env)->NewGlobalRef(env, jni_publish_events);
     }
 
+    java_client->topic_router = aws_mqtt5_topic_router_new(allocator);
+
+    java_client->direct_publish_delivery = (*env)->GetBooleanField(
+        env, jni_options, mqtt5_client_options_properties.direct_publish_delivery_enabled_field_id);
+
+    jint publish_batch_max_messages = (*env)->GetIntField(
+        env, jni_options, mqtt5_client_options_properties.publish_batch_max_messages_field_id);
+    jlong publish_batch_max_delay_micros = (*env)->GetLongField(
+        env, jni_options, mqtt5_client_options_properties.publish_batch_max_delay_micros_field_id);
+    if (publish_batch_max_messages > 1) {
+        if (java_client->direct_publish_delivery) {
+            s_aws_mqtt5_client_log_and_throw_exception(
+                env,
+                "MQTT5 client new: publish batching cannot be combined with direct publish delivery",
+                AWS_ERROR_INVALID_ARGUMENT);
+            goto clean_up;
+        }
+        java_client->publish_batch = s_aws_mqtt5_client_java_publish_batch_new(
+            allocator,
+            java_client,
+            bootstrap->event_loop_group,
+            (size_t)publish_batch_max_messages,
+            aws_timestamp_convert(
+                (uint64_t)publish_batch_max_delay_micros, AWS_TIMESTAMP_MICROS, AWS_TIMESTAMP_NANOS, NULL));
+    }
+
     jobject jni_lifecycle_events =
         (*env)->GetObjectField(env, jni_options, mqtt5_client_options_properties.lifecycle_events_field_id);
     if (aws_jni_check_and_clear_exception(env)) {
@@ -2719,6 +3775,32 @@ clean_up:
     return (jlong)NULL;
 }
 
+JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_mqtt5_PublishReturn_publishReturnMaterializePacket(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_publish_view) {
+    (void)jni_class;
+
+    const struct aws_mqtt5_packet_publish_view *publish =
+        (const struct aws_mqtt5_packet_publish_view *)jni_publish_view;
+    if (!publish) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "PublishReturn materialize packet: Invalid/null publish view", AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    jint local_frame_result = (*env)->PushLocalFrame(env, (jint)s_aws_mqtt5_publish_packet_reference_count(publish));
+    if (local_frame_result != 0) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "PublishReturn materialize packet: could not push local JNI frame", AWS_ERROR_INVALID_STATE);
+        return NULL;
+    }
+
+    jobject publish_packet_data = s_aws_mqtt5_client_create_jni_publish_packet_from_native(env, publish);
+
+    return (*env)->PopLocalFrame(env, publish_packet_data);
+}
+
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientDestroy(
     JNIEnv *env,
     jclass jni_class,
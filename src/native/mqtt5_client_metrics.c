@@ -0,0 +1,81 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "mqtt5_client_metrics.h"
+
+#include "crt.h"
+
+#include <aws/common/clock.h>
+#include <aws/mqtt/v5/mqtt5_client.h>
+
+void aws_mqtt5_client_jni_metrics_init(struct aws_mqtt5_client_jni_metrics *metrics) {
+    for (size_t metric = 0; metric < AWS_MQTT5_JNI_METRIC_COUNT; ++metric) {
+        aws_atomic_init_int(&metrics->counters[metric], 0);
+    }
+    for (size_t latency = 0; latency < AWS_MQTT5_JNI_LATENCY_COUNT; ++latency) {
+        aws_jni_latency_histogram_init(&metrics->latencies[latency]);
+    }
+}
+
+uint64_t aws_mqtt5_client_jni_metrics_add(
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    enum aws_mqtt5_jni_metric metric,
+    uint64_t amount) {
+
+    AWS_ASSERT(metric < AWS_MQTT5_JNI_METRIC_COUNT);
+    return (uint64_t)aws_atomic_fetch_add(&metrics->counters[metric], (size_t)amount);
+}
+
+void aws_mqtt5_client_jni_metrics_record_latency(
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    enum aws_mqtt5_jni_latency latency,
+    uint64_t duration_ns) {
+
+    AWS_ASSERT(latency < AWS_MQTT5_JNI_LATENCY_COUNT);
+    aws_jni_latency_histogram_record(&metrics->latencies[latency], duration_ns);
+}
+
+void aws_mqtt5_client_jni_metrics_record_since(
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    enum aws_mqtt5_jni_latency latency,
+    uint64_t start_ns) {
+
+    uint64_t now_ns = 0;
+    if (start_ns == 0 || aws_high_res_clock_get_ticks(&now_ns) || now_ns < start_ns) {
+        return;
+    }
+    aws_mqtt5_client_jni_metrics_record_latency(metrics, latency, now_ns - start_ns);
+}
+
+void aws_mqtt5_client_jni_metrics_fetch(
+    JNIEnv *env,
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    const struct aws_mqtt5_client_operation_statistics *operation_statistics,
+    jlongArray java_metrics) {
+
+    if (java_metrics == NULL || (*env)->GetArrayLength(env, java_metrics) != AWS_MQTT5_JNI_METRICS_LENGTH) {
+        aws_jni_throw_illegal_argument_exception(env, "Metrics array has the wrong length");
+        return;
+    }
+
+    jlong values[AWS_MQTT5_JNI_METRICS_LENGTH];
+    size_t index = 0;
+    for (size_t metric = 0; metric < AWS_MQTT5_JNI_METRIC_COUNT; ++metric) {
+        values[index++] = (jlong)aws_atomic_load_int(&metrics->counters[metric]);
+    }
+
+    values[index++] = (jlong)operation_statistics->incomplete_operation_count;
+    values[index++] = (jlong)operation_statistics->incomplete_operation_size;
+    values[index++] = (jlong)operation_statistics->unacked_operation_count;
+    values[index++] = (jlong)operation_statistics->unacked_operation_size;
+
+    for (size_t latency = 0; latency < AWS_MQTT5_JNI_LATENCY_COUNT; ++latency) {
+        aws_jni_latency_histogram_load(&metrics->latencies[latency], &values[index]);
+        index += AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT;
+    }
+    AWS_FATAL_ASSERT(index == AWS_MQTT5_JNI_METRICS_LENGTH);
+
+    (*env)->SetLongArrayRegion(env, java_metrics, 0, AWS_MQTT5_JNI_METRICS_LENGTH, values);
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_MQTT5_CLIENT_METRICS_H
+#define AWS_JNI_CRT_MQTT5_CLIENT_METRICS_H
+
+#include <jni.h>
+
+#include <aws/common/atomics.h>
+
+#include "latency_histogram.h"
+
+struct aws_mqtt5_client_operation_statistics;
+
+/*
+ * Counters, in the order they are written to the Java array. Must stay in sync with Mqtt5ClientMetrics.java.
+ * Atomics are 32 bits wide on 32-bit platforms, where the byte counters wrap at 4 GiB.
+ */
+enum aws_mqtt5_jni_metric {
+    AWS_MQTT5_JNI_METRIC_PUBLISHES_OUT,
+    AWS_MQTT5_JNI_METRIC_PUBLISHES_IN,
+    AWS_MQTT5_JNI_METRIC_BYTES_OUT,
+    AWS_MQTT5_JNI_METRIC_BYTES_IN,
+    AWS_MQTT5_JNI_METRIC_CONNECTION_SUCCESSES,
+    AWS_MQTT5_JNI_METRIC_CONNECTION_FAILURES,
+    AWS_MQTT5_JNI_METRIC_DISCONNECTIONS,
+    AWS_MQTT5_JNI_METRIC_RECONNECTS,
+
+    AWS_MQTT5_JNI_METRIC_COUNT,
+};
+
+/* Operation queue statistics from aws_mqtt5_client_get_stats, written after the counters */
+#define AWS_MQTT5_JNI_OPERATION_STATISTIC_COUNT 4
+
+enum aws_mqtt5_jni_latency {
+    AWS_MQTT5_JNI_LATENCY_PUBLISH_TO_PUBACK,
+    AWS_MQTT5_JNI_LATENCY_JNI_CALLBACK,
+
+    AWS_MQTT5_JNI_LATENCY_COUNT,
+};
+
+#define AWS_MQTT5_JNI_METRICS_LENGTH                                                                                   \
+    (AWS_MQTT5_JNI_METRIC_COUNT + AWS_MQTT5_JNI_OPERATION_STATISTIC_COUNT +                                            \
+     AWS_MQTT5_JNI_LATENCY_COUNT * AWS_JNI_LATENCY_HISTOGRAM_BUCKET_COUNT)
+
+/* Client metrics, updated lock-free from any thread */
+struct aws_mqtt5_client_jni_metrics {
+    struct aws_atomic_var counters[AWS_MQTT5_JNI_METRIC_COUNT];
+    struct aws_jni_latency_histogram latencies[AWS_MQTT5_JNI_LATENCY_COUNT];
+};
+
+void aws_mqtt5_client_jni_metrics_init(struct aws_mqtt5_client_jni_metrics *metrics);
+
+/* Adds to a counter and returns its previous value */
+uint64_t aws_mqtt5_client_jni_metrics_add(
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    enum aws_mqtt5_jni_metric metric,
+    uint64_t amount);
+
+void aws_mqtt5_client_jni_metrics_record_latency(
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    enum aws_mqtt5_jni_latency latency,
+    uint64_t duration_ns);
+
+/* Records the time since start_ns, as read from aws_high_res_clock_get_ticks */
+void aws_mqtt5_client_jni_metrics_record_since(
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    enum aws_mqtt5_jni_latency latency,
+    uint64_t start_ns);
+
+/*
+ * Writes the counters, the operation statistics and every latency bucket into a Java long[] of
+ * AWS_MQTT5_JNI_METRICS_LENGTH entries without allocating. Throws IllegalArgumentException if the array has the
+ * wrong length.
+ */
+void aws_mqtt5_client_jni_metrics_fetch(
+    JNIEnv *env,
+    struct aws_mqtt5_client_jni_metrics *metrics,
+    const struct aws_mqtt5_client_operation_statistics *operation_statistics,
+    jlongArray java_metrics);
+
+#endif /* AWS_JNI_CRT_MQTT5_CLIENT_METRICS_H */
@@ -1206,6 +1206,135 @@ struct aws_mqtt5_packet_publish_view *aws_mqtt5_packet_publish_view_get_packet(
     }
 }
 
+/* Must stay in sync with PublishPacketSerializer.java */
+#define AWS_MQTT5_SERIALIZED_PUBLISH_VERSION 1
+
+enum aws_mqtt5_serialized_publish_flags {
+    AWS_MQTT5_SERIALIZED_PUBLISH_RETAIN = 1 << 0,
+    AWS_MQTT5_SERIALIZED_PUBLISH_HAS_PAYLOAD_FORMAT = 1 << 1,
+    AWS_MQTT5_SERIALIZED_PUBLISH_HAS_MESSAGE_EXPIRY = 1 << 2,
+    AWS_MQTT5_SERIALIZED_PUBLISH_HAS_RESPONSE_TOPIC = 1 << 3,
+    AWS_MQTT5_SERIALIZED_PUBLISH_HAS_CORRELATION_DATA = 1 << 4,
+    AWS_MQTT5_SERIALIZED_PUBLISH_HAS_CONTENT_TYPE = 1 << 5,
+};
+
+/* Reads a 16-bit big-endian length followed by that many bytes */
+static bool s_read_serialized_u16_prefixed(struct aws_byte_cursor *serialized, struct aws_byte_cursor *result) {
+    uint16_t length = 0;
+    if (!aws_byte_cursor_read_be16(serialized, &length) || serialized->len < length) {
+        return false;
+    }
+    *result = aws_byte_cursor_advance(serialized, length);
+    return true;
+}
+
+/*
+ * Layout, big-endian: u8 version, u8 qos, u8 flags, then u8 payload format and u32 message expiry when flagged,
+ * u16-prefixed topic, u16-prefixed response topic, correlation data and content type when flagged, u16 user property
+ * count followed by u16-prefixed name and value pairs, and finally a u32-prefixed payload.
+ */
+int aws_mqtt5_packet_publish_view_serialized_init(
+    struct aws_mqtt5_packet_publish_view_serialized *serialized_packet,
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor serialized) {
+
+    AWS_ZERO_STRUCT(*serialized_packet);
+    struct aws_mqtt5_packet_publish_view *packet = &serialized_packet->packet;
+
+    uint8_t version = 0;
+    uint8_t qos = 0;
+    uint8_t flags = 0;
+    if (!aws_byte_cursor_read_u8(&serialized, &version) || version != AWS_MQTT5_SERIALIZED_PUBLISH_VERSION ||
+        !aws_byte_cursor_read_u8(&serialized, &qos) || !aws_byte_cursor_read_u8(&serialized, &flags)) {
+        goto on_error;
+    }
+    packet->qos = (enum aws_mqtt5_qos)qos;
+    packet->retain = (flags & AWS_MQTT5_SERIALIZED_PUBLISH_RETAIN) != 0;
+
+    if (flags & AWS_MQTT5_SERIALIZED_PUBLISH_HAS_PAYLOAD_FORMAT) {
+        uint8_t payload_format = 0;
+        if (!aws_byte_cursor_read_u8(&serialized, &payload_format)) {
+            goto on_error;
+        }
+        serialized_packet->payload_format = (enum aws_mqtt5_payload_format_indicator)payload_format;
+        packet->payload_format = &serialized_packet->payload_format;
+    }
+
+    if (flags & AWS_MQTT5_SERIALIZED_PUBLISH_HAS_MESSAGE_EXPIRY) {
+        if (!aws_byte_cursor_read_be32(&serialized, &serialized_packet->message_expiry_interval_seconds)) {
+            goto on_error;
+        }
+        packet->message_expiry_interval_seconds = &serialized_packet->message_expiry_interval_seconds;
+    }
+
+    if (!s_read_serialized_u16_prefixed(&serialized, &packet->topic)) {
+        goto on_error;
+    }
+
+    if (flags & AWS_MQTT5_SERIALIZED_PUBLISH_HAS_RESPONSE_TOPIC) {
+        if (!s_read_serialized_u16_prefixed(&serialized, &serialized_packet->response_topic)) {
+            goto on_error;
+        }
+        packet->response_topic = &serialized_packet->response_topic;
+    }
+
+    if (flags & AWS_MQTT5_SERIALIZED_PUBLISH_HAS_CORRELATION_DATA) {
+        if (!s_read_serialized_u16_prefixed(&serialized, &serialized_packet->correlation_data)) {
+            goto on_error;
+        }
+        packet->correlation_data = &serialized_packet->correlation_data;
+    }
+
+    if (flags & AWS_MQTT5_SERIALIZED_PUBLISH_HAS_CONTENT_TYPE) {
+        if (!s_read_serialized_u16_prefixed(&serialized, &serialized_packet->content_type)) {
+            goto on_error;
+        }
+        packet->content_type = &serialized_packet->content_type;
+    }
+
+    uint16_t user_property_count = 0;
+    if (!aws_byte_cursor_read_be16(&serialized, &user_property_count)) {
+        goto on_error;
+    }
+    if (user_property_count > 0) {
+        struct aws_mqtt5_user_property *user_properties = serialized_packet->inline_user_properties;
+        if (user_property_count > AWS_MQTT5_SERIALIZED_PUBLISH_INLINE_USER_PROPERTIES) {
+            serialized_packet->allocated_user_properties =
+                aws_mem_calloc(allocator, user_property_count, sizeof(struct aws_mqtt5_user_property));
+            user_properties = serialized_packet->allocated_user_properties;
+        }
+        for (size_t i = 0; i < user_property_count; ++i) {
+            if (!s_read_serialized_u16_prefixed(&serialized, &user_properties[i].name) ||
+                !s_read_serialized_u16_prefixed(&serialized, &user_properties[i].value)) {
+                goto on_error;
+            }
+        }
+        packet->user_property_count = user_property_count;
+        packet->user_properties = user_properties;
+    }
+
+    uint32_t payload_length = 0;
+    if (!aws_byte_cursor_read_be32(&serialized, &payload_length) || serialized.len != payload_length) {
+        goto on_error;
+    }
+    packet->payload = aws_byte_cursor_advance(&serialized, payload_length);
+
+    return AWS_OP_SUCCESS;
+
+on_error:
+    aws_mqtt5_packet_publish_view_serialized_clean_up(serialized_packet, allocator);
+    return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+}
+
+void aws_mqtt5_packet_publish_view_serialized_clean_up(
+    struct aws_mqtt5_packet_publish_view_serialized *serialized_packet,
+    struct aws_allocator *allocator) {
+    if (serialized_packet->allocated_user_properties != NULL) {
+        aws_mem_release(allocator, serialized_packet->allocated_user_properties);
+        serialized_packet->allocated_user_properties = NULL;
+    }
+}
+
 /*******************************************************************************
  * SUBSCRIBE PACKET FUNCTIONS
  ******************************************************************************/
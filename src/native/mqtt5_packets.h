@@ -127,6 +127,39 @@ struct aws_mqtt5_packet_publish_view_java_jni *aws_mqtt5_packet_publish_view_cre
 struct aws_mqtt5_packet_publish_view *aws_mqtt5_packet_publish_view_get_packet(
     struct aws_mqtt5_packet_publish_view_java_jni *java_packet);
 
+/* User properties a serialized publish can carry without a heap allocation */
+#define AWS_MQTT5_SERIALIZED_PUBLISH_INLINE_USER_PROPERTIES 8
+
+/*
+ * A publish view decoded from the compact form written by PublishPacketSerializer.java. Every cursor points into the
+ * serialized bytes, which must outlive the view. Meant to live on the caller's stack for the length of one publish.
+ */
+struct aws_mqtt5_packet_publish_view_serialized {
+    struct aws_mqtt5_packet_publish_view packet;
+
+    enum aws_mqtt5_payload_format_indicator payload_format;
+    uint32_t message_expiry_interval_seconds;
+    struct aws_byte_cursor response_topic;
+    struct aws_byte_cursor correlation_data;
+    struct aws_byte_cursor content_type;
+    struct aws_mqtt5_user_property inline_user_properties[AWS_MQTT5_SERIALIZED_PUBLISH_INLINE_USER_PROPERTIES];
+    /* Only set when there are more user properties than fit inline */
+    struct aws_mqtt5_user_property *allocated_user_properties;
+};
+
+/*
+ * Decodes a serialized publish without touching any Java object. Raises AWS_ERROR_INVALID_ARGUMENT and returns
+ * AWS_OP_ERR if the bytes are malformed; the view needs no clean up in that case.
+ */
+int aws_mqtt5_packet_publish_view_serialized_init(
+    struct aws_mqtt5_packet_publish_view_serialized *serialized_packet,
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor serialized);
+
+void aws_mqtt5_packet_publish_view_serialized_clean_up(
+    struct aws_mqtt5_packet_publish_view_serialized *serialized_packet,
+    struct aws_allocator *allocator);
+
 void aws_mqtt5_packet_subscribe_view_java_destroy(
     JNIEnv *env,
     struct aws_allocator *allocator,
@@ -0,0 +1,357 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "mqtt5_topic_router.h"
+
+#include "crt.h"
+
+#include <aws/common/atomics.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/mutex.h>
+#include <aws/common/string.h>
+#include <aws/mqtt/mqtt.h>
+
+/* One level of the topic filter trie */
+struct aws_mqtt5_topic_router_node {
+    struct aws_mqtt5_topic_router_node *parent;
+
+    /* The level of the filter this node stands for, owned by the node and used as its key in the parent */
+    struct aws_string *segment;
+    struct aws_byte_cursor segment_cursor;
+
+    /* aws_byte_cursor * -> struct aws_mqtt5_topic_router_node *, only initialized once the node has a child */
+    struct aws_hash_table children;
+    bool children_initialized;
+
+    /* Global references of the handlers registered for the filter ending at this node */
+    struct aws_array_list handlers;
+};
+
+struct aws_mqtt5_topic_router {
+    struct aws_allocator *allocator;
+    struct aws_mutex lock;
+    struct aws_mqtt5_topic_router_node root;
+
+    /* Total handler registrations, read without the lock */
+    struct aws_atomic_var route_count;
+};
+
+static const struct aws_byte_cursor s_single_level_wildcard = AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("+");
+static const struct aws_byte_cursor s_multi_level_wildcard = AWS_BYTE_CUR_INIT_FROM_STRING_LITERAL("#");
+
+static void s_node_init(
+    struct aws_allocator *allocator,
+    struct aws_mqtt5_topic_router_node *node,
+    struct aws_mqtt5_topic_router_node *parent,
+    struct aws_byte_cursor segment) {
+
+    AWS_ZERO_STRUCT(*node);
+    node->parent = parent;
+    if (parent != NULL) {
+        node->segment = aws_string_new_from_cursor(allocator, &segment);
+        node->segment_cursor = aws_byte_cursor_from_string(node->segment);
+    }
+    /* Capacity 0 so a node without handlers, the common case for inner levels, allocates nothing */
+    aws_array_list_init_dynamic(&node->handlers, allocator, 0, sizeof(jobject));
+}
+
+static void s_node_clean_up(struct aws_allocator *allocator, struct aws_mqtt5_topic_router_node *node, JNIEnv *env);
+
+static int s_clean_up_child(void *context, struct aws_hash_element *element) {
+    void **args = context;
+    struct aws_allocator *allocator = args[0];
+    JNIEnv *env = args[1];
+    struct aws_mqtt5_topic_router_node *child = element->value;
+
+    s_node_clean_up(allocator, child, env);
+    aws_mem_release(allocator, child);
+    return AWS_COMMON_HASH_TABLE_ITER_CONTINUE;
+}
+
+static void s_node_clean_up(struct aws_allocator *allocator, struct aws_mqtt5_topic_router_node *node, JNIEnv *env) {
+    if (node->children_initialized) {
+        void *args[2] = {allocator, env};
+        aws_hash_table_foreach(&node->children, s_clean_up_child, args);
+        aws_hash_table_clean_up(&node->children);
+    }
+
+    size_t handler_count = aws_array_list_length(&node->handlers);
+    for (size_t i = 0; i < handler_count; ++i) {
+        jobject handler = NULL;
+        aws_array_list_get_at(&node->handlers, &handler, i);
+        if (env != NULL) {
+            (*env)->DeleteGlobalRef(env, handler);
+        }
+    }
+    aws_array_list_clean_up(&node->handlers);
+    aws_string_destroy(node->segment);
+}
+
+static struct aws_mqtt5_topic_router_node *s_node_find_child(
+    struct aws_mqtt5_topic_router_node *node,
+    const struct aws_byte_cursor *segment) {
+
+    if (!node->children_initialized) {
+        return NULL;
+    }
+
+    struct aws_hash_element *element = NULL;
+    aws_hash_table_find(&node->children, segment, &element);
+    return element != NULL ? element->value : NULL;
+}
+
+static struct aws_mqtt5_topic_router_node *s_node_find_or_add_child(
+    struct aws_allocator *allocator,
+    struct aws_mqtt5_topic_router_node *node,
+    struct aws_byte_cursor segment) {
+
+    struct aws_mqtt5_topic_router_node *child = s_node_find_child(node, &segment);
+    if (child != NULL) {
+        return child;
+    }
+
+    if (!node->children_initialized) {
+        if (aws_hash_table_init(
+                &node->children,
+                allocator,
+                1,
+                aws_hash_byte_cursor_ptr,
+                (aws_hash_callback_eq_fn *)aws_byte_cursor_eq,
+                NULL,
+                NULL)) {
+            return NULL;
+        }
+        node->children_initialized = true;
+    }
+
+    child = aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_topic_router_node));
+    s_node_init(allocator, child, node, segment);
+    if (aws_hash_table_put(&node->children, &child->segment_cursor, child, NULL)) {
+        s_node_clean_up(allocator, child, NULL);
+        aws_mem_release(allocator, child);
+        return NULL;
+    }
+
+    return child;
+}
+
+/* Frees nodes that no longer lead to any handler, walking up from a node that just lost one */
+static void s_node_prune(struct aws_allocator *allocator, struct aws_mqtt5_topic_router_node *node) {
+    while (node->parent != NULL && aws_array_list_length(&node->handlers) == 0 &&
+           (!node->children_initialized || aws_hash_table_get_entry_count(&node->children) == 0)) {
+        struct aws_mqtt5_topic_router_node *parent = node->parent;
+        aws_hash_table_remove(&parent->children, &node->segment_cursor, NULL, NULL);
+        s_node_clean_up(allocator, node, NULL);
+        aws_mem_release(allocator, node);
+        node = parent;
+    }
+}
+
+static size_t s_node_append_handlers(
+    struct aws_mqtt5_topic_router_node *node,
+    JNIEnv *env,
+    struct aws_array_list *matched_handlers) {
+
+    size_t appended = 0;
+    size_t handler_count = aws_array_list_length(&node->handlers);
+    for (size_t i = 0; i < handler_count; ++i) {
+        jobject handler = NULL;
+        aws_array_list_get_at(&node->handlers, &handler, i);
+        jobject local_handler = (*env)->NewLocalRef(env, handler);
+        if (local_handler == NULL) {
+            continue;
+        }
+        if (aws_array_list_push_back(matched_handlers, &local_handler)) {
+            (*env)->DeleteLocalRef(env, local_handler);
+            continue;
+        }
+        ++appended;
+    }
+    return appended;
+}
+
+/*
+ * Matches the levels of the topic after the one last_segment holds against the children of node. The split state is
+ * passed by value so each wildcard branch continues from the same level.
+ */
+static size_t s_node_match(
+    struct aws_mqtt5_topic_router_node *node,
+    JNIEnv *env,
+    const struct aws_byte_cursor *topic,
+    struct aws_byte_cursor last_segment,
+    bool is_first_level,
+    struct aws_array_list *matched_handlers) {
+
+    size_t appended = 0;
+    struct aws_byte_cursor segment = last_segment;
+    if (!aws_byte_cursor_next_split(topic, '/', &segment)) {
+        /* Every level matched, and "a/#" also matches "a" itself */
+        appended += s_node_append_handlers(node, env, matched_handlers);
+        struct aws_mqtt5_topic_router_node *multi_level = s_node_find_child(node, &s_multi_level_wildcard);
+        if (multi_level != NULL) {
+            appended += s_node_append_handlers(multi_level, env, matched_handlers);
+        }
+        return appended;
+    }
+
+    struct aws_mqtt5_topic_router_node *exact = s_node_find_child(node, &segment);
+    if (exact != NULL) {
+        appended += s_node_match(exact, env, topic, segment, false, matched_handlers);
+    }
+
+    /* Topics starting with $ are never matched by a wildcard in the first level */
+    if (is_first_level && segment.len > 0 && segment.ptr[0] == '$') {
+        return appended;
+    }
+
+    struct aws_mqtt5_topic_router_node *single_level = s_node_find_child(node, &s_single_level_wildcard);
+    if (single_level != NULL) {
+        appended += s_node_match(single_level, env, topic, segment, false, matched_handlers);
+    }
+
+    struct aws_mqtt5_topic_router_node *multi_level = s_node_find_child(node, &s_multi_level_wildcard);
+    if (multi_level != NULL) {
+        appended += s_node_append_handlers(multi_level, env, matched_handlers);
+    }
+
+    return appended;
+}
+
+struct aws_mqtt5_topic_router *aws_mqtt5_topic_router_new(struct aws_allocator *allocator) {
+    struct aws_mqtt5_topic_router *router = aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_topic_router));
+    AWS_FATAL_ASSERT(router);
+
+    router->allocator = allocator;
+    aws_mutex_init(&router->lock);
+    s_node_init(allocator, &router->root, NULL, aws_byte_cursor_from_c_str(""));
+    aws_atomic_init_int(&router->route_count, 0);
+
+    return router;
+}
+
+void aws_mqtt5_topic_router_destroy(struct aws_mqtt5_topic_router *router, JNIEnv *env) {
+    if (router == NULL) {
+        return;
+    }
+
+    s_node_clean_up(router->allocator, &router->root, env);
+    aws_mutex_clean_up(&router->lock);
+    aws_mem_release(router->allocator, router);
+}
+
+int aws_mqtt5_topic_router_add(
+    struct aws_mqtt5_topic_router *router,
+    JNIEnv *env,
+    struct aws_byte_cursor topic_filter,
+    jobject handler) {
+
+    if (handler == NULL || !aws_mqtt_is_valid_topic_filter(&topic_filter)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    int result = AWS_OP_ERR;
+    struct aws_mqtt5_topic_router_node *node = &router->root;
+
+    aws_mutex_lock(&router->lock);
+
+    struct aws_byte_cursor segment;
+    AWS_ZERO_STRUCT(segment);
+    while (aws_byte_cursor_next_split(&topic_filter, '/', &segment)) {
+        struct aws_mqtt5_topic_router_node *parent = node;
+        node = s_node_find_or_add_child(router->allocator, parent, segment);
+        if (node == NULL) {
+            s_node_prune(router->allocator, parent);
+            goto done;
+        }
+    }
+
+    size_t handler_count = aws_array_list_length(&node->handlers);
+    for (size_t i = 0; i < handler_count; ++i) {
+        jobject existing = NULL;
+        aws_array_list_get_at(&node->handlers, &existing, i);
+        if ((*env)->IsSameObject(env, existing, handler)) {
+            result = AWS_OP_SUCCESS;
+            goto done;
+        }
+    }
+
+    jobject global_handler = (*env)->NewGlobalRef(env, handler);
+    if (global_handler == NULL) {
+        aws_raise_error(AWS_ERROR_OOM);
+        s_node_prune(router->allocator, node);
+        goto done;
+    }
+    if (aws_array_list_push_back(&node->handlers, &global_handler)) {
+        (*env)->DeleteGlobalRef(env, global_handler);
+        s_node_prune(router->allocator, node);
+        goto done;
+    }
+    aws_atomic_fetch_add(&router->route_count, 1);
+    result = AWS_OP_SUCCESS;
+
+done:
+    aws_mutex_unlock(&router->lock);
+    return result;
+}
+
+bool aws_mqtt5_topic_router_remove(
+    struct aws_mqtt5_topic_router *router,
+    JNIEnv *env,
+    struct aws_byte_cursor topic_filter,
+    jobject handler) {
+
+    bool removed = false;
+    struct aws_mqtt5_topic_router_node *node = &router->root;
+
+    aws_mutex_lock(&router->lock);
+
+    struct aws_byte_cursor segment;
+    AWS_ZERO_STRUCT(segment);
+    while (node != NULL && aws_byte_cursor_next_split(&topic_filter, '/', &segment)) {
+        node = s_node_find_child(node, &segment);
+    }
+    if (node == NULL) {
+        goto done;
+    }
+
+    size_t handler_count = aws_array_list_length(&node->handlers);
+    for (size_t i = 0; i < handler_count; ++i) {
+        jobject existing = NULL;
+        aws_array_list_get_at(&node->handlers, &existing, i);
+        if ((*env)->IsSameObject(env, existing, handler)) {
+            (*env)->DeleteGlobalRef(env, existing);
+            aws_array_list_swap(&node->handlers, i, handler_count - 1);
+            aws_array_list_pop_back(&node->handlers);
+            aws_atomic_fetch_sub(&router->route_count, 1);
+            s_node_prune(router->allocator, node);
+            removed = true;
+            break;
+        }
+    }
+
+done:
+    aws_mutex_unlock(&router->lock);
+    return removed;
+}
+
+bool aws_mqtt5_topic_router_has_routes(struct aws_mqtt5_topic_router *router) {
+    return router != NULL && aws_atomic_load_int(&router->route_count) > 0;
+}
+
+size_t aws_mqtt5_topic_router_match(
+    struct aws_mqtt5_topic_router *router,
+    JNIEnv *env,
+    struct aws_byte_cursor topic,
+    struct aws_array_list *matched_handlers) {
+
+    struct aws_byte_cursor segment;
+    AWS_ZERO_STRUCT(segment);
+
+    aws_mutex_lock(&router->lock);
+    size_t appended = s_node_match(&router->root, env, &topic, segment, true, matched_handlers);
+    aws_mutex_unlock(&router->lock);
+
+    return appended;
+}
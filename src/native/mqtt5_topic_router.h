@@ -0,0 +1,59 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_MQTT5_TOPIC_ROUTER_H
+#define AWS_JNI_CRT_MQTT5_TOPIC_ROUTER_H
+
+#include <jni.h>
+
+#include <aws/common/array_list.h>
+#include <aws/common/byte_buf.h>
+
+struct aws_allocator;
+struct aws_mqtt5_topic_router;
+
+/*
+ * Maps MQTT topic filters, including + and # wildcards, to Java publish handlers so received publishes can be routed
+ * to the handlers interested in their topic without going through Java. Handlers are held as global references.
+ *
+ * Adding, removing and matching may be done from any thread.
+ */
+struct aws_mqtt5_topic_router *aws_mqtt5_topic_router_new(struct aws_allocator *allocator);
+
+/* Deletes the global references of every handler still registered */
+void aws_mqtt5_topic_router_destroy(struct aws_mqtt5_topic_router *router, JNIEnv *env);
+
+/*
+ * Registers a handler for a topic filter. Registering the same handler for the same filter again does nothing.
+ * Fails with AWS_ERROR_INVALID_ARGUMENT if the topic filter is not valid.
+ */
+int aws_mqtt5_topic_router_add(
+    struct aws_mqtt5_topic_router *router,
+    JNIEnv *env,
+    struct aws_byte_cursor topic_filter,
+    jobject handler);
+
+/* Returns true if the handler was registered for exactly this topic filter and has been removed */
+bool aws_mqtt5_topic_router_remove(
+    struct aws_mqtt5_topic_router *router,
+    JNIEnv *env,
+    struct aws_byte_cursor topic_filter,
+    jobject handler);
+
+/* Lock-free check so clients without routes don't pay for a lookup */
+bool aws_mqtt5_topic_router_has_routes(struct aws_mqtt5_topic_router *router);
+
+/*
+ * Appends a new local reference (jobject) to matched_handlers for each handler whose filter matches the topic, so
+ * the handlers can be called after the router's lock is dropped even if they are removed meanwhile. A handler
+ * registered under several matching filters is appended once per filter. Returns the number appended.
+ */
+size_t aws_mqtt5_topic_router_match(
+    struct aws_mqtt5_topic_router *router,
+    JNIEnv *env,
+    struct aws_byte_cursor topic,
+    struct aws_array_list *matched_handlers);
+
+#endif /* AWS_JNI_CRT_MQTT5_TOPIC_ROUTER_H */
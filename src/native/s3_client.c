@@ -6,6 +6,9 @@
 #include "http_request_utils.h"
 #include "java_class_ids.h"
 #include "retry_utils.h"
+#include <aws/common/clock.h>
+#include <aws/common/file.h>
+#include <aws/common/mutex.h>
 #include <aws/common/string.h>
 #include <aws/http/request_response.h>
 #include <aws/io/channel_bootstrap.h>
@@ -16,6 +19,8 @@
 #include <aws/s3/s3_client.h>
 #include <jni.h>
 
+#include <errno.h>
+
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
@@ -39,6 +44,32 @@ struct s3_client_make_meta_request_callback_data {
     jobject java_s3_meta_request;
     jobject java_s3_meta_request_response_handler_native_adapter;
     struct aws_input_stream *input_stream;
+    /* if true, body parts are handed to Java as DirectByteBuffers over native memory rather than copied to byte[] */
+    bool direct_response_body;
+    /*
+     * if set, body parts are written to this file at their object offset and never cross into Java. The file is
+     * opened (and truncated) when the first part arrives, so a request that fails before then leaves it untouched.
+     */
+    struct aws_string *response_file_path;
+    FILE *response_file;
+    uint64_t response_file_position;
+    uint64_t response_content_length;
+
+    /*
+     * Progress coalescing. When either interval is non-zero, progress events are accumulated natively and
+     * at most one Java upcall is made per interval. The upcall reuses java_progress unless another report is
+     * still using it, in which case it gets a fresh S3MetaRequestProgress.
+     */
+    struct {
+        struct aws_mutex lock;
+        uint64_t interval_bytes;
+        uint64_t interval_ns;
+        uint64_t pending_bytes;
+        uint64_t content_length;
+        uint64_t last_report_ns;
+        jobject java_progress;
+        bool java_progress_in_use;
+    } progress;
 };
 
 static void s_on_s3_client_shutdown_complete_callback(void *user_data);
@@ -207,6 +238,183 @@ static void s_on_s3_client_shutdown_complete_callback(void *user_data) {
     aws_mem_release(aws_jni_get_allocator(), user_data);
 }
 
+static jobject s_s3_meta_request_progress_new(JNIEnv *env) {
+    jobject progress_object = (*env)->NewObject(
+        env,
+        s3_meta_request_progress_properties.s3_meta_request_progress_class,
+        s3_meta_request_progress_properties.s3_meta_request_progress_constructor_method_id);
+    if ((*env)->ExceptionCheck(env) || progress_object == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        return NULL;
+    }
+    return progress_object;
+}
+
+/* If reusable_progress is NULL a new S3MetaRequestProgress is created for this upcall */
+static void s_s3_meta_request_invoke_java_progress(
+    JNIEnv *env,
+    struct aws_s3_meta_request *meta_request,
+    struct s3_client_make_meta_request_callback_data *callback_data,
+    jobject reusable_progress,
+    uint64_t bytes_transferred,
+    uint64_t content_length) {
+
+    if (callback_data->java_s3_meta_request_response_handler_native_adapter == NULL) {
+        return;
+    }
+
+    jobject progress_object = reusable_progress;
+    if (progress_object == NULL) {
+        progress_object = s_s3_meta_request_progress_new(env);
+        if (progress_object == NULL) {
+            /* progress object constructor failed, nothing to do */
+            return;
+        }
+    }
+
+    (*env)->SetLongField(
+        env, progress_object, s3_meta_request_progress_properties.bytes_transferred_field_id, bytes_transferred);
+    (*env)->SetLongField(
+        env, progress_object, s3_meta_request_progress_properties.content_length_field_id, content_length);
+
+    (*env)->CallVoidMethod(
+        env,
+        callback_data->java_s3_meta_request_response_handler_native_adapter,
+        s3_meta_request_response_handler_native_adapter_properties.onProgress,
+        progress_object);
+
+    if (aws_jni_check_and_clear_exception(env)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_S3_META_REQUEST,
+            "id=%p: Ignored Exception from S3MetaRequest.onProgress callback",
+            (void *)meta_request);
+    }
+
+    if (progress_object != reusable_progress) {
+        (*env)->DeleteLocalRef(env, progress_object);
+    }
+}
+
+static bool s_s3_meta_request_progress_is_coalesced(struct s3_client_make_meta_request_callback_data *callback_data) {
+    return callback_data->progress.interval_bytes > 0 || callback_data->progress.interval_ns > 0;
+}
+
+/*
+ * Reports progress to Java, either immediately or, if coalescing is enabled, once enough bytes or time have
+ * accumulated since the last report. Passing flush forces out anything pending.
+ */
+static void s_s3_meta_request_report_progress(
+    JNIEnv *env,
+    struct aws_s3_meta_request *meta_request,
+    struct s3_client_make_meta_request_callback_data *callback_data,
+    uint64_t bytes_transferred,
+    uint64_t content_length,
+    bool flush) {
+
+    if (!s_s3_meta_request_progress_is_coalesced(callback_data)) {
+        if (!flush) {
+            s_s3_meta_request_invoke_java_progress(
+                env, meta_request, callback_data, NULL, bytes_transferred, content_length);
+        }
+        return;
+    }
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+
+    /*
+     * Progress may be reported from several threads at once. The lock only guards the accumulated counts,
+     * the upcall happens after a snapshot is taken and the lock released.
+     */
+    uint64_t report_bytes = 0;
+    uint64_t report_content_length = 0;
+    jobject reusable_progress = NULL;
+
+    aws_mutex_lock(&callback_data->progress.lock);
+
+    callback_data->progress.pending_bytes += bytes_transferred;
+    if (content_length > 0) {
+        callback_data->progress.content_length = content_length;
+    }
+
+    bool report = flush && callback_data->progress.pending_bytes > 0;
+    if (callback_data->progress.interval_bytes > 0 &&
+        callback_data->progress.pending_bytes >= callback_data->progress.interval_bytes) {
+        report = true;
+    }
+    if (callback_data->progress.interval_ns > 0 &&
+        now_ns - callback_data->progress.last_report_ns >= callback_data->progress.interval_ns) {
+        report = true;
+    }
+
+    if (report) {
+        report_bytes = callback_data->progress.pending_bytes;
+        report_content_length = callback_data->progress.content_length;
+        callback_data->progress.pending_bytes = 0;
+        callback_data->progress.last_report_ns = now_ns;
+        if (!callback_data->progress.java_progress_in_use) {
+            reusable_progress = callback_data->progress.java_progress;
+            callback_data->progress.java_progress_in_use = reusable_progress != NULL;
+        }
+    }
+
+    aws_mutex_unlock(&callback_data->progress.lock);
+
+    if (!report) {
+        return;
+    }
+
+    s_s3_meta_request_invoke_java_progress(
+        env, meta_request, callback_data, reusable_progress, report_bytes, report_content_length);
+
+    if (reusable_progress != NULL) {
+        aws_mutex_lock(&callback_data->progress.lock);
+        callback_data->progress.java_progress_in_use = false;
+        aws_mutex_unlock(&callback_data->progress.lock);
+    }
+}
+
+/*
+ * Writes a body part straight to the response file at its object offset.
+ * Parts normally arrive in order, so only seek when the part isn't contiguous with the previous one.
+ */
+static int s_s3_meta_request_open_response_file(struct s3_client_make_meta_request_callback_data *callback_data) {
+    callback_data->response_file = aws_fopen(aws_string_c_str(callback_data->response_file_path), "wb");
+    if (callback_data->response_file == NULL) {
+        return AWS_OP_ERR;
+    }
+    callback_data->response_file_position = 0;
+    return AWS_OP_SUCCESS;
+}
+
+static int s_s3_meta_request_write_body_to_file(
+    struct s3_client_make_meta_request_callback_data *callback_data,
+    const struct aws_byte_cursor *body,
+    uint64_t range_start) {
+
+    /* Body callbacks are delivered one at a time, so the first one opens the file */
+    if (callback_data->response_file == NULL && s_s3_meta_request_open_response_file(callback_data)) {
+        return AWS_OP_ERR;
+    }
+
+    if (range_start != callback_data->response_file_position) {
+        if (range_start > INT64_MAX) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+        if (aws_fseek(callback_data->response_file, (int64_t)range_start, SEEK_SET)) {
+            return AWS_OP_ERR;
+        }
+        callback_data->response_file_position = range_start;
+    }
+
+    if (body->len > 0 && fwrite(body->ptr, 1, body->len, callback_data->response_file) != body->len) {
+        return aws_translate_and_raise_io_error(errno);
+    }
+
+    callback_data->response_file_position += body->len;
+    return AWS_OP_SUCCESS;
+}
+
 static int s_on_s3_meta_request_body_callback(
     struct aws_s3_meta_request *meta_request,
     const struct aws_byte_cursor *body,
@@ -221,6 +429,40 @@ static int s_on_s3_meta_request_body_callback(
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
+    if (callback_data->response_file_path != NULL) {
+        if (s_s3_meta_request_write_body_to_file(callback_data, body, range_start)) {
+            AWS_LOGF_ERROR(
+                AWS_LS_S3_META_REQUEST,
+                "id=%p: Failed writing response body to file, error %d (%s)",
+                (void *)meta_request,
+                aws_last_error(),
+                aws_error_str(aws_last_error()));
+            return AWS_OP_ERR;
+        }
+
+        /*
+         * Java never sees the body in this mode, so it can't open the read window either. The written bytes are
+         * consumed, so open it here; aws-c-s3 ignores this unless read backpressure is enabled.
+         */
+        aws_s3_meta_request_increment_read_window(meta_request, body->len);
+
+        /* The body never crosses into Java in this mode, the bytes written are reported as progress instead */
+        /********** JNI ENV ACQUIRE **********/
+        JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
+        if (env == NULL) {
+            /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+            return AWS_OP_ERR;
+        }
+
+        s_s3_meta_request_report_progress(
+            env, meta_request, callback_data, body->len, callback_data->response_content_length, false);
+
+        aws_jni_release_thread_env(callback_data->jvm, env);
+        /********** JNI ENV RELEASE **********/
+
+        return AWS_OP_SUCCESS;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -228,7 +470,28 @@ static int s_on_s3_meta_request_body_callback(
         return AWS_OP_ERR;
     }
 
-    jobject jni_payload = aws_jni_byte_array_from_cursor(env, body);
+    jobject jni_payload = NULL;
+    jmethodID on_response_body_method_id = NULL;
+    if (callback_data->direct_response_body) {
+        /*
+         * A freshly created DirectByteBuffer already has position 0 and limit == capacity, so skip the extra
+         * upcalls that aws_jni_direct_byte_buffer_from_raw_ptr() makes. The buffer is only valid for the
+         * duration of this callback; the Java adapter hands out a read-only view of it.
+         */
+        jni_payload = (*env)->NewDirectByteBuffer(env, (void *)body->ptr, (jlong)body->len);
+        on_response_body_method_id = s3_meta_request_response_handler_native_adapter_properties.onResponseBodyDirect;
+    } else {
+        jni_payload = aws_jni_byte_array_from_cursor(env, body);
+        on_response_body_method_id = s3_meta_request_response_handler_native_adapter_properties.onResponseBody;
+    }
+
+    if (jni_payload == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(
+            AWS_LS_S3_META_REQUEST, "id=%p: Failed to create Java payload for response body", (void *)meta_request);
+        aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
+        goto cleanup;
+    }
 
     jint body_response_result = 0;
 
@@ -236,7 +499,7 @@ static int s_on_s3_meta_request_body_callback(
         body_response_result = (*env)->CallIntMethod(
             env,
             callback_data->java_s3_meta_request_response_handler_native_adapter,
-            s3_meta_request_response_handler_native_adapter_properties.onResponseBody,
+            on_response_body_method_id,
             jni_payload,
             range_start,
             range_end);
@@ -258,7 +521,9 @@ static int s_on_s3_meta_request_body_callback(
     return_value = AWS_OP_SUCCESS;
 
 cleanup:
-    (*env)->DeleteLocalRef(env, jni_payload);
+    if (jni_payload != NULL) {
+        (*env)->DeleteLocalRef(env, jni_payload);
+    }
 
     aws_jni_release_thread_env(callback_data->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -275,6 +540,18 @@ static int s_on_s3_meta_request_headers_callback(
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
+    if (callback_data->response_file_path != NULL) {
+        /* remember the object size so progress reported while writing the file has a meaningful total */
+        struct aws_byte_cursor content_length_value;
+        if (aws_http_headers_get(headers, aws_byte_cursor_from_c_str("Content-Length"), &content_length_value) ==
+            AWS_OP_SUCCESS) {
+            uint64_t content_length = 0;
+            if (aws_byte_cursor_utf8_parse_u64(content_length_value, &content_length) == AWS_OP_SUCCESS) {
+                callback_data->response_content_length = content_length;
+            }
+        }
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -343,11 +620,26 @@ static void s_on_s3_meta_request_finish_callback(
     const struct aws_s3_meta_request_result *meta_request_result,
     void *user_data) {
 
-    (void)meta_request;
-
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
+    int error_code = meta_request_result->error_code;
+
+    /* An empty object never delivers a body part, but a successful download still leaves an (empty) file */
+    if (callback_data->response_file_path != NULL && callback_data->response_file == NULL &&
+        error_code == AWS_ERROR_SUCCESS && s_s3_meta_request_open_response_file(callback_data)) {
+        error_code = aws_last_error();
+    }
+
+    /* Close the response file before notifying Java, so the file is complete by the time onFinished runs */
+    if (callback_data->response_file != NULL) {
+        if (fclose(callback_data->response_file) != 0 && error_code == AWS_ERROR_SUCCESS) {
+            aws_translate_and_raise_io_error(errno);
+            error_code = aws_last_error();
+        }
+        callback_data->response_file = NULL;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -355,6 +647,9 @@ static void s_on_s3_meta_request_finish_callback(
         return;
     }
 
+    /* Deliver any coalesced progress that hasn't been reported yet, so it all arrives before onFinished */
+    s_s3_meta_request_report_progress(env, meta_request, callback_data, 0, 0, true);
+
     if (callback_data->java_s3_meta_request_response_handler_native_adapter != NULL) {
         struct aws_byte_buf *error_response_body = meta_request_result->error_response_body;
         struct aws_byte_cursor error_response_cursor;
@@ -367,7 +662,7 @@ static void s_on_s3_meta_request_finish_callback(
             env,
             callback_data->java_s3_meta_request_response_handler_native_adapter,
             s3_meta_request_response_handler_native_adapter_properties.onFinished,
-            meta_request_result->error_code,
+            error_code,
             meta_request_result->response_status,
             jni_payload,
             meta_request_result->validation_algorithm,
@@ -391,8 +686,6 @@ static void s_on_s3_meta_request_progress_callback(
     const struct aws_s3_meta_request_progress *progress,
     void *user_data) {
 
-    (void)meta_request;
-
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
@@ -403,42 +696,8 @@ static void s_on_s3_meta_request_progress_callback(
         return;
     }
 
-    jobject progress_object = (*env)->NewObject(
-        env,
-        s3_meta_request_progress_properties.s3_meta_request_progress_class,
-        s3_meta_request_progress_properties.s3_meta_request_progress_constructor_method_id);
-    if ((*env)->ExceptionCheck(env) || progress_object == NULL) {
-        /* progress object constructor failed, nothing to do */
-        goto done;
-    }
-
-    (*env)->SetLongField(
-        env,
-        progress_object,
-        s3_meta_request_progress_properties.bytes_transferred_field_id,
-        progress->bytes_transferred);
-    (*env)->SetLongField(
-        env, progress_object, s3_meta_request_progress_properties.content_length_field_id, progress->content_length);
-
-    if (callback_data->java_s3_meta_request_response_handler_native_adapter != NULL) {
-
-        (*env)->CallVoidMethod(
-            env,
-            callback_data->java_s3_meta_request_response_handler_native_adapter,
-            s3_meta_request_response_handler_native_adapter_properties.onProgress,
-            progress_object);
-
-        if (aws_jni_check_and_clear_exception(env)) {
-            AWS_LOGF_ERROR(
-                AWS_LS_S3_META_REQUEST,
-                "id=%p: Ignored Exception from S3MetaRequest.onProgress callback",
-                (void *)meta_request);
-        }
-    }
-
-    (*env)->DeleteLocalRef(env, progress_object);
-
-done:
+    s_s3_meta_request_report_progress(
+        env, meta_request, callback_data, progress->bytes_transferred, progress->content_length, false);
 
     aws_jni_release_thread_env(callback_data->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -448,6 +707,14 @@ static void s_s3_meta_request_callback_cleanup(
     JNIEnv *env,
     struct s3_client_make_meta_request_callback_data *callback_data) {
     if (callback_data) {
+        if (callback_data->response_file != NULL) {
+            fclose(callback_data->response_file);
+        }
+        aws_string_destroy(callback_data->response_file_path);
+        if (callback_data->progress.java_progress != NULL) {
+            (*env)->DeleteGlobalRef(env, callback_data->progress.java_progress);
+        }
+        aws_mutex_clean_up(&callback_data->progress.lock);
         (*env)->DeleteGlobalRef(env, callback_data->java_s3_meta_request);
         (*env)->DeleteGlobalRef(env, callback_data->java_s3_meta_request_response_handler_native_adapter);
         aws_mem_release(aws_jni_get_allocator(), callback_data);
@@ -519,7 +786,12 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
     jlong jni_credentials_provider,
     jobject java_response_handler_jobject,
     jbyteArray jni_endpoint,
-    jobject java_resume_token_jobject) {
+    jobject java_resume_token_jobject,
+    jboolean direct_response_body,
+    jstring jni_response_file_path,
+    jstring jni_request_file_path,
+    jlong progress_interval_bytes,
+    jlong progress_interval_ms) {
     (void)jni_class;
 
     struct aws_allocator *allocator = aws_jni_get_allocator();
@@ -531,6 +803,8 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
     struct aws_s3_meta_request *meta_request = NULL;
     bool success = false;
     struct aws_byte_cursor region = aws_jni_byte_cursor_from_jbyteArray_acquire(env, jni_region);
+    struct aws_byte_cursor request_file_path;
+    AWS_ZERO_STRUCT(request_file_path);
     if (credentials_provider) {
         signing_config = aws_mem_calloc(allocator, 1, sizeof(struct aws_signing_config_aws));
         aws_s3_init_default_signing_config(signing_config, region, credentials_provider);
@@ -551,6 +825,24 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         (*env)->NewGlobalRef(env, java_response_handler_jobject);
     AWS_FATAL_ASSERT(callback_data->java_s3_meta_request_response_handler_native_adapter != NULL);
 
+    callback_data->direct_response_body = direct_response_body;
+
+    AWS_FATAL_ASSERT(aws_mutex_init(&callback_data->progress.lock) == AWS_OP_SUCCESS);
+    callback_data->progress.interval_bytes = progress_interval_bytes > 0 ? (uint64_t)progress_interval_bytes : 0;
+    callback_data->progress.interval_ns =
+        progress_interval_ms > 0
+            ? aws_timestamp_convert((uint64_t)progress_interval_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL)
+            : 0;
+    if (s_s3_meta_request_progress_is_coalesced(callback_data)) {
+        aws_high_res_clock_get_ticks(&callback_data->progress.last_report_ns);
+        /* If this fails, java_progress stays NULL and every report creates its own progress object */
+        jobject java_progress = s_s3_meta_request_progress_new(env);
+        if (java_progress != NULL) {
+            callback_data->progress.java_progress = (*env)->NewGlobalRef(env, java_progress);
+            (*env)->DeleteLocalRef(env, java_progress);
+        }
+    }
+
     struct aws_http_message *request_message = aws_http_message_new_request(allocator);
     AWS_FATAL_ASSERT(request_message);
 
@@ -570,6 +862,27 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         }
     }
 
+    if (jni_response_file_path != NULL) {
+        /* Opened once the first body part arrives, so a failure to create the meta request leaves it untouched */
+        callback_data->response_file_path = aws_jni_new_string_from_jstring(env, jni_response_file_path);
+        if (callback_data->response_file_path == NULL) {
+            aws_jni_throw_runtime_exception(env, "S3Client.aws_s3_client_make_meta_request: invalid response file path");
+            goto done;
+        }
+    }
+
+    if (jni_request_file_path != NULL) {
+        /* aws-c-s3 reads the parts of the body straight from this file, in parallel, at their part offsets */
+        request_file_path = aws_jni_byte_cursor_from_jstring_acquire(env, jni_request_file_path);
+        if (request_file_path.ptr == NULL) {
+            goto done;
+        }
+        if (request_file_path.len == 0) {
+            aws_jni_throw_illegal_argument_exception(env, "Request file path cannot be empty");
+            goto done;
+        }
+    }
+
     struct aws_s3_checksum_config checksum_config = {
         .location = checksum_location,
         .checksum_algorithm = checksum_algorithm,
@@ -602,6 +915,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         .shutdown_callback = s_on_s3_meta_request_shutdown_complete_callback,
         .endpoint = jni_endpoint != NULL ? &endpoint : NULL,
         .resume_token = resume_token,
+        .send_filepath = request_file_path,
     };
 
     meta_request = aws_s3_client_make_meta_request(client, &meta_request_options);
@@ -619,6 +933,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
 done:
     aws_s3_meta_request_resume_token_release(resume_token);
     aws_jni_byte_cursor_from_jbyteArray_release(env, jni_region, region);
+    aws_jni_byte_cursor_from_jstring_release(env, jni_request_file_path, request_file_path);
     if (signing_config) {
         aws_mem_release(allocator, signing_config);
     }
@@ -12,7 +12,10 @@ import software.amazon.awssdk.crt.io.ClientBootstrap;
 import software.amazon.awssdk.crt.io.EventLoopGroup;
 import software.amazon.awssdk.crt.io.HostResolver;
 
+import java.util.List;
 import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
 
 import static org.junit.Assert.*;
 
@@ -31,4 +34,17 @@ public class ClientBootstrapTest extends CrtTestFixture {
         hostResolver.close();
         elg.close();
     }
+
+    @Test
+    public void testResolveHost() throws ExecutionException, InterruptedException, TimeoutException {
+        try (EventLoopGroup elg = new EventLoopGroup(1);
+                HostResolver hostResolver = new HostResolver(elg);
+                ClientBootstrap bootstrap = new ClientBootstrap(elg, hostResolver)) {
+            List<String> addresses = bootstrap.resolveHost("127.0.0.1").get(60, TimeUnit.SECONDS);
+            assertEquals(1, addresses.size());
+            assertEquals("127.0.0.1", addresses.get(0));
+        }
+
+        CrtResource.waitForNoResources();
+    }
 };
@@ -8,6 +8,13 @@ package software.amazon.awssdk.crt.test;
 import org.junit.Test;
 import static org.junit.Assert.*;
 
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Random;
+
 public class CrcTest extends CrtTestFixture {
     public CrcTest() {
     }
@@ -167,4 +174,94 @@ public class CrcTest extends CrtTestFixture {
         int expected = 0xfb5b991d;
         assertEquals(expected, (int) crcc.getValue());
     }
+
+    @Test
+    public void testCrc32ByteBuffers() {
+        byte[] values = new byte[1024];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = (byte) i;
+        }
+        java.util.zip.CRC32 crcj = new java.util.zip.CRC32();
+        crcj.update(values, 16, values.length - 32);
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(values.length);
+        direct.put(values);
+        direct.position(16);
+        direct.limit(values.length - 16);
+        software.amazon.awssdk.crt.checksums.CRC32 crcDirect = new software.amazon.awssdk.crt.checksums.CRC32();
+        crcDirect.update(direct);
+        assertEquals(crcj.getValue(), crcDirect.getValue());
+        assertEquals(direct.limit(), direct.position());
+
+        ByteBuffer heap = ByteBuffer.wrap(values, 16, values.length - 32).asReadOnlyBuffer();
+        software.amazon.awssdk.crt.checksums.CRC32 crcHeap = new software.amazon.awssdk.crt.checksums.CRC32();
+        crcHeap.update(heap);
+        assertEquals(crcj.getValue(), crcHeap.getValue());
+        assertFalse(heap.hasRemaining());
+    }
+
+    @Test
+    public void testCrc32CByteBuffers() {
+        byte[] values = new byte[1024];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = (byte) i;
+        }
+        software.amazon.awssdk.crt.checksums.CRC32C crcArray = new software.amazon.awssdk.crt.checksums.CRC32C();
+        crcArray.update(values, 16, values.length - 32);
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(values.length);
+        direct.put(values);
+        direct.position(16);
+        direct.limit(values.length - 16);
+        software.amazon.awssdk.crt.checksums.CRC32C crcDirect = new software.amazon.awssdk.crt.checksums.CRC32C();
+        crcDirect.update(direct);
+        assertEquals(crcArray.getValue(), crcDirect.getValue());
+        assertEquals(direct.limit(), direct.position());
+    }
+
+    @Test
+    public void testCrcChecksumFile() throws IOException {
+        byte[] values = new byte[3 * (1 << 20) + 17];
+        new Random(42).nextBytes(values);
+        Path file = Files.createTempFile("crc-test", ".data");
+        try {
+            Files.write(file, values);
+
+            java.util.zip.CRC32 crcj = new java.util.zip.CRC32();
+            crcj.update(values);
+            assertEquals(crcj.getValue(), software.amazon.awssdk.crt.checksums.CRC32.checksumFile(file));
+
+            software.amazon.awssdk.crt.checksums.CRC32C crcc = new software.amazon.awssdk.crt.checksums.CRC32C();
+            crcc.update(values);
+            assertEquals(crcc.getValue(), software.amazon.awssdk.crt.checksums.CRC32C.checksumFile(file));
+        } finally {
+            Files.deleteIfExists(file);
+        }
+    }
+
+    @Test
+    public void testCrc64NvmeCheckValue() {
+        byte[] check = "123456789".getBytes(StandardCharsets.US_ASCII);
+        software.amazon.awssdk.crt.checksums.CRC64NVME crc = new software.amazon.awssdk.crt.checksums.CRC64NVME();
+        crc.update(check);
+        assertEquals(0xae8b14860a799888L, crc.getValue());
+
+        software.amazon.awssdk.crt.checksums.CRC64NVME crcIterated = new software.amazon.awssdk.crt.checksums.CRC64NVME();
+        crcIterated.update(check, 0, 5);
+        crcIterated.update(check, 5, 4);
+        assertEquals(crc.getValue(), crcIterated.getValue());
+    }
+
+    @Test
+    public void testCrc64NvmeZeroes() {
+        byte[] zeroes = new byte[32];
+        software.amazon.awssdk.crt.checksums.CRC64NVME crc = new software.amazon.awssdk.crt.checksums.CRC64NVME();
+        crc.update(zeroes);
+        assertEquals(0xcf3473434d4ecf3bL, crc.getValue());
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(zeroes.length);
+        software.amazon.awssdk.crt.checksums.CRC64NVME crcDirect = new software.amazon.awssdk.crt.checksums.CRC64NVME();
+        crcDirect.update(direct);
+        assertEquals(crc.getValue(), crcDirect.getValue());
+    }
 }
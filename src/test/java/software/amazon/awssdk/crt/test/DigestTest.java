@@ -0,0 +1,82 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.test;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import software.amazon.awssdk.crt.checksums.CrtDigest;
+import software.amazon.awssdk.crt.checksums.SHA1;
+import software.amazon.awssdk.crt.checksums.SHA256;
+
+import java.nio.ByteBuffer;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.security.MessageDigest;
+import java.util.Random;
+
+public class DigestTest extends CrtTestFixture {
+    public DigestTest() {
+    }
+
+    private static byte[] randomBytes(int size) {
+        byte[] data = new byte[size];
+        new Random(size).nextBytes(data);
+        return data;
+    }
+
+    private void checkAgainstJdk(CrtDigest digest, String jdkAlgorithm) throws Exception {
+        byte[] data = randomBytes(1 << 20);
+        byte[] expected = MessageDigest.getInstance(jdkAlgorithm).digest(data);
+
+        digest.update(data);
+        assertArrayEquals(expected, digest.digest());
+
+        /* digest() reset the state, so the same instance can be reused with mixed update styles */
+        digest.update(data, 0, 1000);
+        ByteBuffer direct = ByteBuffer.allocateDirect(data.length - 1000);
+        direct.put(data, 1000, data.length - 1000);
+        direct.flip();
+        digest.update(direct);
+        assertFalse(direct.hasRemaining());
+        assertArrayEquals(expected, digest.digest());
+
+        digest.update(data, 0, 10);
+        digest.reset();
+        digest.update(ByteBuffer.wrap(data));
+        assertArrayEquals(expected, digest.digest());
+
+        Path file = Files.createTempFile("digest-test", ".data");
+        try {
+            Files.write(file, data);
+            digest.updateFromFile(file);
+            assertArrayEquals(expected, digest.digest());
+        } finally {
+            Files.deleteIfExists(file);
+        }
+    }
+
+    @Test
+    public void testSha1() throws Exception {
+        try (SHA1 sha1 = new SHA1()) {
+            checkAgainstJdk(sha1, "SHA-1");
+        }
+    }
+
+    @Test
+    public void testSha256() throws Exception {
+        try (SHA256 sha256 = new SHA256()) {
+            checkAgainstJdk(sha256, "SHA-256");
+        }
+    }
+
+    @Test
+    public void testEmptyDigest() throws Exception {
+        try (SHA256 sha256 = new SHA256()) {
+            assertArrayEquals(MessageDigest.getInstance("SHA-256").digest(), sha256.digest());
+        }
+    }
+}
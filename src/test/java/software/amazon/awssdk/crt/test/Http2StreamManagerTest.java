@@ -39,6 +39,11 @@ public class Http2StreamManagerTest extends HttpClientTestFixture {
     private final String EMPTY_BODY = "";
 
     private Http2StreamManager createStreamManager(URI uri, int numConnections, int maxStreams) {
+        return createStreamManager(uri, numConnections, maxStreams, Http2StreamAssignmentStrategy.DEFAULT);
+    }
+
+    private Http2StreamManager createStreamManager(URI uri, int numConnections, int maxStreams,
+            Http2StreamAssignmentStrategy strategy) {
 
         try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
                 HostResolver resolver = new HostResolver(eventLoopGroup);
@@ -46,7 +51,8 @@ public class Http2StreamManagerTest extends HttpClientTestFixture {
                 SocketOptions sockOpts = new SocketOptions();
                 TlsContextOptions tlsOpts = TlsContextOptions.createDefaultClient().withAlpnList("h2");
                 TlsContext tlsContext = createHttpClientTlsContext(tlsOpts)) {
-            Http2StreamManagerOptions options = new Http2StreamManagerOptions();
+            Http2StreamManagerOptions options = new Http2StreamManagerOptions()
+                    .withStreamAssignmentStrategy(strategy);
             if (maxStreams != 0) {
                 options.withMaxConcurrentStreamsPerConnection(maxStreams)
                         .withIdealConcurrentStreamsPerConnection(maxStreams);
@@ -271,4 +277,109 @@ public class Http2StreamManagerTest extends HttpClientTestFixture {
         CrtResource.logNativeResources();
         CrtResource.waitForNoResources();
     }
+
+    /* Completes statusFuture with the response status once the stream completes */
+    private HttpStreamBaseResponseHandler createStatusHandler(CompletableFuture<Integer> statusFuture) {
+        return new HttpStreamBaseResponseHandler() {
+            @Override
+            public void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType,
+                    HttpHeader[] nextHeaders) {
+            }
+
+            @Override
+            public void onResponseComplete(HttpStreamBase stream, int errorCode) {
+                if (errorCode != CRT.AWS_CRT_SUCCESS) {
+                    statusFuture.completeExceptionally(new CrtRuntimeException(errorCode));
+                } else {
+                    statusFuture.complete(stream.getResponseStatusCode());
+                }
+                stream.close();
+            }
+        };
+    }
+
+    private static CompletableFuture<Integer> failOnAcquireError(CompletableFuture<Http2Stream> streamFuture,
+            CompletableFuture<Integer> statusFuture) {
+        streamFuture.whenComplete((stream, throwable) -> {
+            if (throwable != null) {
+                statusFuture.completeExceptionally(throwable);
+            }
+        });
+        return statusFuture;
+    }
+
+    private CompletableFuture<Integer> makeRequestWithStatus(Http2StreamManager streamManager, Http2Request request) {
+        CompletableFuture<Integer> statusFuture = new CompletableFuture<>();
+        CompletableFuture<Http2Stream> streamFuture =
+                streamManager.acquireStream(request, createStatusHandler(statusFuture));
+        return failOnAcquireError(streamFuture, statusFuture);
+    }
+
+    @Test
+    public void testTryAcquireStream() throws Exception {
+        skipIfNetworkUnavailable();
+        URI uri = new URI(endpoint);
+        Http2Request request = createHttp2Request("GET", endpoint, path, EMPTY_BODY);
+
+        try (Http2StreamManager streamManager = createStreamManager(uri, 1, 0)) {
+            /* Nothing is available yet, so this takes the async path and opens the connection */
+            CompletableFuture<Integer> statusFuture = new CompletableFuture<>();
+            CompletableFuture<Http2Stream> streamFuture =
+                    streamManager.tryAcquireStream(request, createStatusHandler(statusFuture));
+            Assert.assertEquals(EXPECTED_HTTP_STATUS,
+                    (int) failOnAcquireError(streamFuture, statusFuture).get(60, TimeUnit.SECONDS));
+
+            /*
+             * Now there is a warm connection with free stream slots, so these can be handed over inline. The wait for
+             * the event loop is bounded, so a slow machine may miss it now and then, but not every time.
+             */
+            int completedOnReturn = 0;
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                statusFuture = new CompletableFuture<>();
+                streamFuture = streamManager.tryAcquireStream(request, createStatusHandler(statusFuture));
+                if (streamFuture.isDone()) {
+                    ++completedOnReturn;
+                }
+                Assert.assertEquals(EXPECTED_HTTP_STATUS,
+                        (int) failOnAcquireError(streamFuture, statusFuture).get(60, TimeUnit.SECONDS));
+            }
+            Assert.assertTrue(completedOnReturn > 0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testStreamAssignmentStrategies() throws Exception {
+        skipIfNetworkUnavailable();
+        URI uri = new URI(endpoint);
+        Http2Request request = createHttp2Request("GET", endpoint, path, EMPTY_BODY);
+        int numConnections = 2;
+
+        for (Http2StreamAssignmentStrategy strategy : Http2StreamAssignmentStrategy.values()) {
+            try (Http2StreamManager streamManager = createStreamManager(uri, numConnections, 0, strategy)) {
+                List<CompletableFuture<Integer>> statusFutures = new ArrayList<>();
+                for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                    statusFutures.add(makeRequestWithStatus(streamManager, request));
+                }
+                for (CompletableFuture<Integer> statusFuture : statusFutures) {
+                    Assert.assertEquals(EXPECTED_HTTP_STATUS, (int) statusFuture.get(60, TimeUnit.SECONDS));
+                }
+
+                List<HttpConnectionLoad> loads = streamManager.getManagerMetrics().getConnectionLoads();
+                int expectedLoads = strategy == Http2StreamAssignmentStrategy.DEFAULT ? 1 : numConnections;
+                Assert.assertEquals(expectedLoads, loads.size());
+                for (HttpConnectionLoad load : loads) {
+                    /* Every stream completed, so nothing is left on any connection */
+                    Assert.assertEquals(0, load.getActiveStreams());
+                    Assert.assertEquals(0, load.getInFlightBytes());
+                    Assert.assertEquals(0, load.getUnacknowledgedWindowBytes());
+                }
+            }
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
 }
@@ -1,18 +1,29 @@
 package software.amazon.awssdk.crt.test;
 
+import com.sun.net.httpserver.HttpServer;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
 import java.net.URI;
 import java.net.URISyntaxException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.charset.Charset;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.List;
 import java.util.concurrent.Callable;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
+import java.util.zip.CRC32;
 import org.junit.Assert;
 import org.junit.Assume;
 import org.junit.Test;
@@ -269,6 +280,833 @@ public class HttpClientConnectionManagerTest extends HttpClientTestFixture  {
         CrtResource.waitForNoResources();
     }
 
+    /**
+     * Test that a completed request reports its timing breakdown and that the manager aggregates it.
+     */
+    @Test
+    public void testStreamLatencyMetrics() throws Exception {
+        skipIfNetworkUnavailable();
+
+        URI uri = new URI(endpoint);
+
+        try (HttpClientConnectionManager connectionPool = createConnectionManager(uri, 1, 1)) {
+            HttpManagerLatencyMetrics latencyMetrics = connectionPool.getLatencyMetrics();
+            Assert.assertEquals(0, latencyMetrics.getAcquireWait().getSampleCount());
+            Assert.assertEquals(0, latencyMetrics.getTotal().getSampleCount());
+
+            HttpRequest request = createHttpRequest("GET", endpoint, path, EMPTY_BODY);
+            CompletableFuture<HttpStreamMetrics> metricsFuture = new CompletableFuture<>();
+            HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+            try (HttpStream stream = conn.makeRequest(request, new HttpStreamResponseHandler() {
+                @Override
+                public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                        HttpHeader[] nextHeaders) {
+                }
+
+                @Override
+                public void onResponseComplete(HttpStream stream, int errorCode) {
+                }
+
+                @Override
+                public void onMetrics(HttpStream stream, HttpStreamMetrics metrics) {
+                    metricsFuture.complete(metrics);
+                }
+            })) {
+                stream.activate();
+                HttpStreamMetrics metrics = metricsFuture.get(60, TimeUnit.SECONDS);
+
+                Assert.assertTrue(metrics.getAcquireWaitNanos() >= 0);
+                Assert.assertTrue(metrics.getTimeToFirstByteNanos() >= 0);
+                Assert.assertTrue(metrics.getBodyTransferNanos() >= 0);
+                Assert.assertTrue(metrics.getTotalNanos() >= metrics.getTimeToFirstByteNanos());
+                Assert.assertTrue(metrics.getJniCallbackNanos() >= 0);
+                Assert.assertEquals(32, metrics.getBodyBytesReceived());
+            } finally {
+                connectionPool.releaseConnection(conn);
+            }
+
+            latencyMetrics = connectionPool.getLatencyMetrics();
+            Assert.assertEquals(1, latencyMetrics.getAcquireWait().getSampleCount());
+            Assert.assertEquals(1, latencyMetrics.getTimeToFirstByte().getSampleCount());
+            Assert.assertEquals(1, latencyMetrics.getTotal().getSampleCount());
+            Assert.assertEquals(1, latencyMetrics.getJniCallback().getSampleCount());
+            Assert.assertTrue(latencyMetrics.getTotal().getPercentileUpperBoundMicros(50) > 0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    /**
+     * Test that a response written in many small pieces is handed to onResponseBody in chunks of at least the
+     * configured minimum delivery size, except for the remainder at the end.
+     */
+    @Test
+    public void testResponseBodyMinimumDeliverySize() throws Exception {
+        final int pieceSize = 100;
+        final int pieceCount = 500;
+        final int minimumDeliverySize = 16 * 1024;
+
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", (exchange) -> {
+            exchange.sendResponseHeaders(200, 0);
+            try (OutputStream body = exchange.getResponseBody()) {
+                byte[] piece = new byte[pieceSize];
+                for (int i = 0; i < pieceCount; ++i) {
+                    body.write(piece);
+                    body.flush();
+                }
+            }
+        });
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            List<Integer> deliverySizes = new ArrayList<>();
+            CompletableFuture<Integer> responseComplete = new CompletableFuture<>();
+
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(1)
+                            .withResponseBodyMinimumDeliverySize(minimumDeliverySize))) {
+
+                HttpRequest request = new HttpRequest("GET", "/",
+                    new HttpHeader[] { new HttpHeader("Host", uri.getHost()) }, null);
+                HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                try (HttpStream stream = conn.makeRequest(request, new HttpStreamResponseHandler() {
+                    @Override
+                    public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                            HttpHeader[] nextHeaders) {
+                    }
+
+                    @Override
+                    public int onResponseBody(HttpStream stream, byte[] bodyBytesIn) {
+                        deliverySizes.add(bodyBytesIn.length);
+                        return bodyBytesIn.length;
+                    }
+
+                    @Override
+                    public void onResponseComplete(HttpStream stream, int errorCode) {
+                        responseComplete.complete(errorCode);
+                    }
+                })) {
+                    stream.activate();
+                    Assert.assertEquals(CRT.AWS_CRT_SUCCESS, (int) responseComplete.get(60, TimeUnit.SECONDS));
+                } finally {
+                    connectionPool.releaseConnection(conn);
+                }
+            }
+
+            int total = 0;
+            for (int i = 0; i < deliverySizes.size(); ++i) {
+                total += deliverySizes.get(i);
+                if (i < deliverySizes.size() - 1) {
+                    Assert.assertTrue(deliverySizes.get(i) >= minimumDeliverySize);
+                }
+            }
+            Assert.assertEquals(pieceSize * pieceCount, total);
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testMakeRequestsBatch() throws Exception {
+        final int requestCount = 8;
+
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", (exchange) -> {
+            byte[] body = exchange.getRequestURI().getPath().getBytes(UTF8);
+            exchange.sendResponseHeaders(200, body.length);
+            try (OutputStream out = exchange.getResponseBody()) {
+                out.write(body);
+            }
+        });
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            ConcurrentHashMap<HttpStream, String> responseBodies = new ConcurrentHashMap<>();
+            AtomicInteger failures = new AtomicInteger(0);
+            CountDownLatch responsesComplete = new CountDownLatch(requestCount);
+
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(1))) {
+
+                HttpRequest[] requests = new HttpRequest[requestCount];
+                for (int i = 0; i < requestCount; ++i) {
+                    requests[i] = new HttpRequest("GET", "/request" + i,
+                        new HttpHeader[] { new HttpHeader("Host", uri.getHost()) }, null);
+                }
+
+                HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                try {
+                    HttpStream[] streams = conn.makeRequests(requests, new HttpStreamResponseHandler() {
+                        @Override
+                        public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                                HttpHeader[] nextHeaders) {
+                        }
+
+                        @Override
+                        public int onResponseBody(HttpStream stream, byte[] bodyBytesIn) {
+                            responseBodies.merge(stream, new String(bodyBytesIn, UTF8), String::concat);
+                            return bodyBytesIn.length;
+                        }
+
+                        @Override
+                        public void onResponseComplete(HttpStream stream, int errorCode) {
+                            if (errorCode != CRT.AWS_CRT_SUCCESS || stream.getResponseStatusCode() != 200) {
+                                failures.incrementAndGet();
+                            }
+                            responsesComplete.countDown();
+                        }
+                    });
+
+                    Assert.assertEquals(requestCount, streams.length);
+                    Assert.assertTrue(responsesComplete.await(60, TimeUnit.SECONDS));
+                    Assert.assertEquals(0, failures.get());
+                    for (int i = 0; i < requestCount; ++i) {
+                        /* Each stream got the response to its own request */
+                        Assert.assertEquals("/request" + i, responseBodies.get(streams[i]));
+                        streams[i].close();
+                    }
+                } finally {
+                    connectionPool.releaseConnection(conn);
+                }
+            }
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    /**
+     * Test that a request body much larger than a single read is sent intact. Native code reuses one ByteBuffer
+     * object across the sendRequestBody calls of a stream, so this checks that it is reused, that every read sees
+     * the right memory, and that what one read does to the buffer doesn't leak into the next.
+     */
+    @Test
+    public void testRequestBodyAcrossManyReads() throws Exception {
+        final int bodySize = 4 * 1024 * 1024 + 17;
+        final byte[] body = new byte[bodySize];
+        for (int i = 0; i < bodySize; ++i) {
+            body[i] = (byte) (i * 31);
+        }
+        CRC32 expectedCrc = new CRC32();
+        expectedCrc.update(body);
+
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", (exchange) -> {
+            CRC32 crc = new CRC32();
+            byte[] readBuffer = new byte[8192];
+            try (InputStream requestBody = exchange.getRequestBody()) {
+                int read;
+                while ((read = requestBody.read(readBuffer)) > 0) {
+                    crc.update(readBuffer, 0, read);
+                }
+            }
+            byte[] response = Long.toString(crc.getValue()).getBytes(UTF8);
+            exchange.sendResponseHeaders(200, response.length);
+            try (OutputStream responseBody = exchange.getResponseBody()) {
+                responseBody.write(response);
+            }
+        });
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            final ByteBuffer source = ByteBuffer.wrap(body);
+            final AtomicInteger readCount = new AtomicInteger(0);
+            final AtomicInteger reusedReads = new AtomicInteger(0);
+            final AtomicInteger dirtyReads = new AtomicInteger(0);
+            final AtomicReference<ByteBuffer> firstBuffer = new AtomicReference<>();
+            HttpRequestBodyStream bodyStream = new HttpRequestBodyStream() {
+                @Override
+                public boolean sendRequestBody(ByteBuffer bodyBytesOut) {
+                    readCount.incrementAndGet();
+                    if (!firstBuffer.compareAndSet(null, bodyBytesOut) && firstBuffer.get() == bodyBytesOut) {
+                        reusedReads.incrementAndGet();
+                    }
+                    if (bodyBytesOut.position() != 0 || bodyBytesOut.order() != ByteOrder.BIG_ENDIAN) {
+                        dirtyReads.incrementAndGet();
+                    }
+
+                    int amount = Math.min(source.remaining(), bodyBytesOut.remaining());
+                    ByteBuffer slice = source.duplicate();
+                    slice.limit(slice.position() + amount);
+                    bodyBytesOut.put(slice);
+                    source.position(source.position() + amount);
+
+                    /* Leave the buffer in a state the next read must not see */
+                    bodyBytesOut.order(ByteOrder.LITTLE_ENDIAN);
+                    return !source.hasRemaining();
+                }
+
+                @Override
+                public boolean resetPosition() {
+                    source.position(0);
+                    return true;
+                }
+
+                @Override
+                public long getLength() {
+                    return bodySize;
+                }
+            };
+
+            StringBuilder responseText = new StringBuilder();
+            CompletableFuture<Integer> responseComplete = new CompletableFuture<>();
+
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(1))) {
+
+                HttpRequest request = new HttpRequest("PUT", "/",
+                    new HttpHeader[] {
+                        new HttpHeader("Host", uri.getHost()),
+                        new HttpHeader("Content-Length", Integer.toString(bodySize))
+                    }, bodyStream);
+                HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                try (HttpStream stream = conn.makeRequest(request, new HttpStreamResponseHandler() {
+                    @Override
+                    public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                            HttpHeader[] nextHeaders) {
+                    }
+
+                    @Override
+                    public int onResponseBody(HttpStream stream, byte[] bodyBytesIn) {
+                        responseText.append(new String(bodyBytesIn, UTF8));
+                        return bodyBytesIn.length;
+                    }
+
+                    @Override
+                    public void onResponseComplete(HttpStream stream, int errorCode) {
+                        responseComplete.complete(errorCode);
+                    }
+                })) {
+                    stream.activate();
+                    Assert.assertEquals(CRT.AWS_CRT_SUCCESS, (int) responseComplete.get(60, TimeUnit.SECONDS));
+                } finally {
+                    connectionPool.releaseConnection(conn);
+                }
+            }
+
+            Assert.assertTrue(readCount.get() > 1);
+            Assert.assertTrue(reusedReads.get() > 0);
+            Assert.assertEquals(0, dirtyReads.get());
+            Assert.assertEquals(Long.toString(expectedCrc.getValue()), responseText.toString());
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testWarmUp() throws Exception {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(4))) {
+
+                Assert.assertEquals(0, connectionPool.getManagerMetrics().getWarmConnections());
+
+                Assert.assertEquals(3, (int) connectionPool.warmUp(3).get(60, TimeUnit.SECONDS));
+                HttpManagerMetrics metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(3, metrics.getAvailableConcurrency());
+                Assert.assertEquals(3, metrics.getWarmConnections());
+                Assert.assertEquals(0, metrics.getLeasedConcurrency());
+
+                /* A warm connection serves the next acquisition without a new handshake */
+                HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(2, metrics.getAvailableConcurrency());
+                Assert.assertEquals(2, metrics.getWarmConnections());
+                connectionPool.releaseConnection(conn);
+
+                /* Only the connections missing are opened, and idle ones are never kept from requests */
+                Assert.assertEquals(4, (int) connectionPool.warmUp(4).get(60, TimeUnit.SECONDS));
+                metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(4, metrics.getAvailableConcurrency());
+                Assert.assertEquals(4, metrics.getWarmConnections());
+                Assert.assertEquals(0, metrics.getLeasedConcurrency());
+
+                /* Nothing is opened while enough connections are idle */
+                Assert.assertEquals(2, (int) connectionPool.warmUp(2).get(60, TimeUnit.SECONDS));
+                Assert.assertEquals(4, connectionPool.getManagerMetrics().getAvailableConcurrency());
+            }
+
+            /* Asking for more than the pool size is capped at the pool size */
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(4))) {
+
+                Assert.assertEquals(4, (int) connectionPool.warmUp(10).get(60, TimeUnit.SECONDS));
+                Assert.assertEquals(4, connectionPool.getManagerMetrics().getAvailableConcurrency());
+            }
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testMinIdleConnections() throws Exception {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(4)
+                            .withMinIdleConnections(2))) {
+
+                long deadline = System.currentTimeMillis() + 30000;
+                while (connectionPool.getManagerMetrics().getAvailableConcurrency() < 2
+                        && System.currentTimeMillis() < deadline) {
+                    Thread.sleep(50);
+                }
+                Assert.assertEquals(2, connectionPool.getManagerMetrics().getAvailableConcurrency());
+                Assert.assertEquals(2, connectionPool.getManagerMetrics().getWarmConnections());
+
+                /* Leasing one of the idle connections makes the pool top itself back up in the background */
+                HttpClientConnection conn1 = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                deadline = System.currentTimeMillis() + 30000;
+                while (connectionPool.getManagerMetrics().getAvailableConcurrency() < 2
+                        && System.currentTimeMillis() < deadline) {
+                    Thread.sleep(50);
+                }
+                HttpManagerMetrics metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(2, metrics.getAvailableConcurrency());
+                Assert.assertEquals(1, metrics.getLeasedConcurrency());
+
+                /* And so does leasing all of them */
+                HttpClientConnection conn2 = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                HttpClientConnection conn3 = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                deadline = System.currentTimeMillis() + 30000;
+                while (connectionPool.getManagerMetrics().getAvailableConcurrency() < 1
+                        && System.currentTimeMillis() < deadline) {
+                    Thread.sleep(50);
+                }
+                metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(1, metrics.getAvailableConcurrency());
+                Assert.assertEquals(3, metrics.getLeasedConcurrency());
+                connectionPool.releaseConnection(conn1);
+                connectionPool.releaseConnection(conn2);
+                connectionPool.releaseConnection(conn3);
+            }
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testMinIdleConnectionsRejectsMoreThanMaxConnections() throws Exception {
+        try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(eventLoopGroup);
+                ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                SocketOptions sockOpts = new SocketOptions()) {
+            new HttpClientConnectionManagerOptions()
+                .withClientBootstrap(bootstrap)
+                .withSocketOptions(sockOpts)
+                .withUri(new URI("http://127.0.0.1:80"))
+                .withMaxConnections(2)
+                .withMinIdleConnections(3)
+                .validateOptions();
+        }
+    }
+
+    @Test
+    public void testAdaptivePoolSizing() throws Exception {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            HttpAdaptivePoolSizingOptions sizingOptions = new HttpAdaptivePoolSizingOptions();
+            sizingOptions.setMinConnections(1);
+            sizingOptions.setAdjustmentIntervalMs(100);
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpClientConnectionManager connectionPool = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(4)
+                            .withAdaptivePoolSizingOptions(sizingOptions))) {
+
+                Assert.assertEquals(1, connectionPool.getManagerMetrics().getConnectionLimit());
+
+                /* Acquisitions beyond the limit queue up until the limit grows to let them through */
+                List<CompletableFuture<HttpClientConnection>> acquisitions = new ArrayList<>();
+                for (int i = 0; i < 3; ++i) {
+                    acquisitions.add(connectionPool.acquireConnection());
+                }
+                List<HttpClientConnection> connections = new ArrayList<>();
+                for (CompletableFuture<HttpClientConnection> acquisition : acquisitions) {
+                    connections.add(acquisition.get(60, TimeUnit.SECONDS));
+                }
+
+                HttpManagerMetrics metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(3, metrics.getLeasedConcurrency());
+                Assert.assertTrue(metrics.getConnectionLimit() >= 3);
+                Assert.assertTrue(metrics.getConnectionLimit() <= 4);
+
+                for (HttpClientConnection conn : connections) {
+                    connectionPool.releaseConnection(conn);
+                }
+
+                /* Once the connections are no longer needed the limit falls back to the minimum */
+                long deadline = System.currentTimeMillis() + 30000;
+                while (connectionPool.getManagerMetrics().getConnectionLimit() > 1
+                        && System.currentTimeMillis() < deadline) {
+                    Thread.sleep(50);
+                }
+                Assert.assertEquals(1, connectionPool.getManagerMetrics().getConnectionLimit());
+            }
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testAdaptivePoolSizingRejectsMoreThanMaxConnections() throws Exception {
+        HttpAdaptivePoolSizingOptions sizingOptions = new HttpAdaptivePoolSizingOptions();
+        sizingOptions.setMinConnections(3);
+        try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(eventLoopGroup);
+                ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                SocketOptions sockOpts = new SocketOptions()) {
+            new HttpClientConnectionManagerOptions()
+                .withClientBootstrap(bootstrap)
+                .withSocketOptions(sockOpts)
+                .withUri(new URI("http://127.0.0.1:80"))
+                .withMaxConnections(2)
+                .withAdaptivePoolSizingOptions(sizingOptions)
+                .validateOptions();
+        }
+    }
+
+    @Test
+    public void testLoadBalancedConnectionManager() throws Exception {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            HttpLoadBalancingOptions loadBalancingOptions = new HttpLoadBalancingOptions();
+            loadBalancingOptions.setStrategy(HttpLoadBalancingStrategy.LEAST_OUTSTANDING_REQUESTS);
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpLoadBalancedConnectionManager connectionPool = HttpLoadBalancedConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(sockOpts)
+                            .withUri(uri)
+                            .withMaxConnections(2),
+                        loadBalancingOptions).get(60, TimeUnit.SECONDS)) {
+
+                Assert.assertEquals(1, connectionPool.getAddresses().size());
+                String address = connectionPool.getAddresses().get(0);
+                Assert.assertEquals("127.0.0.1", address);
+
+                HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                Assert.assertEquals(1, connectionPool.getManagerMetrics(address).getLeasedConcurrency());
+                Assert.assertEquals(1.0, connectionPool.getHealthScore(address), 0.0);
+
+                /* Reporting the connection as unhealthy lowers its address's score */
+                connectionPool.releaseConnection(conn, false);
+                double healthScore = connectionPool.getHealthScore(address);
+                Assert.assertTrue(healthScore < 1.0);
+                Assert.assertEquals(0, connectionPool.getManagerMetrics(address).getLeasedConcurrency());
+
+                /* An address that is still resolved keeps its pool and health score across a refresh */
+                List<String> refreshed = connectionPool.refreshAddresses().get(60, TimeUnit.SECONDS);
+                Assert.assertEquals(Arrays.asList(address), refreshed);
+                Assert.assertEquals(healthScore, connectionPool.getHealthScore(address), 0.0);
+            }
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    /* Every 127/8 address reaches a server bound to the wildcard address on Linux, giving several backends */
+    private static final List<String> LOOPBACK_ADDRESSES = Arrays.asList("127.0.0.1", "127.0.0.2", "127.0.0.3");
+
+    private interface LoadBalancedTest {
+        void run(HttpLoadBalancedConnectionManager connectionPool) throws Exception;
+    }
+
+    private void runLoadBalancedTest(HttpLoadBalancingStrategy strategy, List<String> addresses, LoadBalancedTest test)
+            throws Exception {
+        Assume.assumeTrue(System.getProperty("os.name").toLowerCase().contains("linux"));
+
+        HttpServer server = HttpServer.create(new InetSocketAddress(0), 0);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            HttpLoadBalancingOptions loadBalancingOptions = new HttpLoadBalancingOptions();
+            loadBalancingOptions.setStrategy(strategy);
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions sockOpts = new SocketOptions();
+                    HttpLoadBalancedConnectionManager connectionPool =
+                        HttpLoadBalancedConnectionManager.createWithAddresses(
+                            new HttpClientConnectionManagerOptions()
+                                .withClientBootstrap(bootstrap)
+                                .withSocketOptions(sockOpts)
+                                .withUri(uri)
+                                .withMaxConnections(8),
+                            loadBalancingOptions,
+                            addresses)) {
+                Assert.assertEquals(addresses, connectionPool.getAddresses());
+                test.run(connectionPool);
+            }
+        } finally {
+            server.stop(0);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    private static List<HttpClientConnection> acquireConnections(HttpLoadBalancedConnectionManager connectionPool,
+            int count) throws Exception {
+        List<HttpClientConnection> connections = new ArrayList<>();
+        for (int i = 0; i < count; ++i) {
+            connections.add(connectionPool.acquireConnection().get(60, TimeUnit.SECONDS));
+        }
+        return connections;
+    }
+
+    private static void releaseConnections(HttpLoadBalancedConnectionManager connectionPool,
+            List<HttpClientConnection> connections) {
+        for (HttpClientConnection conn : connections) {
+            connectionPool.releaseConnection(conn);
+        }
+        connections.clear();
+    }
+
+    @Test
+    public void testLoadBalancedLeastOutstandingRequests() throws Exception {
+        runLoadBalancedTest(HttpLoadBalancingStrategy.LEAST_OUTSTANDING_REQUESTS, LOOPBACK_ADDRESSES,
+            (connectionPool) -> {
+                /* Equally healthy addresses take turns */
+                List<HttpClientConnection> connections = acquireConnections(connectionPool, 6);
+                for (String address : LOOPBACK_ADDRESSES) {
+                    Assert.assertEquals(2, connectionPool.getManagerMetrics(address).getLeasedConcurrency());
+                }
+                releaseConnections(connectionPool, connections);
+            });
+    }
+
+    @Test
+    public void testLoadBalancedPowerOfTwoChoices() throws Exception {
+        runLoadBalancedTest(HttpLoadBalancingStrategy.POWER_OF_TWO_CHOICES, LOOPBACK_ADDRESSES,
+            (connectionPool) -> {
+                /* An address holding none of the connections wins every pair it is drawn in */
+                List<HttpClientConnection> connections = acquireConnections(connectionPool, 24);
+                long leased = 0;
+                for (String address : LOOPBACK_ADDRESSES) {
+                    long addressLeased = connectionPool.getManagerMetrics(address).getLeasedConcurrency();
+                    Assert.assertTrue(addressLeased > 0);
+                    leased += addressLeased;
+                }
+                Assert.assertEquals(24, leased);
+                releaseConnections(connectionPool, connections);
+            });
+    }
+
+    @Test
+    public void testLoadBalancedProbeRecovery() throws Exception {
+        List<String> addresses = LOOPBACK_ADDRESSES.subList(0, 2);
+        runLoadBalancedTest(HttpLoadBalancingStrategy.LEAST_OUTSTANDING_REQUESTS, addresses, (connectionPool) -> {
+            String unhealthy = addresses.get(0);
+            String healthy = addresses.get(1);
+
+            /* Report connections from one address as unhealthy until it is avoided */
+            for (int i = 0; i < 50 && connectionPool.getHealthScore(unhealthy) >= 0.5; ++i) {
+                List<HttpClientConnection> healthyConnections = new ArrayList<>();
+                HttpClientConnection unhealthyConnection = null;
+                for (int j = 0; j < 2; ++j) {
+                    long leasedBefore = connectionPool.getManagerMetrics(unhealthy).getLeasedConcurrency();
+                    HttpClientConnection conn = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                    if (connectionPool.getManagerMetrics(unhealthy).getLeasedConcurrency() > leasedBefore) {
+                        unhealthyConnection = conn;
+                    } else {
+                        healthyConnections.add(conn);
+                    }
+                }
+                releaseConnections(connectionPool, healthyConnections);
+                if (unhealthyConnection != null) {
+                    connectionPool.releaseConnection(unhealthyConnection, false);
+                }
+            }
+            Assert.assertTrue(connectionPool.getHealthScore(unhealthy) < 0.5);
+
+            /* The first acquisition probes the avoided address, and it fails again */
+            HttpClientConnection probe = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+            Assert.assertEquals(1, connectionPool.getManagerMetrics(unhealthy).getLeasedConcurrency());
+            connectionPool.releaseConnection(probe, false);
+            Assert.assertTrue(connectionPool.getHealthScore(unhealthy) < 0.5);
+
+            /* Until the probe interval passes, everything goes to the healthy address */
+            List<HttpClientConnection> connections = acquireConnections(connectionPool, 4);
+            Assert.assertEquals(0, connectionPool.getManagerMetrics(unhealthy).getLeasedConcurrency());
+            Assert.assertEquals(4, connectionPool.getManagerMetrics(healthy).getLeasedConcurrency());
+            releaseConnections(connectionPool, connections);
+
+            /* A successful probe brings the address back */
+            Thread.sleep(1100);
+            probe = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+            Assert.assertEquals(1, connectionPool.getManagerMetrics(unhealthy).getLeasedConcurrency());
+            connectionPool.releaseConnection(probe);
+            Assert.assertTrue(connectionPool.getHealthScore(unhealthy) >= 0.5);
+        });
+    }
+
+    @Test
+    public void testLoadBalancedAcquireDuringRefresh() throws Exception {
+        List<String> first = LOOPBACK_ADDRESSES.subList(0, 2);
+        List<String> second = LOOPBACK_ADDRESSES.subList(1, 3);
+        runLoadBalancedTest(HttpLoadBalancingStrategy.LEAST_OUTSTANDING_REQUESTS, first, (connectionPool) -> {
+            ExecutorService executor = Executors.newFixedThreadPool(NUM_THREADS);
+            AtomicInteger acquired = new AtomicInteger(0);
+            List<CompletableFuture<Void>> acquirers = new ArrayList<>();
+            try {
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    acquirers.add(CompletableFuture.runAsync(() -> {
+                        for (int j = 0; j < 50; ++j) {
+                            try {
+                                HttpClientConnection conn =
+                                    connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                                acquired.incrementAndGet();
+                                connectionPool.releaseConnection(conn);
+                            } catch (Exception ex) {
+                                throw new RuntimeException(ex);
+                            }
+                        }
+                    }, executor));
+                }
+
+                /* Retire and recreate address managers while connections are being acquired from them */
+                for (int i = 0; !acquirers.stream().allMatch(CompletableFuture::isDone); ++i) {
+                    List<String> addresses = i % 2 == 0 ? second : first;
+                    Assert.assertEquals(addresses, connectionPool.refreshAddresses(addresses));
+                    connectionPool.refreshAddresses();
+                }
+
+                CompletableFuture.allOf(acquirers.toArray(new CompletableFuture<?>[0])).get(120, TimeUnit.SECONDS);
+                Assert.assertEquals(NUM_THREADS * 50, acquired.get());
+            } finally {
+                executor.shutdown();
+            }
+        });
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testResponseBodyMinimumDeliverySizeRejectsNegative() throws Exception {
+        try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(eventLoopGroup);
+                ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                SocketOptions sockOpts = new SocketOptions()) {
+            new HttpClientConnectionManagerOptions()
+                .withClientBootstrap(bootstrap)
+                .withSocketOptions(sockOpts)
+                .withUri(new URI("http://127.0.0.1:80"))
+                .withResponseBodyMinimumDeliverySize(-1)
+                .validateOptions();
+        }
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testResponseBodyMinimumDeliverySizeRejectsManualWindowManagement() throws Exception {
+        try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(eventLoopGroup);
+                ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                SocketOptions sockOpts = new SocketOptions()) {
+            new HttpClientConnectionManagerOptions()
+                .withClientBootstrap(bootstrap)
+                .withSocketOptions(sockOpts)
+                .withUri(new URI("http://127.0.0.1:80"))
+                .withManualWindowManagement(true)
+                .withResponseBodyMinimumDeliverySize(1024)
+                .validateOptions();
+        }
+    }
+
     @Test
     public void testMaxParallelRequests() throws Exception {
         testParallelRequestsWithLeakCheck(NUM_THREADS, NUM_REQUESTS);
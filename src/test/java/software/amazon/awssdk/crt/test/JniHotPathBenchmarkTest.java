@@ -0,0 +1,333 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.test;
+
+import com.sun.net.httpserver.HttpHandler;
+import com.sun.net.httpserver.HttpServer;
+import org.junit.Assume;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+import software.amazon.awssdk.crt.CRT;
+import software.amazon.awssdk.crt.checksums.CRC32;
+import software.amazon.awssdk.crt.checksums.CRC32C;
+import software.amazon.awssdk.crt.http.HttpClientConnection;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManager;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManagerOptions;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+import software.amazon.awssdk.crt.http.HttpStream;
+import software.amazon.awssdk.crt.http.HttpStreamResponseHandler;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.io.SocketOptions;
+import software.amazon.awssdk.crt.mqtt5.Mqtt5Client;
+import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.ClientOfflineQueueBehavior;
+import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.Mqtt5ClientOptionsBuilder;
+import software.amazon.awssdk.crt.mqtt5.QOS;
+import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
+import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket.PublishPacketBuilder;
+import software.amazon.awssdk.crt.mqtt5.packets.UserProperty;
+import software.amazon.awssdk.crt.utils.StringUtils;
+
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.URI;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Base64;
+import java.util.List;
+import java.util.Random;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Microbenchmarks for the paths that cross the JNI boundary on every operation. Everything runs in-process or
+ * against a loopback server, so no network access is needed. Run with -Daws.crt.benchmark, optionally overriding
+ * aws.crt.benchmark.rounds; JniThreadEnvTest covers JNIEnv acquire/release.
+ *
+ * Each benchmark warms up with one untimed round and then prints one line per timed round.
+ */
+public class JniHotPathBenchmarkTest extends CrtTestFixture {
+    public JniHotPathBenchmarkTest() {}
+
+    private interface Operation {
+        /* Runs the operation `iterations` times and returns the average nanoseconds per iteration */
+        double run(int iterations) throws Exception;
+    }
+
+    private static int getRounds() {
+        return Integer.parseInt(System.getProperty("aws.crt.benchmark.rounds", "5"));
+    }
+
+    private static void measure(String name, int iterations, Operation operation) throws Exception {
+        operation.run(iterations);
+        for (int round = 0; round < getRounds(); ++round) {
+            double nsPerOp = operation.run(iterations);
+            System.out.println(String.format("%s round %d: %.1f ns/op", name, round + 1, nsPerOp));
+        }
+    }
+
+    private static double timeLoop(int iterations, Runnable body) {
+        long start = System.nanoTime();
+        for (int i = 0; i < iterations; ++i) {
+            body.run();
+        }
+        return (double) (System.nanoTime() - start) / iterations;
+    }
+
+    private static byte[] randomBytes(int size) {
+        byte[] data = new byte[size];
+        new Random(size).nextBytes(data);
+        return data;
+    }
+
+    private static void assumeBenchmarksEnabled() {
+        Assume.assumeNotNull(System.getProperty("aws.crt.benchmark"));
+    }
+
+    @Test
+    public void benchmarkChecksums() throws Exception {
+        assumeBenchmarksEnabled();
+
+        for (int size : new int[] {64, 4 * 1024, 1024 * 1024}) {
+            final byte[] data = randomBytes(size);
+            int iterations = Math.max(1000, (256 * 1024 * 1024) / size);
+
+            final CRC32 crc32 = new CRC32();
+            measure(String.format("CRT CRC32 heap %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> crc32.update(data, 0, data.length)));
+
+            final CRC32C crc32c = new CRC32C();
+            measure(String.format("CRT CRC32C heap %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> crc32c.update(data, 0, data.length)));
+
+            final ByteBuffer direct = ByteBuffer.allocateDirect(size);
+            direct.put(data);
+            direct.flip();
+            measure(String.format("CRT CRC32 direct %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> crc32.update((ByteBuffer) direct.rewind())));
+            measure(String.format("CRT CRC32C direct %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> crc32c.update((ByteBuffer) direct.rewind())));
+
+            final java.util.zip.CRC32 jdkCrc32 = new java.util.zip.CRC32();
+            measure(String.format("JDK CRC32 heap %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> jdkCrc32.update(data, 0, data.length)));
+        }
+    }
+
+    @Test
+    public void benchmarkBase64() throws Exception {
+        assumeBenchmarksEnabled();
+
+        for (int size : new int[] {32, 1024, 64 * 1024}) {
+            final byte[] data = randomBytes(size);
+            final byte[] encoded = StringUtils.base64Encode(data);
+            int iterations = Math.max(1000, (64 * 1024 * 1024) / size);
+
+            measure(String.format("CRT base64 encode %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> StringUtils.base64Encode(data)));
+            measure(String.format("CRT base64 decode %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> StringUtils.base64Decode(encoded)));
+            measure(String.format("JDK base64 encode %d bytes", size), iterations,
+                (n) -> timeLoop(n, () -> Base64.getEncoder().encode(data)));
+        }
+    }
+
+    private static PublishPacket createPublishPacket(int payloadSize, int userPropertyCount) {
+        List<UserProperty> userProperties = new ArrayList<>();
+        for (int i = 0; i < userPropertyCount; ++i) {
+            userProperties.add(new UserProperty("property-" + i, "value-" + i));
+        }
+
+        PublishPacketBuilder builder = new PublishPacketBuilder()
+            .withTopic("benchmark/telemetry/device-0001")
+            .withPayload(randomBytes(payloadSize))
+            .withQOS(QOS.AT_MOST_ONCE);
+        if (userPropertyCount > 0) {
+            builder.withContentType("application/octet-stream").withUserProperties(userProperties);
+        }
+        return builder.build();
+    }
+
+    private static double runOfflinePublishes(Mqtt5Client client, PublishPacket packet, int iterations)
+            throws Exception {
+        long start = System.nanoTime();
+        for (int i = 0; i < iterations; ++i) {
+            try {
+                client.publish(packet).get(60, TimeUnit.SECONDS);
+                fail("Publish on a client that was never started should be rejected");
+            } catch (ExecutionException ex) {
+                /* expected, the offline queue policy rejects QoS 0 publishes */
+            }
+        }
+        return (double) (System.nanoTime() - start) / iterations;
+    }
+
+    /**
+     * Publishes to a client that was never started. The offline queue policy rejects QoS 0 publishes on the event
+     * loop, so each iteration converts the packet to its native form and completes the future from native code
+     * without touching the network.
+     */
+    @Test
+    public void benchmarkMqtt5PublishSubmission() throws Exception {
+        assumeBenchmarksEnabled();
+
+        try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(eventLoopGroup);
+                ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                Mqtt5Client client = new Mqtt5Client(new Mqtt5ClientOptionsBuilder("localhost", 1883L)
+                    .withBootstrap(bootstrap)
+                    .withOfflineQueueBehavior(ClientOfflineQueueBehavior.FAIL_QOS0_PUBLISH_ON_DISCONNECT)
+                    .build())) {
+
+            for (int userPropertyCount : new int[] {0, 8}) {
+                for (int payloadSize : new int[] {256, 16 * 1024}) {
+                    final PublishPacket packet = createPublishPacket(payloadSize, userPropertyCount);
+                    measure(
+                        String.format("MQTT5 offline publish %d bytes, %d user properties", payloadSize,
+                            userPropertyCount),
+                        20000,
+                        (n) -> runOfflinePublishes(client, packet, n));
+                }
+            }
+        }
+    }
+
+    private interface LoopbackBenchmark {
+        void run(URI uri, HttpClientConnection connection) throws Exception;
+    }
+
+    /* Runs the benchmark on one connection to a loopback HTTP/1.1 server using the given handler */
+    private static void runWithLoopbackConnection(HttpHandler handler, int responseBodyMinimumDeliverySize,
+            LoopbackBenchmark benchmark) throws Exception {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", handler);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions socketOptions = new SocketOptions();
+                    HttpClientConnectionManager connectionManager = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(socketOptions)
+                            .withUri(uri)
+                            .withMaxConnections(1)
+                            .withResponseBodyMinimumDeliverySize(responseBodyMinimumDeliverySize))) {
+
+                HttpClientConnection connection = connectionManager.acquireConnection().get(60, TimeUnit.SECONDS);
+                try {
+                    benchmark.run(uri, connection);
+                } finally {
+                    connectionManager.releaseConnection(connection);
+                }
+            }
+        } finally {
+            server.stop(0);
+        }
+    }
+
+    private static double runLoopbackRequests(HttpClientConnection connection, HttpRequest request, int iterations)
+            throws Exception {
+        long start = System.nanoTime();
+        for (int i = 0; i < iterations; ++i) {
+            CompletableFuture<Integer> responseComplete = new CompletableFuture<>();
+            HttpStream stream = connection.makeRequest(request, new HttpStreamResponseHandler() {
+                @Override
+                public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                        HttpHeader[] nextHeaders) {
+                }
+
+                @Override
+                public void onResponseComplete(HttpStream stream, int errorCode) {
+                    responseComplete.complete(errorCode);
+                }
+            });
+            stream.activate();
+            int errorCode = responseComplete.get(60, TimeUnit.SECONDS);
+            stream.close();
+            assertEquals(CRT.AWS_CRT_SUCCESS, errorCode);
+        }
+        return (double) (System.nanoTime() - start) / iterations;
+    }
+
+    /**
+     * Request/response round trips over one loopback HTTP/1.1 connection with few and with many headers in each
+     * direction, so the difference between the two is dominated by header marshalling.
+     */
+    @Test
+    public void benchmarkHttpHeaderMarshalling() throws Exception {
+        assumeBenchmarksEnabled();
+
+        final int responseHeaderCount = 32;
+        HttpHandler handler = (exchange) -> {
+            for (int i = 0; i < responseHeaderCount; ++i) {
+                exchange.getResponseHeaders().add("x-amz-benchmark-" + i, "response-header-value-" + i);
+            }
+            exchange.sendResponseHeaders(200, -1);
+            exchange.close();
+        };
+
+        runWithLoopbackConnection(handler, 0, (uri, connection) -> {
+            for (int requestHeaderCount : new int[] {2, 32}) {
+                HttpHeader[] headers = new HttpHeader[requestHeaderCount];
+                headers[0] = new HttpHeader("Host", uri.getHost());
+                headers[1] = new HttpHeader("Content-Length", "0");
+                for (int i = 2; i < requestHeaderCount; ++i) {
+                    headers[i] = new HttpHeader("x-amz-benchmark-" + i, "request-header-value-" + i);
+                }
+                final HttpRequest request = new HttpRequest("GET", "/", headers, null);
+
+                measure(
+                    String.format("HTTP/1.1 loopback request, %d request headers, %d response headers",
+                        requestHeaderCount, responseHeaderCount),
+                    2000,
+                    (n) -> runLoopbackRequests(connection, request, n));
+            }
+        });
+    }
+
+    /**
+     * Loopback round trips with response bodies of increasing size, delivered to Java as each piece arrives and
+     * aggregated natively into one onResponseBody call, so the difference shows the cost of each body upcall.
+     */
+    @Test
+    public void benchmarkResponseBodyDelivery() throws Exception {
+        assumeBenchmarksEnabled();
+
+        for (int size : new int[] {4 * 1024, 64 * 1024, 1024 * 1024}) {
+            final byte[] body = randomBytes(size);
+            HttpHandler handler = (exchange) -> {
+                exchange.sendResponseHeaders(200, body.length);
+                exchange.getResponseBody().write(body);
+                exchange.close();
+            };
+            int iterations = Math.max(100, (256 * 1024 * 1024) / size);
+
+            for (int minimumDeliverySize : new int[] {0, size}) {
+                runWithLoopbackConnection(handler, minimumDeliverySize, (uri, connection) -> {
+                    HttpHeader[] headers = new HttpHeader[] {
+                        new HttpHeader("Host", uri.getHost()),
+                        new HttpHeader("Content-Length", "0"),
+                    };
+                    final HttpRequest request = new HttpRequest("GET", "/", headers, null);
+
+                    measure(
+                        String.format("HTTP/1.1 loopback response body %d bytes, %s", size,
+                            minimumDeliverySize == 0 ? "delivered per read" : "aggregated"),
+                        iterations,
+                        (n) -> runLoopbackRequests(connection, request, n));
+                });
+            }
+        }
+    }
+}
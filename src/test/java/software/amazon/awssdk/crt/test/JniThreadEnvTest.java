@@ -0,0 +1,175 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.test;
+
+import com.sun.net.httpserver.HttpServer;
+import org.junit.Assume;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import software.amazon.awssdk.crt.CRT;
+import software.amazon.awssdk.crt.CrtResource;
+import software.amazon.awssdk.crt.http.HttpClientConnection;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManager;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManagerOptions;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+import software.amazon.awssdk.crt.http.HttpStream;
+import software.amazon.awssdk.crt.http.HttpStreamResponseHandler;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.io.SocketOptions;
+
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.URI;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Every native callback acquires a JNIEnv on its event loop thread before calling into Java, and releases it after.
+ * These tests drive that path through loopback HTTP requests on every event loop of a group at once: each response
+ * makes several callbacks into Java.
+ */
+public class JniThreadEnvTest extends CrtTestFixture {
+    public JniThreadEnvTest() {}
+
+    private interface LoopbackOperation {
+        void run(HttpClientConnectionManager connectionManager, HttpRequest request) throws Exception;
+    }
+
+    private static void runWithLoopbackServer(int eventLoops, int connections, LoopbackOperation operation)
+            throws Exception {
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", (exchange) -> {
+            exchange.sendResponseHeaders(200, -1);
+            exchange.close();
+        });
+        ExecutorService serverExecutor = Executors.newFixedThreadPool(connections);
+        server.setExecutor(serverExecutor);
+        server.start();
+
+        try {
+            URI uri = new URI("http://127.0.0.1:" + server.getAddress().getPort());
+            HttpHeader[] headers = new HttpHeader[] {
+                new HttpHeader("Host", uri.getHost()),
+                new HttpHeader("Content-Length", "0"),
+            };
+            HttpRequest request = new HttpRequest("GET", "/", headers, null);
+
+            try (EventLoopGroup eventLoopGroup = new EventLoopGroup(eventLoops);
+                    HostResolver resolver = new HostResolver(eventLoopGroup);
+                    ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                    SocketOptions socketOptions = new SocketOptions();
+                    HttpClientConnectionManager connectionManager = HttpClientConnectionManager.create(
+                        new HttpClientConnectionManagerOptions()
+                            .withClientBootstrap(bootstrap)
+                            .withSocketOptions(socketOptions)
+                            .withUri(uri)
+                            .withMaxConnections(connections))) {
+                operation.run(connectionManager, request);
+            }
+        } finally {
+            server.stop(0);
+            serverExecutor.shutdown();
+        }
+    }
+
+    private static void makeRequest(HttpClientConnection connection, HttpRequest request) throws Exception {
+        CompletableFuture<Integer> responseComplete = new CompletableFuture<>();
+        HttpStream stream = connection.makeRequest(request, new HttpStreamResponseHandler() {
+            @Override
+            public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                    HttpHeader[] nextHeaders) {
+            }
+
+            @Override
+            public void onResponseComplete(HttpStream stream, int errorCode) {
+                responseComplete.complete(errorCode);
+            }
+        });
+        stream.activate();
+        int errorCode = responseComplete.get(60, TimeUnit.SECONDS);
+        stream.close();
+        assertEquals(CRT.AWS_CRT_SUCCESS, errorCode);
+    }
+
+    /*
+     * Makes `requestsPerConnection` back-to-back requests on `connections` connections at once and returns the
+     * average nanoseconds per request
+     */
+    private static double runConcurrentRequests(HttpClientConnectionManager connectionManager, HttpRequest request,
+            int connections, int requestsPerConnection) throws Exception {
+        ExecutorService executor = Executors.newFixedThreadPool(connections);
+        try {
+            long start = System.nanoTime();
+            List<Future<Void>> results = new ArrayList<>();
+            for (int i = 0; i < connections; ++i) {
+                results.add(executor.submit(() -> {
+                    HttpClientConnection connection =
+                        connectionManager.acquireConnection().get(60, TimeUnit.SECONDS);
+                    try {
+                        for (int j = 0; j < requestsPerConnection; ++j) {
+                            makeRequest(connection, request);
+                        }
+                    } finally {
+                        connectionManager.releaseConnection(connection);
+                    }
+                    return null;
+                }));
+            }
+            for (Future<Void> result : results) {
+                result.get(120, TimeUnit.SECONDS);
+            }
+            return (double) (System.nanoTime() - start) / ((long) connections * requestsPerConnection);
+        } finally {
+            executor.shutdown();
+        }
+    }
+
+    @Test
+    public void testCallbacksOnEveryEventLoop() throws Exception {
+        final int eventLoops = 4;
+        final int connections = 2 * eventLoops;
+
+        /* the first requests attach the event loop threads and go through the locked path, the rest use the cache */
+        runWithLoopbackServer(eventLoops, connections,
+            (connectionManager, request) -> runConcurrentRequests(connectionManager, request, connections, 25));
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    /**
+     * Measures loopback requests with every event loop thread calling into Java at once, so JNIEnv acquire/release
+     * contention shows up in the time per request. Run with -Daws.crt.benchmark and optionally override the
+     * defaults below.
+     */
+    @Test
+    public void benchmarkCallbacksUnderContention() throws Exception {
+        Assume.assumeNotNull(System.getProperty("aws.crt.benchmark"));
+
+        final int threadCount = Integer.parseInt(System.getProperty("aws.crt.benchmark.threads", "4"));
+        final int iterations = Integer.parseInt(System.getProperty("aws.crt.benchmark.iterations", "2000"));
+        final int rounds = Integer.parseInt(System.getProperty("aws.crt.benchmark.rounds", "5"));
+        final int connections = 2 * threadCount;
+
+        runWithLoopbackServer(threadCount, connections, (connectionManager, request) -> {
+            // warm up: attach every event loop thread and let the JIT settle
+            runConcurrentRequests(connectionManager, request, connections, iterations / 10);
+
+            for (int round = 0; round < rounds; ++round) {
+                double nsPerRequest = runConcurrentRequests(connectionManager, request, connections, iterations);
+                System.out.println(String.format("Round %d: %.0f ns per request", round + 1, nsPerRequest));
+            }
+        });
+    }
+}
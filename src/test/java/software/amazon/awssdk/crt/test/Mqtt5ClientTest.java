@@ -3,8 +3,10 @@ package software.amazon.awssdk.crt.test;
 import org.junit.Assume;
 import org.junit.Test;
 import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
 import static org.junit.Assert.assertTrue;
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.fail;
 
 import software.amazon.awssdk.crt.*;
@@ -28,12 +30,19 @@ import software.amazon.awssdk.crt.mqtt5.packets.*;
 import software.amazon.awssdk.crt.mqtt5.packets.ConnectPacket.ConnectPacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.DisconnectPacket.DisconnectPacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.DisconnectPacket.DisconnectReasonCode;
+import software.amazon.awssdk.crt.mqtt5.packets.PubAckPacket.PubAckReasonCode;
 import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket.PublishPacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.SubscribePacket.SubscribePacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.UnsubscribePacket.UnsubscribePacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.SubscribePacket.RetainHandlingType;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
 import java.util.List;
 import java.util.Random;
 import java.util.UUID;
@@ -2062,6 +2071,711 @@ public class Mqtt5ClientTest extends CrtTestFixture {
         }
     }
 
+    /* Direct publish delivery: topic and payload as buffer views, packet built only on request */
+    @Test
+    public void Op_UC4() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        byte[] testPayload = "Hello World".getBytes();
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+            builder.withDirectPublishDeliveryEnabled(true);
+
+            CompletableFuture<Void> publishReceivedFuture = new CompletableFuture<>();
+            CompletableFuture<PublishReturn> staleReturnFuture = new CompletableFuture<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    try {
+                        ByteBuffer topicBuffer = publishReturn.getTopicBuffer();
+                        byte[] topic = new byte[topicBuffer.remaining()];
+                        topicBuffer.get(topic);
+                        assertEquals(testTopic, new String(topic, StandardCharsets.UTF_8));
+
+                        ByteBuffer payloadBuffer = publishReturn.getPayloadBuffer();
+                        assertTrue(payloadBuffer.isDirect());
+                        assertTrue(payloadBuffer.isReadOnly());
+                        byte[] payload = new byte[payloadBuffer.remaining()];
+                        payloadBuffer.get(payload);
+                        assertTrue(Arrays.equals(testPayload, payload));
+
+                        if (!staleReturnFuture.isDone()) {
+                            /* other threads can't reach native data, even while the callback is running */
+                            CompletableFuture<Throwable> otherThreadFuture = new CompletableFuture<>();
+                            Thread otherThread = new Thread(() -> {
+                                try {
+                                    publishReturn.getPublishPacket();
+                                    otherThreadFuture.complete(null);
+                                } catch (Throwable t) {
+                                    otherThreadFuture.complete(t);
+                                }
+                            });
+                            otherThread.start();
+                            otherThread.join();
+                            assertTrue(otherThreadFuture.get() instanceof IllegalStateException);
+
+                            /* first delivery: keep the return around and check it can no longer reach native data */
+                            staleReturnFuture.complete(publishReturn);
+                        } else {
+                            PublishPacket packet = publishReturn.getPublishPacket();
+                            assertEquals(testTopic, packet.getTopic());
+                            assertTrue(Arrays.equals(testPayload, packet.getPayload()));
+                            publishReceivedFuture.complete(null);
+                        }
+                    } catch (Throwable t) {
+                        publishReceivedFuture.completeExceptionally(t);
+                    }
+                }
+            });
+
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic);
+            publishPacketBuilder.withPayload(testPayload);
+            publishPacketBuilder.withQOS(QOS.AT_LEAST_ONCE);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+            PublishReturn staleReturn = staleReturnFuture.get(60, TimeUnit.SECONDS);
+            try {
+                staleReturn.getPublishPacket();
+                fail("PublishPacket was built after the direct delivery callback returned");
+            } catch (IllegalStateException ex) {
+                // expected
+            }
+
+            client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+            publishReceivedFuture.get(60, TimeUnit.SECONDS);
+
+            client.stop(new DisconnectPacketBuilder().build());
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Batched publish delivery: full batches and a partial batch flushed by the delay */
+    @Test
+    public void Op_UC5() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        final int batchSize = 3;
+        final int publishCount = 7;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+            builder.withPublishBatchMaxMessages(batchSize);
+            builder.withPublishBatchMaxDelayMicros(100000);
+
+            CompletableFuture<Void> publishReceivedFuture = new CompletableFuture<>();
+            List<PublishPacket> publishPacketsReceived = new ArrayList<PublishPacket>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    publishReceivedFuture.completeExceptionally(
+                        new Throwable("Publish delivered outside of a batch"));
+                }
+
+                @Override
+                public void onMessagesReceived(Mqtt5Client client, PublishReturn[] publishReturns) {
+                    if (publishReturns.length == 0 || publishReturns.length > batchSize) {
+                        publishReceivedFuture.completeExceptionally(
+                            new Throwable("Unexpected batch size " + publishReturns.length));
+                    }
+                    for (PublishReturn publishReturn : publishReturns) {
+                        publishPacketsReceived.add(publishReturn.getPublishPacket());
+                    }
+                    if (publishPacketsReceived.size() == publishCount) {
+                        publishReceivedFuture.complete(null);
+                    }
+                }
+            });
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            for (int i = 0; i < publishCount; ++i) {
+                PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+                publishPacketBuilder.withTopic(testTopic);
+                publishPacketBuilder.withPayload(("Hello World " + i).getBytes());
+                publishPacketBuilder.withQOS(QOS.AT_LEAST_ONCE);
+                client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+            }
+
+            publishReceivedFuture.get(60, TimeUnit.SECONDS);
+            for (int i = 0; i < publishCount; ++i) {
+                assertEquals(testTopic, publishPacketsReceived.get(i).getTopic());
+                assertTrue(Arrays.equals(("Hello World " + i).getBytes(), publishPacketsReceived.get(i).getPayload()));
+            }
+
+            client.stop(new DisconnectPacketBuilder().build());
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Serialized publish: the packet is read from a direct buffer, and the buffer can be published again */
+    @Test
+    public void Op_UC6() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        byte[] testPayload = "Hello World".getBytes();
+        final int publishCount = 2;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            List<PublishPacket> receivedPackets = Collections.synchronizedList(new ArrayList<>());
+            CompletableFuture<Void> publishesReceivedFuture = new CompletableFuture<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    receivedPackets.add(publishReturn.getPublishPacket());
+                    if (receivedPackets.size() == publishCount) {
+                        publishesReceivedFuture.complete(null);
+                    }
+                }
+            });
+
+            List<UserProperty> userProperties = new ArrayList<>();
+            userProperties.add(new UserProperty("Hello", "World"));
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic);
+            publishPacketBuilder.withPayload(testPayload);
+            publishPacketBuilder.withQOS(QOS.AT_LEAST_ONCE);
+            publishPacketBuilder.withContentType("text/plain");
+            publishPacketBuilder.withUserProperties(userProperties);
+            PublishPacket publishPacket = publishPacketBuilder.build();
+
+            ByteBuffer serializedPublish = PublishPacketSerializer.serialize(publishPacket);
+            assertEquals(PublishPacketSerializer.serializedSize(publishPacket), serializedPublish.remaining());
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            for (int i = 0; i < publishCount; ++i) {
+                client.publishSerialized(serializedPublish).get(60, TimeUnit.SECONDS);
+                assertEquals(0, serializedPublish.position());
+            }
+            publishesReceivedFuture.get(60, TimeUnit.SECONDS);
+
+            for (PublishPacket received : receivedPackets) {
+                assertEquals(testTopic, received.getTopic());
+                assertTrue(Arrays.equals(testPayload, received.getPayload()));
+                assertEquals("text/plain", received.getContentType());
+                assertEquals(1, received.getUserProperties().size());
+                assertEquals("World", received.getUserProperties().get(0).value);
+            }
+
+            client.stop(new DisconnectPacketBuilder().build());
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Batched publish: every publish in the batch gets its own result, in order */
+    @Test
+    public void Op_UC7() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        final int publishCount = 5;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            List<PublishPacket> receivedPackets = Collections.synchronizedList(new ArrayList<>());
+            CompletableFuture<Void> publishesReceivedFuture = new CompletableFuture<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    receivedPackets.add(publishReturn.getPublishPacket());
+                    if (receivedPackets.size() == publishCount) {
+                        publishesReceivedFuture.complete(null);
+                    }
+                }
+            });
+
+            PublishPacket[] publishPackets = new PublishPacket[publishCount];
+            for (int i = 0; i < publishCount; ++i) {
+                PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+                publishPacketBuilder.withTopic(testTopic);
+                publishPacketBuilder.withPayload(("Hello World " + i).getBytes());
+                publishPacketBuilder.withQOS(i % 2 == 0 ? QOS.AT_LEAST_ONCE : QOS.AT_MOST_ONCE);
+                publishPackets[i] = publishPacketBuilder.build();
+            }
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            PublishBatchResult batchResult = client.publishBatch(publishPackets).get(60, TimeUnit.SECONDS);
+            assertEquals(publishCount, batchResult.getCount());
+            assertEquals(0, batchResult.getFailureCount());
+            for (int i = 0; i < publishCount; ++i) {
+                assertTrue(batchResult.isSuccessful(i));
+                if (i % 2 == 0) {
+                    assertEquals(PubAckReasonCode.SUCCESS, batchResult.getPubAckReasonCode(i));
+                } else {
+                    assertNull(batchResult.getPubAckReasonCode(i));
+                }
+            }
+            publishesReceivedFuture.get(60, TimeUnit.SECONDS);
+
+            PublishBatchResult emptyResult = client.publishBatch(new PublishPacket[0]).get(60, TimeUnit.SECONDS);
+            assertEquals(0, emptyResult.getCount());
+
+            client.stop(new DisconnectPacketBuilder().build());
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Topic handlers: publishes are routed natively by topic filter, unmatched ones fall back to publish events */
+    @Test
+    public void Op_UC8() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            CompletableFuture<String> defaultFuture = new CompletableFuture<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    defaultFuture.complete(publishReturn.getPublishPacket().getTopic());
+                }
+            });
+
+            CompletableFuture<String> singleLevelFuture = new CompletableFuture<>();
+            PublishEvents singleLevelHandler = new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    singleLevelFuture.complete(publishReturn.getPublishPacket().getTopic());
+                }
+            };
+            CompletableFuture<String> exactFuture = new CompletableFuture<>();
+            PublishEvents exactHandler = new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    exactFuture.complete(publishReturn.getPublishPacket().getTopic());
+                }
+            };
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+
+            client.addTopicHandler(testTopic + "/a/+", singleLevelHandler);
+            client.addTopicHandler(testTopic + "/b", exactHandler);
+            client.addTopicHandler(testTopic + "/c/#", exactHandler);
+            assertTrue(client.removeTopicHandler(testTopic + "/c/#", exactHandler));
+            assertFalse(client.removeTopicHandler(testTopic + "/c/#", exactHandler));
+
+            boolean invalidFilterRejected = false;
+            try {
+                client.addTopicHandler(testTopic + "/#/a", exactHandler);
+            } catch (CrtRuntimeException ex) {
+                invalidFilterRejected = true;
+            }
+            assertTrue(invalidFilterRejected);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic + "/#", QOS.AT_LEAST_ONCE);
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            String[] topics = { testTopic + "/a/x", testTopic + "/b", testTopic + "/c/d" };
+            for (String topic : topics) {
+                PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+                publishPacketBuilder.withTopic(topic);
+                publishPacketBuilder.withPayload("Hello World".getBytes());
+                publishPacketBuilder.withQOS(QOS.AT_LEAST_ONCE);
+                client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+            }
+
+            assertEquals(testTopic + "/a/x", singleLevelFuture.get(60, TimeUnit.SECONDS));
+            assertEquals(testTopic + "/b", exactFuture.get(60, TimeUnit.SECONDS));
+            assertEquals(testTopic + "/c/d", defaultFuture.get(60, TimeUnit.SECONDS));
+
+            client.stop(new DisconnectPacketBuilder().build());
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Publish spool: QoS 1 publishes made offline are spooled to disk and replayed on connect, even by a new client */
+    @Test
+    public void Op_UC9() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        final int publishCount = 3;
+
+        Path spoolPath = null;
+        try {
+            spoolPath = Files.createTempFile("mqtt5-publish-spool", ".spool");
+            PublishSpoolOptions spoolOptions = new PublishSpoolOptions()
+                .withFilePath(spoolPath)
+                .withMaxSizeBytes(64 * 1024);
+
+            Mqtt5ClientOptionsBuilder subscriberBuilder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured subscriberEvents = new LifecycleEvents_Futured();
+            subscriberBuilder.withLifecycleEvents(subscriberEvents);
+            List<String> receivedPayloads = Collections.synchronizedList(new ArrayList<>());
+            CompletableFuture<Void> publishesReceivedFuture = new CompletableFuture<>();
+            subscriberBuilder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    receivedPayloads.add(new String(publishReturn.getPublishPacket().getPayload(), StandardCharsets.UTF_8));
+                    if (receivedPayloads.size() == publishCount) {
+                        publishesReceivedFuture.complete(null);
+                    }
+                }
+            });
+            Mqtt5Client subscriber = new Mqtt5Client(subscriberBuilder.build());
+            subscriber.start();
+            subscriberEvents.connectedFuture.get(60, TimeUnit.SECONDS);
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+            subscriber.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            /* Spooled by a client that never connects, then replayed by the next client using the file */
+            Mqtt5ClientOptionsBuilder offlineBuilder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            offlineBuilder.withPublishSpoolOptions(spoolOptions);
+            Mqtt5Client offlineClient = new Mqtt5Client(offlineBuilder.build());
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload("spooled".getBytes());
+            CompletableFuture<PublishResult> orphanedFuture = offlineClient.publish(publishPacketBuilder.build());
+            assertEquals(1, offlineClient.getPublishSpoolPendingCount());
+            offlineClient.close();
+            assertTrue(orphanedFuture.isCompletedExceptionally());
+
+            Mqtt5ClientOptionsBuilder publisherBuilder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured publisherEvents = new LifecycleEvents_Futured();
+            publisherBuilder.withLifecycleEvents(publisherEvents);
+            publisherBuilder.withPublishSpoolOptions(spoolOptions);
+            Mqtt5Client publisher = new Mqtt5Client(publisherBuilder.build());
+            assertEquals(1, publisher.getPublishSpoolPendingCount());
+
+            List<CompletableFuture<PublishResult>> publishFutures = new ArrayList<>();
+            for (int i = 1; i < publishCount; ++i) {
+                publishPacketBuilder.withPayload(("offline " + i).getBytes());
+                publishFutures.add(publisher.publish(publishPacketBuilder.build()));
+            }
+            assertEquals(publishCount, publisher.getPublishSpoolPendingCount());
+            for (CompletableFuture<PublishResult> publishFuture : publishFutures) {
+                assertFalse(publishFuture.isDone());
+            }
+
+            publisher.start();
+            publisherEvents.connectedFuture.get(60, TimeUnit.SECONDS);
+            for (CompletableFuture<PublishResult> publishFuture : publishFutures) {
+                assertEquals(PublishResult.PublishResultType.PUBACK, publishFuture.get(60, TimeUnit.SECONDS).getType());
+            }
+            publishesReceivedFuture.get(60, TimeUnit.SECONDS);
+            assertEquals(0, publisher.getPublishSpoolPendingCount());
+            assertTrue(receivedPayloads.contains("spooled"));
+            assertTrue(receivedPayloads.contains("offline 1"));
+            assertTrue(receivedPayloads.contains("offline 2"));
+
+            publisher.stop(new DisconnectPacketBuilder().build());
+            publisher.close();
+            subscriber.stop(new DisconnectPacketBuilder().build());
+            subscriber.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        } finally {
+            if (spoolPath != null) {
+                try {
+                    Files.deleteIfExists(spoolPath);
+                } catch (Exception ex) {
+                    // best effort
+                }
+            }
+        }
+    }
+
+    /* Publish spool overflow: a full spool either rejects the new publish or drops the oldest one */
+    @Test
+    public void Op_UC10() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testTopic = "test/MQTT5_Binding_Java_" + UUID.randomUUID().toString();
+        byte[] payload = new byte[1500];
+
+        for (PublishSpoolOptions.OverflowPolicy policy : PublishSpoolOptions.OverflowPolicy.values()) {
+            Path spoolPath = null;
+            try {
+                spoolPath = Files.createTempFile("mqtt5-publish-spool", ".spool");
+                PublishSpoolOptions spoolOptions = new PublishSpoolOptions()
+                    .withFilePath(spoolPath)
+                    .withMaxSizeBytes(4096)
+                    .withOverflowPolicy(policy);
+
+                Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+                builder.withPublishSpoolOptions(spoolOptions);
+                Mqtt5Client client = new Mqtt5Client(builder.build());
+
+                PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+                publishPacketBuilder.withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload(payload);
+
+                /* Two publishes fit in the spool, the third doesn't */
+                CompletableFuture<PublishResult> first = client.publish(publishPacketBuilder.build());
+                CompletableFuture<PublishResult> second = client.publish(publishPacketBuilder.build());
+                CompletableFuture<PublishResult> third = client.publish(publishPacketBuilder.build());
+                assertEquals(2, client.getPublishSpoolPendingCount());
+                assertFalse(second.isDone());
+                if (policy == PublishSpoolOptions.OverflowPolicy.REJECT_NEW) {
+                    assertFalse(first.isDone());
+                    assertTrue(third.isCompletedExceptionally());
+                } else {
+                    assertTrue(first.isCompletedExceptionally());
+                    assertFalse(third.isDone());
+                }
+
+                /* The spool file is locked by the first client */
+                boolean sharedSpoolRejected = false;
+                try {
+                    new Mqtt5Client(builder.build()).close();
+                } catch (CrtRuntimeException ex) {
+                    sharedSpoolRejected = true;
+                }
+                assertTrue(sharedSpoolRejected);
+
+                client.close();
+            } catch (Exception ex) {
+                fail(ex.getMessage());
+            } finally {
+                if (spoolPath != null) {
+                    try {
+                        Files.deleteIfExists(spoolPath);
+                    } catch (Exception ex) {
+                        // best effort
+                    }
+                }
+            }
+        }
+    }
+
+    /* Metrics: counters and latency histograms are read into a caller-provided array */
+    @Test
+    public void Op_UC11() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        byte[] testPayload = "Hello World".getBytes();
+        final int publishCount = 4;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            List<PublishPacket> receivedPackets = Collections.synchronizedList(new ArrayList<>());
+            CompletableFuture<Void> publishesReceivedFuture = new CompletableFuture<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    receivedPackets.add(publishReturn.getPublishPacket());
+                    if (receivedPackets.size() == publishCount) {
+                        publishesReceivedFuture.complete(null);
+                    }
+                }
+            });
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+            long[] metrics = Mqtt5ClientMetrics.newMetricsArray();
+            client.getMetrics(metrics);
+            assertEquals(0, metrics[Mqtt5ClientMetrics.PUBLISHES_OUT]);
+            assertEquals(0, metrics[Mqtt5ClientMetrics.CONNECTION_SUCCESSES]);
+
+            boolean wrongLengthRejected = false;
+            try {
+                client.getMetrics(new long[Mqtt5ClientMetrics.LENGTH - 1]);
+            } catch (IllegalArgumentException ex) {
+                wrongLengthRejected = true;
+            }
+            assertTrue(wrongLengthRejected);
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload(testPayload);
+            for (int i = 0; i < publishCount; ++i) {
+                client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+            }
+            publishesReceivedFuture.get(60, TimeUnit.SECONDS);
+
+            client.getMetrics(metrics);
+            long publishBytes = testTopic.length() + testPayload.length;
+            assertEquals(publishCount, metrics[Mqtt5ClientMetrics.PUBLISHES_OUT]);
+            assertEquals(publishCount * publishBytes, metrics[Mqtt5ClientMetrics.BYTES_OUT]);
+            assertTrue(metrics[Mqtt5ClientMetrics.PUBLISHES_IN] >= publishCount);
+            assertTrue(metrics[Mqtt5ClientMetrics.BYTES_IN] >= publishCount * publishBytes);
+            assertEquals(1, metrics[Mqtt5ClientMetrics.CONNECTION_SUCCESSES]);
+            assertEquals(0, metrics[Mqtt5ClientMetrics.RECONNECTS]);
+            assertEquals(publishCount,
+                Mqtt5ClientMetrics.getSampleCount(metrics, Mqtt5ClientMetrics.PUBLISH_TO_PUBACK_LATENCY));
+            assertTrue(Mqtt5ClientMetrics.getPercentileUpperBoundMicros(
+                metrics, Mqtt5ClientMetrics.PUBLISH_TO_PUBACK_LATENCY, 50) > 0);
+            assertTrue(Mqtt5ClientMetrics.getSampleCount(metrics, Mqtt5ClientMetrics.JNI_CALLBACK_DURATION) > 0);
+
+            client.stop(new DisconnectPacketBuilder().build());
+            events.stopFuture.get(60, TimeUnit.SECONDS);
+            client.getMetrics(metrics);
+            assertEquals(1, metrics[Mqtt5ClientMetrics.DISCONNECTIONS]);
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Direct publish delivery to several topic handlers: each one reads the whole topic and payload */
+    @Test
+    public void Op_UC12() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        byte[] testPayload = "Hello World".getBytes();
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+            builder.withDirectPublishDeliveryEnabled(true);
+
+            List<CompletableFuture<Void>> handlerFutures = new ArrayList<>();
+            List<PublishEvents> handlers = new ArrayList<>();
+            for (int i = 0; i < 2; ++i) {
+                CompletableFuture<Void> handlerFuture = new CompletableFuture<>();
+                handlerFutures.add(handlerFuture);
+                handlers.add(new PublishEvents() {
+                    @Override
+                    public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                        try {
+                            ByteBuffer topicBuffer = publishReturn.getTopicBuffer();
+                            byte[] topic = new byte[topicBuffer.remaining()];
+                            topicBuffer.get(topic);
+                            assertEquals(testTopic, new String(topic, StandardCharsets.UTF_8));
+
+                            ByteBuffer payloadBuffer = publishReturn.getPayloadBuffer();
+                            byte[] payload = new byte[payloadBuffer.remaining()];
+                            payloadBuffer.get(payload);
+                            assertTrue(Arrays.equals(testPayload, payload));
+                            handlerFuture.complete(null);
+                        } catch (Throwable t) {
+                            handlerFuture.completeExceptionally(t);
+                        }
+                    }
+                });
+            }
+
+            Mqtt5Client client = new Mqtt5Client(builder.build());
+            client.addTopicHandler(testTopic, handlers.get(0));
+            client.addTopicHandler(testTopic, handlers.get(1));
+
+            client.start();
+            events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+            client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload(testPayload);
+            client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+            for (CompletableFuture<Void> handlerFuture : handlerFutures) {
+                handlerFuture.get(60, TimeUnit.SECONDS);
+            }
+
+            client.stop(new DisconnectPacketBuilder().build());
+            client.close();
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
     /**
      * ============================================================
      * Error Operation Tests
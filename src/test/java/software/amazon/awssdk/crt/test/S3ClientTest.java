@@ -20,11 +20,16 @@ import software.amazon.awssdk.crt.utils.ByteBufferUtils;
 
 import java.io.File;
 import java.io.FileNotFoundException;
+import java.io.IOException;
 import java.io.PrintWriter;
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
 import java.net.URI;
 import java.nio.BufferOverflowException;
 import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
 import java.time.Clock;
 import java.time.Duration;
 import java.time.Instant;
@@ -225,6 +230,307 @@ public class S3ClientTest extends CrtTestFixture {
         }
     }
 
+    @Test
+    public void testS3GetWithDirectResponseBody() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final long fileSize = 1 * 1024 * 1024;
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(fileSize / 4);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicLong bytesReceived = new AtomicLong(0);
+            AtomicInteger nonDirectBuffers = new AtomicInteger(0);
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                    if (!bodyBytesIn.isDirect() || !bodyBytesIn.isReadOnly()) {
+                        nonDirectBuffers.incrementAndGet();
+                    }
+                    Assert.assertEquals(objectRangeEnd - objectRangeStart, bodyBytesIn.remaining());
+                    byte[] bytes = new byte[bodyBytesIn.remaining()];
+                    bodyBytesIn.get(bytes);
+                    bytesReceived.addAndGet(bytes.length);
+                    return 0;
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3,
+                            "Meta request finished with error code " + context.getErrorCode());
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withDirectResponseBodyEnabled(true);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+                Assert.assertEquals(0, nonDirectBuffers.get());
+                Assert.assertEquals(fileSize, bytesReceived.get());
+            }
+        } catch (InterruptedException | ExecutionException ex) {
+            Assert.fail(ex.getMessage());
+        }
+    }
+
+    @Test
+    public void testS3GetToResponseFile() throws IOException {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final long fileSize = 1 * 1024 * 1024;
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(fileSize / 4);
+        Path responseFile = Files.createTempFile("testS3GetToResponseFile", ".txt");
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicInteger bodyInvocationCount = new AtomicInteger(0);
+            AtomicLong totalBytesTransferred = new AtomicLong(0);
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                    bodyInvocationCount.incrementAndGet();
+                    return 0;
+                }
+
+                @Override
+                public void onProgress(final S3MetaRequestProgress progress) {
+                    totalBytesTransferred.addAndGet(progress.getBytesTransferred());
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3,
+                            "Meta request finished with error code " + context.getErrorCode());
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withResponseFilePath(responseFile);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+                Assert.assertEquals(0, bodyInvocationCount.get());
+                Assert.assertEquals(fileSize, totalBytesTransferred.get());
+                Assert.assertEquals(fileSize, Files.size(responseFile));
+                Assert.assertArrayEquals(downloadToMemory(client, "/get_object_test_1MB.txt", fileSize),
+                        Files.readAllBytes(responseFile));
+            }
+        } catch (InterruptedException | ExecutionException ex) {
+            Assert.fail(ex.getMessage());
+        } finally {
+            Files.deleteIfExists(responseFile);
+        }
+    }
+
+    /* Downloads an object through onResponseBody, to check what the other delivery modes produce against */
+    private byte[] downloadToMemory(S3Client client, String path, long size)
+            throws InterruptedException, ExecutionException {
+        byte[] body = new byte[(int) size];
+        CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+        S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+            @Override
+            public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                bodyBytesIn.get(body, (int) objectRangeStart, bodyBytesIn.remaining());
+                return 0;
+            }
+
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                if (context.getErrorCode() != 0) {
+                    onFinishedFuture.completeExceptionally(
+                            new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                    return;
+                }
+                onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+            }
+        };
+
+        HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+        S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                .withHttpRequest(new HttpRequest("GET", path, headers, null))
+                .withResponseHandler(responseHandler);
+
+        try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+            Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+        }
+        return body;
+    }
+
+    @Test
+    public void testS3GetToResponseFileWithBackpressure() throws IOException {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final long fileSize = 1 * 1024 * 1024;
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(fileSize / 4)
+                .withReadBackpressureEnabled(true)
+                .withInitialReadWindowSize(1024);
+        Path responseFile = Files.createTempFile("testS3GetToResponseFileWithBackpressure", ".txt");
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withResponseFilePath(responseFile);
+
+            /* Nothing in Java opens the read window, so this only finishes if native code does */
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get(60, TimeUnit.SECONDS));
+                Assert.assertEquals(fileSize, Files.size(responseFile));
+            }
+        } catch (InterruptedException | ExecutionException | TimeoutException ex) {
+            Assert.fail(ex.getMessage());
+        } finally {
+            Files.deleteIfExists(responseFile);
+        }
+    }
+
+    @Test
+    public void testS3GetToResponseFileFailureKeepsExistingFile() throws IOException {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        Path responseFile = Files.createTempFile("testS3GetToResponseFileFailureKeepsExistingFile", ".txt");
+        byte[] existing = "existing contents".getBytes(StandardCharsets.UTF_8);
+        Files.write(responseFile, existing);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_does_not_exist.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withResponseFilePath(responseFile);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertNotEquals(Integer.valueOf(0), onFinishedFuture.get());
+                Assert.assertArrayEquals(existing, Files.readAllBytes(responseFile));
+            }
+        } catch (InterruptedException | ExecutionException ex) {
+            Assert.fail(ex.getMessage());
+        } finally {
+            Files.deleteIfExists(responseFile);
+        }
+    }
+
+    @Test
+    public void testS3GetToResponseFileWithProgressInterval() throws IOException {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final long fileSize = 1 * 1024 * 1024;
+        final long partSize = fileSize / 8;
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(partSize);
+        Path responseFile = Files.createTempFile("testS3GetToResponseFileWithProgressInterval", ".txt");
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicInteger progressInvocationCount = new AtomicInteger(0);
+            AtomicLong totalBytesTransferred = new AtomicLong(0);
+            AtomicReference<S3MetaRequestProgress> firstProgress = new AtomicReference<>();
+            AtomicInteger distinctProgressObjects = new AtomicInteger(0);
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onProgress(final S3MetaRequestProgress progress) {
+                    progressInvocationCount.incrementAndGet();
+                    totalBytesTransferred.addAndGet(progress.getBytesTransferred());
+                    if (firstProgress.compareAndSet(null, progress) || firstProgress.get() != progress) {
+                        distinctProgressObjects.incrementAndGet();
+                    }
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withResponseFilePath(responseFile)
+                    .withProgressIntervalBytes(fileSize / 2);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+                Assert.assertEquals(fileSize, totalBytesTransferred.get());
+                /* 8 parts coalesced into reports of at least half the object each */
+                Assert.assertTrue(progressInvocationCount.get() > 0);
+                Assert.assertTrue(progressInvocationCount.get() <= 2);
+                Assert.assertEquals(1, distinctProgressObjects.get());
+            }
+        } catch (InterruptedException | ExecutionException ex) {
+            Assert.fail(ex.getMessage());
+        } finally {
+            Files.deleteIfExists(responseFile);
+        }
+    }
+
     /**
      * Test read-backpressure by repeatedly:
      * - letting the download stall
@@ -529,6 +835,53 @@ public class S3ClientTest extends CrtTestFixture {
         };
     }
 
+    @Test
+    public void testS3PutFromRequestFile() throws IOException {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final long fileSize = 10 * 1024 * 1024;
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(5 * 1024 * 1024);
+        Path requestFile = Files.createTempFile("testS3PutFromRequestFile", ".txt");
+        try (S3Client client = createS3Client(clientOptions)) {
+            Files.write(requestFile, createTestPayload((int) fileSize));
+
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3,
+                            "Meta request finished with error code " + context.getErrorCode());
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT),
+                    new HttpHeader("Content-Length", Long.valueOf(fileSize).toString()), };
+            HttpRequest httpRequest = new HttpRequest("PUT", "/put_object_test_10MB_from_file.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.PUT_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withRequestFilePath(requestFile);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+        } catch (InterruptedException | ExecutionException ex) {
+            Assert.fail(ex.getMessage());
+        } finally {
+            Files.deleteIfExists(requestFile);
+        }
+    }
+
     @Test
     public void testS3PutPauseResume() {
         skipIfNetworkUnavailable();
@@ -960,6 +1313,27 @@ public class S3ClientTest extends CrtTestFixture {
         public static TransferStats global = new TransferStats();
     }
 
+    static class GcStats {
+        long collections;
+        long timeMs;
+
+        static GcStats now() {
+            GcStats stats = new GcStats();
+            for (GarbageCollectorMXBean gc : ManagementFactory.getGarbageCollectorMXBeans()) {
+                stats.collections += Math.max(0, gc.getCollectionCount());
+                stats.timeMs += Math.max(0, gc.getCollectionTime());
+            }
+            return stats;
+        }
+
+        GcStats since(GcStats start) {
+            GcStats delta = new GcStats();
+            delta.collections = collections - start.collections;
+            delta.timeMs = timeMs - start.timeMs;
+            return delta;
+        }
+    }
+
     @Test
     public void benchmarkS3Get() {
         skipIfNetworkUnavailable();
@@ -988,10 +1362,15 @@ public class S3ClientTest extends CrtTestFixture {
         final int vipsNeeded = (int) Math.ceil(expectedGbps / 0.5 / 10);
         final int sampleDelay = Integer.parseInt(System.getProperty("aws.crt.s3.benchmark.warmup",
                 new Integer((int) Math.ceil(vipsNeeded / 5)).toString()));
-        System.out.println(String.format("REGION=%s, WARMUP=%s", region, sampleDelay));
+        // Run once with and once without to compare GC pressure and throughput of the two body delivery paths
+        final boolean directResponseBody = Boolean
+                .parseBoolean(System.getProperty("aws.crt.s3.benchmark.directbuffer", "false"));
+        System.out.println(String.format("REGION=%s, WARMUP=%s, DIRECTBUFFER=%s", region, sampleDelay,
+                directResponseBody));
 
         // Ignore stats during warm up time, they skew results
         TransferStats.global.withSampleDelay(Duration.ofSeconds(sampleDelay));
+        final GcStats gcStatsAtStart = GcStats.now();
         try (TlsContext tlsCtx = createTlsContextOptions(getContext().trustStore)) {
             S3ClientOptions clientOptions = new S3ClientOptions().withRegion(region).withEndpoint(endpoint)
                     .withThroughputTargetGbps(expectedGbps).withTlsContext(useTls ? tlsCtx : null);
@@ -1049,7 +1428,8 @@ public class S3ClientTest extends CrtTestFixture {
 
                     S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
                             .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
-                            .withResponseHandler(responseHandler);
+                            .withResponseHandler(responseHandler)
+                            .withDirectResponseBodyEnabled(directResponseBody);
 
                     try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
 
@@ -1084,6 +1464,8 @@ public class S3ClientTest extends CrtTestFixture {
                 System.out.println(String.format("Peak: %.3f Gbps", overall.peakGbps()));
                 System.out.println(String.format("P90: %.3f Gbps (stddev: %.3f)", overall.p90Gbps(), overall.stddev()));
                 System.out.println(String.format("Avg Latency: %dms", overall.latency()));
+                GcStats gcStats = GcStats.now().since(gcStatsAtStart);
+                System.out.println(String.format("GC: %d collections, %dms", gcStats.collections, gcStats.timeMs));
                 System.out.flush();
 
                 try {
@@ -5,6 +5,7 @@
 
 package software.amazon.awssdk.crt.test;
 
+import java.lang.reflect.Field;
 import java.net.URI;
 import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
@@ -20,6 +21,7 @@ import java.util.regex.Pattern;
 
 import org.junit.Test;
 import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertSame;
 import static org.junit.Assert.assertTrue;
 import static org.junit.Assert.assertEquals;
 
@@ -231,6 +233,109 @@ public class SigningTest extends CrtTestFixture {
     }
 
 
+    @Test
+    public void testSigningPreservesHeaderNames() throws Exception {
+        try (StaticCredentialsProvider provider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+            .withAccessKeyId(TEST_ACCESS_KEY_ID)
+            .withSecretAccessKey(TEST_SECRET_ACCESS_KEY)
+            .build();) {
+
+            /* Mix of interned names in both spellings, names that only differ in case and uncommon names */
+            HttpHeader[] requestHeaders = new HttpHeader[]{
+                new HttpHeader("Host", "example.amazonaws.com"),
+                new HttpHeader("content-type", "text/plain"),
+                new HttpHeader("Content-MD5", ""),
+                new HttpHeader("content-md5x", "not-interned"),
+                new HttpHeader("CONTENT-LENGTH", "0"),
+                new HttpHeader("x-amz-meta-color".getBytes(StandardCharsets.UTF_8),
+                    "blue".getBytes(StandardCharsets.UTF_8)),
+            };
+            HttpRequest request = new HttpRequest("GET", "/", requestHeaders, null);
+
+            try (AwsSigningConfig config = new AwsSigningConfig()) {
+                config.setAlgorithm(AwsSigningConfig.AwsSigningAlgorithm.SIGV4);
+                config.setSignatureType(AwsSigningConfig.AwsSignatureType.HTTP_REQUEST_VIA_HEADERS);
+                config.setRegion("us-east-1");
+                config.setService("service");
+                config.setTime(System.currentTimeMillis());
+                config.setCredentialsProvider(provider);
+                config.setSignedBodyValue(AwsSigningConfig.AwsSignedBodyValue.EMPTY_SHA256);
+
+                HttpRequest signedRequest = AwsSigner.signRequest(request, config).get();
+                assertNotNull(signedRequest);
+
+                List<HttpHeader> signedHeaders = signedRequest.getHeaders();
+                assertTrue(signedHeaders.size() > requestHeaders.length);
+                for (int i = 0; i < requestHeaders.length; ++i) {
+                    assertEquals(requestHeaders[i].getName(), signedHeaders.get(i).getName());
+                    assertEquals(requestHeaders[i].getValue(), signedHeaders.get(i).getValue());
+                    assertTrue(Arrays.equals(requestHeaders[i].getNameBytes(), signedHeaders.get(i).getNameBytes()));
+                }
+
+                assertTrue(hasHeader(signedRequest, "X-Amz-Date"));
+                assertTrue(isHeaderSignedByAuthHeader(signedRequest, "x-amz-meta-color"));
+            }
+        }
+    }
+
+    /*
+     * HttpHeader.STATIC_NAMES and s_static_header_names in http_request_utils.c are kept in sync by hand. Every name
+     * goes to native as its table index and as raw bytes, and comes back from native as an index. A raw name only
+     * comes back as the same interned array if native has it at the same index, so a table out of sync fails here.
+     */
+    @Test
+    public void testStaticHeaderNamesRoundTrip() throws Exception {
+        Field staticNamesField = HttpHeader.class.getDeclaredField("STATIC_NAMES");
+        staticNamesField.setAccessible(true);
+        String[] staticNames = (String[]) staticNamesField.get(null);
+
+        /* The signer refuses requests that already carry the headers it generates, it adds them itself instead */
+        List<String> signerGeneratedNames =
+            Arrays.asList("authorization", "x-amz-date", "x-amz-content-sha256", "x-amz-security-token");
+
+        List<HttpHeader> requestHeaders = new ArrayList<>();
+        for (String name : staticNames) {
+            if (!signerGeneratedNames.contains(name.toLowerCase())) {
+                requestHeaders.add(new HttpHeader(name, "index"));
+                requestHeaders.add(new HttpHeader(name.getBytes(StandardCharsets.UTF_8),
+                    "raw".getBytes(StandardCharsets.UTF_8)));
+            }
+        }
+        HttpRequest request = new HttpRequest("GET", "/", requestHeaders.toArray(new HttpHeader[0]), null);
+
+        try (StaticCredentialsProvider provider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+            .withAccessKeyId(TEST_ACCESS_KEY_ID)
+            .withSecretAccessKey(TEST_SECRET_ACCESS_KEY)
+            .withSessionToken("token".getBytes(StandardCharsets.UTF_8))
+            .build();
+            AwsSigningConfig config = new AwsSigningConfig()) {
+            config.setAlgorithm(AwsSigningConfig.AwsSigningAlgorithm.SIGV4);
+            config.setSignatureType(AwsSigningConfig.AwsSignatureType.HTTP_REQUEST_VIA_HEADERS);
+            config.setRegion("us-east-1");
+            config.setService("service");
+            config.setTime(System.currentTimeMillis());
+            config.setCredentialsProvider(provider);
+            config.setSignedBodyValue(AwsSigningConfig.AwsSignedBodyValue.EMPTY_SHA256);
+            config.setSignedBodyHeader(AwsSigningConfig.AwsSignedBodyHeaderType.X_AMZ_CONTENT_SHA256);
+
+            HttpRequest signedRequest = AwsSigner.signRequest(request, config).get();
+            assertNotNull(signedRequest);
+
+            List<HttpHeader> signedHeaders = signedRequest.getHeaders();
+            assertTrue(signedHeaders.size() > requestHeaders.size());
+            for (int i = 0; i < signedHeaders.size(); ++i) {
+                String name = signedHeaders.get(i).getName();
+                if (i < requestHeaders.size()) {
+                    assertEquals(requestHeaders.get(i).getName(), name);
+                } else if (!signerGeneratedNames.contains(name.toLowerCase())) {
+                    continue;
+                }
+                /* Headers built from an interned String name share its byte[] */
+                assertSame(name, new HttpHeader(name, "").getNameBytes(), signedHeaders.get(i).getNameBytes());
+            }
+        }
+    }
+
     @Test
     public void testSigningException() throws Exception {
         DelegateCredentialsHandler credentialsHandler = new DelegateCredentialsHandler() {